@@ -1,18 +1,21 @@
-#define APPNAME "Very Sleepy"
-
-// The VERSION string is in version.h, which is generated
-// by gen_version.bat from git tags.
-
-// These should be updated only in the commits
-// tagging a new version.
-#define VERSION_MAJOR 0
-#define VERSION_MINOR 91
-
-#define VENDOR  "codersnotes.com"
-
-#define APPURL  "http://www.codersnotes.com/sleepy/sleepy"
-#define GITURL  "https://github.com/VerySleepy/verysleepy"
-
-// Update this whenever backwards-incompatible changes
-// are made to the profiling results file format.
-#define FORMAT_VERSION "0.90"
+#define APPNAME "Very Sleepy"
+
+// The VERSION string is in version.h, which is generated
+// by gen_version.bat from git tags.
+
+// These should be updated only in the commits
+// tagging a new version.
+#define VERSION_MAJOR 0
+#define VERSION_MINOR 91
+
+#define VENDOR  "codersnotes.com"
+
+#define APPURL  "http://www.codersnotes.com/sleepy/sleepy"
+#define GITURL  "https://github.com/VerySleepy/verysleepy"
+
+// Update this whenever backwards-incompatible changes
+// are made to the profiling results file format.
+#define FORMAT_VERSION "0.91"
+
+// The last format with text symbols and stacks, which can still be read.
+#define FORMAT_VERSION_TEXT "0.90"
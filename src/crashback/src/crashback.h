@@ -1,14 +1,14 @@
-#ifndef __CRASHBACK_H__
-#define __CRASHBACK_H__
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-void cbStartup();
-
-#ifdef __cplusplus
-} // extern "C"
-#endif
-
-#endif // __CRASHBACK_H__
+#ifndef __CRASHBACK_H__
+#define __CRASHBACK_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void cbStartup();
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // __CRASHBACK_H__
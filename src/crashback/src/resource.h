@@ -1,6 +1,6 @@
-#pragma once
-
-#define IDD_CRASH		1000
-#define ID_ICON			1001
-#define ID_PROGRESS		1002
-#define ID_EXAMINE		1003
+#pragma once
+
+#define IDD_CRASH		1000
+#define ID_ICON			1001
+#define ID_PROGRESS		1002
+#define ID_EXAMINE		1003
@@ -0,0 +1,127 @@
+/*=====================================================================
+callstacktrie.cpp
+-----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "callstacktrie.h"
+
+// Must be a power of two.
+static const size_t kInitialSlots = 4096;
+
+CallStackTrie::CallStackTrie()
+{
+	clear();
+}
+
+void CallStackTrie::clear()
+{
+	nodes.clear();
+
+	Node root;
+	root.parent = ROOT;
+	root.addr = 0;
+	root.count = 0;
+	nodes.push_back(root);
+
+	slots.assign(kInitialSlots, NodeID(ROOT));
+	slotmask = kInitialSlots - 1;
+}
+
+size_t CallStackTrie::hash(NodeID parent, PROFILER_ADDR addr)
+{
+	unsigned long long h = (unsigned long long)addr * 0x9E3779B97F4A7C15ULL;
+	h ^= (unsigned long long)parent * 0xC2B2AE3D27D4EB4FULL;
+	return (size_t)(h ^ (h >> 29));
+}
+
+CallStackTrie::NodeID CallStackTrie::intern(NodeID parent, PROFILER_ADDR addr)
+{
+	size_t slot = hash(parent, addr) & slotmask;
+	for (;;)
+	{
+		NodeID id = slots[slot];
+		if (id == ROOT)
+			break;
+		const Node &node = nodes[id];
+		if (node.parent == parent && node.addr == addr)
+			return id;
+		slot = (slot + 1) & slotmask;
+	}
+
+	NodeID id = (NodeID)nodes.size();
+	Node node;
+	node.parent = parent;
+	node.addr = addr;
+	node.count = 0;
+	nodes.push_back(node);
+	slots[slot] = id;
+
+	// Keep the load factor at or below one half.
+	if (nodes.size() * 2 > slots.size())
+		grow();
+
+	return id;
+}
+
+void CallStackTrie::grow()
+{
+	slots.assign(slots.size() * 2, NodeID(ROOT));
+	slotmask = slots.size() - 1;
+
+	for (NodeID id = 1; id < nodes.size(); id++)
+	{
+		size_t slot = hash(nodes[id].parent, nodes[id].addr) & slotmask;
+		while (slots[slot] != ROOT)
+			slot = (slot + 1) & slotmask;
+		slots[slot] = id;
+	}
+}
+
+CallStackTrie::NodeID CallStackTrie::addSample(const CallStack &stack, SAMPLE_TYPE weight)
+{
+	if (stack.depth == 0)
+		return ROOT;
+
+	// addr[0] is the innermost frame, so walk from the outermost one.
+	NodeID id = ROOT;
+	for (size_t n=stack.depth;n--;)
+		id = intern(id, stack.addr[n]);
+
+	nodes[id].count += weight;
+	return id;
+}
+
+void CallStackTrie::merge(const CallStackTrie &other, std::vector<NodeID> *mapping_out)
+{
+	// Parents come before their children, so each parent
+	// has been mapped to a node of this trie by the time we need it.
+	std::vector<NodeID> mapping(other.nodes.size());
+	mapping[ROOT] = ROOT;
+
+	for (NodeID id = 1; id < other.nodes.size(); id++)
+	{
+		const Node &node = other.nodes[id];
+		NodeID mine = intern(mapping[node.parent], node.addr);
+		nodes[mine].count += node.count;
+		mapping[id] = mine;
+	}
+
+	if (mapping_out)
+		mapping_out->swap(mapping);
+}
@@ -0,0 +1,89 @@
+/*=====================================================================
+callstacktrie.h
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __CALLSTACKTRIE_H_666_
+#define __CALLSTACKTRIE_H_666_
+
+#include "profilertypes.h"
+#include <vector>
+
+/*=====================================================================
+CallStackTrie
+-------------
+Calling-context trie used to aggregate samples while capturing.
+
+Each node is a (parent, address) pair, hash-consed so that every
+distinct call path is stored exactly once. Stacks are interned from
+the outermost frame inwards, and a sample adds its weight to the node
+of its innermost frame. Memory use therefore scales with the number of
+unique frames, rather than with the number of unique stacks times
+MAX_CALLSTACK_LEVELS.
+=====================================================================*/
+class CallStackTrie
+{
+public:
+	typedef unsigned int NodeID;
+
+	/// The root node has no address; every other node descends from it.
+	static const NodeID ROOT = 0;
+
+	struct Node
+	{
+		NodeID        parent;
+		PROFILER_ADDR addr;
+
+		/// Total weight of the samples whose innermost frame is this node.
+		SAMPLE_TYPE   count;
+	};
+
+	CallStackTrie();
+
+	void clear();
+
+	/// Find or create the child of parent with the given address.
+	NodeID intern(NodeID parent, PROFILER_ADDR addr);
+
+	/// Intern the stack and add weight to its innermost node.
+	/// Returns the innermost node, or ROOT for an empty stack.
+	NodeID addSample(const CallStack &stack, SAMPLE_TYPE weight);
+
+	/// Add every sample of another trie to this one.
+	/// If mapping is given, it receives the ID in this trie of each of other's nodes.
+	void merge(const CallStackTrie &other, std::vector<NodeID> *mapping = NULL);
+
+	size_t getNodeCount() const { return nodes.size(); }
+	const Node &getNode(NodeID id) const { return nodes[id]; }
+
+private:
+	/// Node ID -> node. Parents always have lower IDs than their children.
+	std::vector<Node> nodes;
+
+	/// Open-addressed (parent, address) -> node ID table.
+	/// ROOT is never a child, so 0 marks an empty slot.
+	std::vector<NodeID> slots;
+	size_t slotmask;
+
+	static size_t hash(NodeID parent, PROFILER_ADDR addr);
+	void grow();
+};
+
+#endif //__CALLSTACKTRIE_H_666_
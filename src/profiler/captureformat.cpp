@@ -0,0 +1,306 @@
+/*=====================================================================
+captureformat.cpp
+-----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "captureformat.h"
+#include "../utils/varint.h"
+
+CaptureEncoder::CaptureEncoder()
+:	num_inlined(0)
+{
+	intern(std::string());
+}
+
+unsigned CaptureEncoder::intern(const std::string &s)
+{
+	std::map<std::string, unsigned>::iterator it = string_index.find(s);
+	if (it != string_index.end())
+		return it->second;
+
+	unsigned index = (unsigned)strings.size();
+	strings.push_back(s);
+	string_index[s] = index;
+	return index;
+}
+
+unsigned long long CaptureEncoder::toMicroseconds(SAMPLE_TYPE count)
+{
+	// Anything sampled at all counts for something.
+	if (count <= 0)
+		return 0;
+	unsigned long long us = (unsigned long long)(count * 1e6 + 0.5);
+	return us ? us : 1;
+}
+
+void CaptureEncoder::flushInlined(std::vector<unsigned char> &out) const
+{
+	// The count goes before the functions, so they wait for the next row.
+	writeVarint(out, num_inlined);
+	out.insert(out.end(), inlined.begin(), inlined.end());
+}
+
+void CaptureEncoder::addSymbol(PROFILER_ADDR addr, PROFILER_ADDR module_base, const std::string &module,
+							   const std::string &proc, const std::string &file, unsigned line)
+{
+	if (!addrs.empty())
+	{
+		flushInlined(rows);
+		inlined.clear();
+		num_inlined = 0;
+	}
+
+	if (addr < module_base)
+		module_base = 0;
+
+	unsigned name = intern(module);
+	std::pair<PROFILER_ADDR, unsigned> key(module_base, name);
+	std::map<std::pair<PROFILER_ADDR, unsigned>, unsigned>::iterator it = module_index.find(key);
+	if (it == module_index.end())
+	{
+		Module mod = { name, module_base, module_base };
+		it = module_index.insert(std::make_pair(key, (unsigned)modules.size())).first;
+		modules.push_back(mod);
+	}
+	Module &mod = modules[it->second];
+
+	writeVarint(rows, it->second);
+	writeVarint(rows, addr - mod.last);
+	mod.last = addr;
+	writeVarint(rows, intern(proc));
+	writeVarint(rows, intern(file));
+	writeVarint(rows, line);
+
+	addr_index[addr] = (unsigned)addrs.size();
+	addrs.push_back(addr);
+}
+
+void CaptureEncoder::addInlined(const std::string &proc, const std::string &file, unsigned line)
+{
+	if (num_inlined == MAX_INLINE_DEPTH)
+		return;
+
+	writeVarint(inlined, intern(proc));
+	writeVarint(inlined, intern(file));
+	writeVarint(inlined, line);
+	num_inlined++;
+}
+
+void CaptureEncoder::encodeSymbols(std::vector<unsigned char> &out) const
+{
+	writeVarint(out, strings.size());
+	for (size_t i = 0; i < strings.size(); i++)
+	{
+		writeVarint(out, strings[i].length());
+		out.insert(out.end(), strings[i].begin(), strings[i].end());
+	}
+
+	writeVarint(out, modules.size());
+	for (size_t i = 0; i < modules.size(); i++)
+	{
+		writeVarint(out, modules[i].name);
+		writeVarint(out, modules[i].base);
+	}
+
+	writeVarint(out, addrs.size());
+	out.insert(out.end(), rows.begin(), rows.end());
+	if (!addrs.empty())
+		flushInlined(out);
+}
+
+void CaptureEncoder::encodeIpCounts(const CallStackTrie &callstacks, std::vector<unsigned char> &out) const
+{
+	// Nodes with a count are the innermost frames of samples.
+	std::map<unsigned, SAMPLE_TYPE> flatcounts;
+	SAMPLE_TYPE total = 0;
+	for (CallStackTrie::NodeID id = 1; id < callstacks.getNodeCount(); id++)
+	{
+		const CallStackTrie::Node &node = callstacks.getNode(id);
+		if (node.count > 0)
+		{
+			flatcounts[addr_index.find(node.addr)->second] += node.count;
+			total += node.count;
+		}
+	}
+
+	writeVarint(out, toMicroseconds(total));
+	writeVarint(out, flatcounts.size());
+	unsigned prev = 0;
+	for (std::map<unsigned, SAMPLE_TYPE>::const_iterator it = flatcounts.begin(); it != flatcounts.end(); ++it)
+	{
+		writeVarint(out, it->first - prev);
+		writeVarint(out, toMicroseconds(it->second));
+		prev = it->first;
+	}
+}
+
+void CaptureEncoder::encodeCallstacks(const CallStackTrie &callstacks, std::vector<unsigned char> &out) const
+{
+	// The trie adds parents before their children, so the distance back is never 0.
+	writeVarint(out, callstacks.getNodeCount() - 1);
+	for (CallStackTrie::NodeID id = 1; id < callstacks.getNodeCount(); id++)
+	{
+		const CallStackTrie::Node &node = callstacks.getNode(id);
+		writeVarint(out, id - node.parent);
+		writeVarint(out, addr_index.find(node.addr)->second);
+
+		writeVarint(out, toMicroseconds(node.count));
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// Counts read from the file are checked against what's left of it
+// before anything is sized by them.
+static bool readCount(const unsigned char *&pos, const unsigned char *end, size_t &count)
+{
+	unsigned long long value;
+	if (!readVarint(pos, end, value) || value > (unsigned long long)(end - pos))
+		return false;
+	count = (size_t)value;
+	return true;
+}
+
+static bool readIndex(const unsigned char *&pos, const unsigned char *end, size_t limit, unsigned &index)
+{
+	unsigned long long value;
+	if (!readVarint(pos, end, value) || value >= limit)
+		return false;
+	index = (unsigned)value;
+	return true;
+}
+
+bool CaptureDecoder::decodeSymbols(const unsigned char *data, size_t size)
+{
+	const unsigned char *pos = data, *end = data + size;
+	strings.clear();
+	symbols.clear();
+	addrs.clear();
+
+	size_t numStrings;
+	if (!readCount(pos, end, numStrings))
+		return false;
+	strings.resize(numStrings);
+	for (size_t i = 0; i < numStrings; i++)
+	{
+		size_t length;
+		if (!readCount(pos, end, length))
+			return false;
+		strings[i].assign((const char *)pos, length);
+		pos += length;
+	}
+
+	struct Module
+	{
+		unsigned name;
+		unsigned long long last;
+	};
+	size_t numModules;
+	if (!readCount(pos, end, numModules))
+		return false;
+	std::vector<Module> modules(numModules);
+	for (size_t i = 0; i < numModules; i++)
+		if (!readIndex(pos, end, numStrings, modules[i].name) || !readVarint(pos, end, modules[i].last))
+			return false;
+
+	size_t numAddrs;
+	if (!readCount(pos, end, numAddrs))
+		return false;
+	addrs.reserve(numAddrs);
+	symbols.reserve(numAddrs);
+	for (size_t i = 0; i < numAddrs; i++)
+	{
+		unsigned mod;
+		unsigned long long offset, line;
+		size_t numInlined;
+		Symbol symbol;
+		if (!readIndex(pos, end, numModules, mod) || !readVarint(pos, end, offset) ||
+			!readIndex(pos, end, numStrings, symbol.proc) || !readIndex(pos, end, numStrings, symbol.file) ||
+			!readVarint(pos, end, line) || !readCount(pos, end, numInlined) || numInlined > MAX_INLINE_DEPTH)
+			return false;
+
+		unsigned long long addr = modules[mod].last += offset;
+		addrs.push_back(addr);
+
+		symbol.addr = addr;
+		symbol.depth = 0;
+		symbol.module = modules[mod].name;
+		symbol.line = (unsigned)line;
+		symbols.push_back(symbol);
+
+		for (unsigned depth = 1; depth <= numInlined; depth++)
+		{
+			if (!readIndex(pos, end, numStrings, symbol.proc) || !readIndex(pos, end, numStrings, symbol.file) ||
+				!readVarint(pos, end, line))
+				return false;
+			symbol.addr = inlineFrameAddress(addr, depth);
+			symbol.depth = depth;
+			symbol.line = (unsigned)line;
+			symbols.push_back(symbol);
+		}
+	}
+	return pos == end;
+}
+
+bool CaptureDecoder::decodeIpCounts(const unsigned char *data, size_t size, unsigned long long &total,
+									std::vector<std::pair<unsigned, unsigned long long> > &counts) const
+{
+	const unsigned char *pos = data, *end = data + size;
+	counts.clear();
+
+	size_t numCounts;
+	if (!readVarint(pos, end, total) || !readCount(pos, end, numCounts))
+		return false;
+	counts.reserve(numCounts);
+
+	unsigned long long index = 0;
+	for (size_t i = 0; i < numCounts; i++)
+	{
+		unsigned long long delta, count;
+		if (!readVarint(pos, end, delta) || !readVarint(pos, end, count) ||
+			(index += delta) >= addrs.size())
+			return false;
+		counts.push_back(std::make_pair((unsigned)index, count));
+	}
+	return pos == end;
+}
+
+bool CaptureDecoder::decodeCallstacks(const unsigned char *data, size_t size, std::vector<Node> &nodes) const
+{
+	const unsigned char *pos = data, *end = data + size;
+
+	size_t numNodes;
+	if (!readCount(pos, end, numNodes))
+		return false;
+	nodes.resize(numNodes + 1);
+	nodes[0].parent = 0;
+	nodes[0].addr = 0;
+	nodes[0].count = 0;
+
+	for (size_t id = 1; id <= numNodes; id++)
+	{
+		unsigned long long back;
+		Node &node = nodes[id];
+		if (!readVarint(pos, end, back) || back == 0 || back > id ||
+			!readIndex(pos, end, addrs.size(), node.addr) || !readVarint(pos, end, node.count))
+			return false;
+		node.parent = (unsigned)(id - back);
+	}
+	return pos == end;
+}
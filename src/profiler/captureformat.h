@@ -0,0 +1,164 @@
+/*=====================================================================
+captureformat.h
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __CAPTUREFORMAT_H_666_
+#define __CAPTUREFORMAT_H_666_
+
+#include "callstacktrie.h"
+#include <map>
+#include <string>
+#include <vector>
+
+/*=====================================================================
+CaptureEncoder
+--------------
+Writes the binary entries that hold a capture's symbols and samples,
+which replaced Symbols.txt, IPCounts.txt and Callstacks.txt in format
+0.91. All numbers are varints (see varint.h), strings are UTF-8, and
+counts are in microseconds.
+
+Symbols.bin:
+
+	varint   number of strings, then for each: varint length, the bytes
+	varint   number of modules, then for each:
+	varint     name, as an index into the strings
+	varint     base address
+	varint   number of addresses, then for each, in address order:
+	varint     module index
+	varint     offset from the module's previous address (the first: from its base)
+	varint     function, source file (as indices into the strings), line
+	varint     number of functions inlined there, then for each,
+	           innermost first: function, source file, line
+
+String 0 is the empty string. The address table this makes is what
+the other entries refer to, by index. The functions inlined at an
+address are given the addresses inlineFrameAddress makes for them.
+
+IPCounts.bin:
+
+	varint   total count
+	varint   number of addresses sampled, then for each, in address order:
+	varint     delta from the previous one's index in the address table
+	varint     count
+
+Callstacks.bin is the trie the stacks were gathered in, so that
+stacks share their common outer frames:
+
+	varint   number of nodes, then for each, parents before children:
+	varint     how many nodes back its parent is (the root, before
+	           the first node, has no address)
+	varint     its frame's index in the address table
+	varint     count of the samples whose innermost frame this is, or 0
+
+A node with a count is a stack; its ID, as Samples.bin refers to it,
+is its position among them.
+=====================================================================*/
+class CaptureEncoder
+{
+public:
+	CaptureEncoder();
+
+	/// Add symbols in address order; module_base is where the module
+	/// addr is in was loaded, 0 if it isn't in one.
+	void addSymbol(PROFILER_ADDR addr, PROFILER_ADDR module_base, const std::string &module,
+				   const std::string &proc, const std::string &file, unsigned line);
+
+	/// A function inlined at the last address added, innermost first.
+	void addInlined(const std::string &proc, const std::string &file, unsigned line);
+
+	void encodeSymbols(std::vector<unsigned char> &out) const;
+
+	/// The nodes of callstacks, whose addresses must all have been added.
+	void encodeIpCounts(const CallStackTrie &callstacks, std::vector<unsigned char> &out) const;
+	void encodeCallstacks(const CallStackTrie &callstacks, std::vector<unsigned char> &out) const;
+
+	/// At least 1 for any count above 0, so that every stack is kept.
+	static unsigned long long toMicroseconds(SAMPLE_TYPE count);
+
+private:
+	std::vector<std::string> strings;
+	std::map<std::string, unsigned> string_index;
+	unsigned intern(const std::string &s);
+
+	struct Module
+	{
+		unsigned name;
+		PROFILER_ADDR base;
+		PROFILER_ADDR last; // of its addresses so far
+	};
+	std::vector<Module> modules;
+	std::map<std::pair<PROFILER_ADDR, unsigned>, unsigned> module_index;
+
+	/// Encoded address rows, and the address table they make.
+	std::vector<unsigned char> rows;
+	std::vector<PROFILER_ADDR> addrs;
+	std::map<PROFILER_ADDR, unsigned> addr_index;
+
+	/// The functions inlined at the last address added.
+	std::vector<unsigned char> inlined;
+	unsigned num_inlined;
+	void flushInlined(std::vector<unsigned char> &out) const;
+};
+
+/*=====================================================================
+CaptureDecoder
+--------------
+Reads what CaptureEncoder writes. Each decode returns false if the
+data is malformed; Symbols.bin has to be decoded before the others.
+=====================================================================*/
+class CaptureDecoder
+{
+public:
+	struct Symbol
+	{
+		unsigned long long addr; // an inlineFrameAddress if depth > 0
+		unsigned depth;          // 0 for the address itself, from 1 for what was inlined there
+		unsigned module, proc, file; // indices into strings
+		unsigned line;
+	};
+
+	std::vector<std::string> strings;
+
+	/// In file order: each address, then the functions inlined there.
+	std::vector<Symbol> symbols;
+
+	/// The address table. 64-bit whatever this build's PROFILER_ADDR,
+	/// as the capture may be of a 64-bit target.
+	std::vector<unsigned long long> addrs;
+
+	bool decodeSymbols(const unsigned char *data, size_t size);
+
+	bool decodeIpCounts(const unsigned char *data, size_t size, unsigned long long &total,
+						std::vector<std::pair<unsigned, unsigned long long> > &counts) const;
+
+	struct Node
+	{
+		unsigned parent; // 0 for the root, otherwise from 1 as in the file
+		unsigned addr;   // into addrs
+		unsigned long long count;
+	};
+
+	/// nodes[0] stands for the root.
+	bool decodeCallstacks(const unsigned char *data, size_t size, std::vector<Node> &nodes) const;
+};
+
+#endif //__CAPTUREFORMAT_H_666_
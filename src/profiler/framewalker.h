@@ -0,0 +1,190 @@
+/*=====================================================================
+framewalker.h
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __FRAMEWALKER_H_666_
+#define __FRAMEWALKER_H_666_
+
+#include "profilertypes.h"
+#include <string.h>
+
+/// Registers of one frame, as far as unwinding is concerned.
+struct StackFrame
+{
+	PROFILER_ADDR ip, sp, fp;
+};
+
+/// What a step from one frame to its caller made of it.
+enum FrameStep
+{
+	FRAME_STEPPED,   ///< frame is now its caller
+	FRAME_OUTERMOST, ///< frame is now its caller, which is the outermost frame
+	FRAME_LAST,      ///< frame is the outermost; it has no caller
+	FRAME_UNKNOWN,   ///< can't tell from here; another unwinder might
+	FRAME_BROKEN     ///< what should lead to the caller doesn't
+};
+
+/*=====================================================================
+UnwindRule
+----------
+How to get from a frame to its caller, for the code at one PC, as
+worked out from a module's unwind tables. The canonical frame address
+(CFA, the caller's stack pointer) is sp or fp plus cfa_offset; the
+return address and the caller's frame pointer are saved relative to it.
+=====================================================================*/
+struct UnwindRule
+{
+	enum CfaReg
+	{
+		CFA_NONE, ///< no usable rule for this PC
+		CFA_SP,
+		CFA_FP
+	};
+
+	enum Rule
+	{
+		SAME,      ///< register still holds the caller's value
+		SAVED,     ///< saved at CFA + offset
+		UNDEFINED, ///< for the return address: this is the outermost frame
+		LOST       ///< for the frame pointer: the caller's value can't be recovered
+	};
+
+	enum Flags
+	{
+		/// The instruction at the PC may begin an epilogue, which the rule
+		/// doesn't describe; only good for frames that have made a call.
+		MAYBE_EPILOGUE = 1
+	};
+
+	int cfa_offset;
+	short ra_offset;
+	short fp_offset;
+	unsigned char cfa_reg;
+	unsigned char ra_rule; ///< SAVED or UNDEFINED
+	unsigned char fp_rule; ///< SAME, SAVED or LOST
+	unsigned char flags;
+
+	bool operator==(const UnwindRule &other) const
+	{
+		return cfa_offset == other.cfa_offset && ra_offset == other.ra_offset &&
+			fp_offset == other.fp_offset && cfa_reg == other.cfa_reg &&
+			ra_rule == other.ra_rule && fp_rule == other.fp_rule && flags == other.flags;
+	}
+};
+
+/*=====================================================================
+stepFramePointer
+----------------
+Steps from a frame to its caller by following the saved frame pointer,
+reading from a copy of the top of a thread's stack rather than calling
+into the OS or a debugging library. Each frame starts with the caller's
+frame pointer, followed by the return address; both are ptr_size bytes.
+
+Every step is checked before it is taken: the frame must lie within
+the copy, above the one before it, and its return address must be in
+a module. Modules tells us which addresses those are:
+
+	bool isCode(PROFILER_ADDR addr);
+	bool keepsFramePointers(PROFILER_ADDR ip);  // may we trust fp in the function at ip?
+	void chainBroke(PROFILER_ADDR ip);          // fp in the function at ip was not a frame
+=====================================================================*/
+template<class Modules>
+FrameStep stepFramePointer(const unsigned char *copy, PROFILER_ADDR copy_addr, size_t copy_size,
+						   size_t ptr_size, Modules &modules, StackFrame &frame)
+{
+	if (!modules.keepsFramePointers(frame.ip))
+		return FRAME_UNKNOWN;
+
+	// Frames only get older going up the stack, so the frame pointer
+	// must be above the frame below; frame.sp says where that ended.
+	if (frame.fp < frame.sp || frame.fp % ptr_size != 0)
+	{
+		modules.chainBroke(frame.ip);
+		return FRAME_BROKEN;
+	}
+
+	// Past the end of the copy the chain may well be fine; we just can't see it.
+	if (frame.fp < copy_addr || frame.fp - copy_addr + 2 * ptr_size > copy_size)
+		return FRAME_UNKNOWN;
+
+	PROFILER_ADDR saved_fp = 0, ret = 0;
+	memcpy(&saved_fp, copy + (frame.fp - copy_addr), ptr_size);
+	memcpy(&ret, copy + (frame.fp - copy_addr) + ptr_size, ptr_size);
+
+	if (!modules.isCode(ret))
+	{
+		modules.chainBroke(frame.ip);
+		return FRAME_BROKEN;
+	}
+
+	frame.ip = ret;
+	frame.sp = frame.fp + 2 * ptr_size;
+	frame.fp = saved_fp;
+
+	// The outermost frame has no caller's frame pointer to save.
+	return saved_fp == 0 ? FRAME_OUTERMOST : FRAME_STEPPED;
+}
+
+/*=====================================================================
+stepUnwindRule
+--------------
+Steps from a frame to its caller as an UnwindRule for its PC says,
+reading saved registers from the stack copy. Checked like
+stepFramePointer: the caller's frame must be above this one, and its
+return address must be code.
+=====================================================================*/
+template<class Modules>
+FrameStep stepUnwindRule(const UnwindRule &rule, const unsigned char *copy, PROFILER_ADDR copy_addr, size_t copy_size,
+						 size_t ptr_size, Modules &modules, StackFrame &frame)
+{
+	if (rule.cfa_reg == UnwindRule::CFA_NONE)
+		return FRAME_UNKNOWN;
+	if (rule.ra_rule == UnwindRule::UNDEFINED)
+		return FRAME_LAST;
+
+	PROFILER_ADDR cfa = (rule.cfa_reg == UnwindRule::CFA_SP ? frame.sp : frame.fp) + rule.cfa_offset;
+	PROFILER_ADDR ret_addr = cfa + rule.ra_offset;
+	PROFILER_ADDR fp_addr = cfa + rule.fp_offset;
+	if (ret_addr < copy_addr || ret_addr - copy_addr + ptr_size > copy_size)
+		return FRAME_UNKNOWN;
+	if (rule.fp_rule == UnwindRule::SAVED && (fp_addr < copy_addr || fp_addr - copy_addr + ptr_size > copy_size))
+		return FRAME_UNKNOWN;
+
+	PROFILER_ADDR ret = 0, fp = frame.fp;
+	memcpy(&ret, copy + (ret_addr - copy_addr), ptr_size);
+	if (rule.fp_rule == UnwindRule::SAVED)
+	{
+		fp = 0;
+		memcpy(&fp, copy + (fp_addr - copy_addr), ptr_size);
+	}
+	else if (rule.fp_rule == UnwindRule::LOST)
+		fp = 0;
+
+	if (cfa <= frame.sp || !modules.isCode(ret))
+		return FRAME_BROKEN;
+
+	frame.ip = ret;
+	frame.sp = cfa;
+	frame.fp = fp;
+	return FRAME_STEPPED;
+}
+
+#endif //__FRAMEWALKER_H_666_
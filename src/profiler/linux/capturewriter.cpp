@@ -0,0 +1,119 @@
+/*=====================================================================
+capturewriter.cpp
+-----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "capturewriter.h"
+#include "zipwriter.h"
+#include "../../appinfo.h"
+#include <stdio.h>
+#include <map>
+
+CaptureWriter::CaptureWriter(const CallStackTrie &callstacks_, const ProcMaps &maps_, ElfSymbolizer &symbolizer_)
+:	callstacks(callstacks_),
+	maps(maps_),
+	symbolizer(symbolizer_)
+{
+}
+
+// Same form as ProfilerThread::saveData: proc is named by address when
+// it has no symbol, and is in an unknown file if it has no line information.
+static void fillUnknown(unsigned long long addr, std::string &proc_name, std::string &file)
+{
+	if (proc_name.empty())
+	{
+		char buf[32];
+		snprintf(buf, sizeof(buf), "[%016llX]", addr);
+		proc_name = buf;
+	}
+	else if (file.empty())
+	{
+		file = "[unknown]";
+	}
+}
+
+void CaptureWriter::symbolize()
+{
+	// Every trie node lies on the path of at least one sample,
+	// so its address needs a symbol.
+	std::map<PROFILER_ADDR, bool> used_addresses;
+	for (CallStackTrie::NodeID id = 1; id < callstacks.getNodeCount(); id++)
+		used_addresses[callstacks.getNode(id).addr] = true;
+
+	std::vector<ElfSymbolizer::InlineFrame> inlined;
+	for (auto i = used_addresses.begin(); i != used_addresses.end(); ++i)
+	{
+		PROFILER_ADDR addr = i->first;
+		std::string module = maps.getModuleName(addr);
+
+		// Where offset 0 of the file would be mapped; the same for every
+		// mapping of a module, and below all of its addresses.
+		const ProcMaps::Mapping *mapping = maps.find(addr);
+		PROFILER_ADDR base = mapping && mapping->start >= mapping->offset ? (PROFILER_ADDR)(mapping->start - mapping->offset) : 0;
+
+		std::string proc_name, file;
+		unsigned line;
+		symbolizer.resolve(maps, addr, proc_name, file, line, inlined);
+		fillUnknown(addr, proc_name, file);
+		encoder.addSymbol(addr, base, module, proc_name, file, line);
+
+		// Inlined functions get addresses of their own, which
+		// Database::loadCallstacks puts before addr.
+		for (size_t depth = 1; depth <= inlined.size(); depth++)
+		{
+			ElfSymbolizer::InlineFrame &frame = inlined[depth - 1];
+			fillUnknown(inlineFrameAddress(addr, (unsigned)depth), frame.proc, frame.file);
+			encoder.addInlined(frame.proc, frame.file, frame.line);
+		}
+	}
+}
+
+bool CaptureWriter::save(const std::string &path)
+{
+	ZipWriter zip;
+	if (!zip.open(path))
+		return false;
+
+	// Symbols first, so that the stats can say how looking them up went.
+	symbolize();
+	std::vector<std::string> lines = stats;
+	symbolizer.getStats(lines);
+
+	std::string text;
+	for (size_t i = 0; i < lines.size(); i++)
+		text += lines[i] + "\n";
+	zip.addEntry("Stats.txt", text);
+
+	// Before the entries that refer to its addresses.
+	std::vector<unsigned char> data;
+	encoder.encodeSymbols(data);
+	zip.addEntry("Symbols.bin", &data[0], data.size());
+	data.clear();
+	encoder.encodeIpCounts(callstacks, data);
+	zip.addEntry("IPCounts.bin", &data[0], data.size());
+	data.clear();
+	encoder.encodeCallstacks(callstacks, data);
+	zip.addEntry("Callstacks.bin", &data[0], data.size());
+
+	// Change FORMAT_VERSION when the file format changes
+	// (and becomes unreadable by older versions of Sleepy).
+	zip.addEntry("Version " FORMAT_VERSION " required", FORMAT_VERSION "\n");
+
+	return zip.close();
+}
@@ -0,0 +1,63 @@
+/*=====================================================================
+capturewriter.h
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __CAPTUREWRITER_H_666_
+#define __CAPTUREWRITER_H_666_
+
+#include "../callstacktrie.h"
+#include "../captureformat.h"
+#include "elfsymbolizer.h"
+#include "procmaps.h"
+#include <string>
+#include <vector>
+
+/*=====================================================================
+CaptureWriter
+-------------
+Saves a capture taken without the GUI, in the layout that
+ProfilerThread::saveData writes and Database::loadFromPath reads:
+Stats.txt, Symbols.bin, IPCounts.bin, Callstacks.bin and the
+"Version ... required" entry.
+=====================================================================*/
+class CaptureWriter
+{
+public:
+	CaptureWriter(const CallStackTrie &callstacks, const ProcMaps &maps, ElfSymbolizer &symbolizer);
+
+	/// Lines of Stats.txt.
+	std::vector<std::string> stats;
+
+	/// Returns false if the file couldn't be written.
+	bool save(const std::string &path);
+
+private:
+	const CallStackTrie &callstacks;
+	const ProcMaps &maps;
+	ElfSymbolizer &symbolizer;
+
+	/// Every address in the trie, named.
+	CaptureEncoder encoder;
+
+	void symbolize();
+};
+
+#endif //__CAPTUREWRITER_H_666_
@@ -0,0 +1,634 @@
+/*=====================================================================
+cfitable.cpp
+------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "cfitable.h"
+#include "elfimage.h"
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+
+// DWARF register numbers of the stack and frame pointers.
+#if defined(__x86_64__)
+static const unsigned kSpReg = 7, kFpReg = 6;
+#elif defined(__i386__)
+static const unsigned kSpReg = 4, kFpReg = 5;
+#elif defined(__aarch64__)
+static const unsigned kSpReg = 31, kFpReg = 29;
+#else
+#error "CfiTable doesn't know this architecture's registers"
+#endif
+
+// Pointer encodings (DW_EH_PE_*), as used by .eh_frame and .eh_frame_hdr.
+enum
+{
+	PE_ABSPTR = 0x00, PE_ULEB128 = 0x01, PE_UDATA2 = 0x02, PE_UDATA4 = 0x03, PE_UDATA8 = 0x04,
+	PE_SLEB128 = 0x09, PE_SDATA2 = 0x0a, PE_SDATA4 = 0x0b, PE_SDATA8 = 0x0c,
+	PE_PCREL = 0x10, PE_DATAREL = 0x30, PE_INDIRECT = 0x80, PE_OMIT = 0xff
+};
+
+// Call frame instructions (DW_CFA_*).
+enum
+{
+	CFA_advance_loc = 0x40, CFA_offset = 0x80, CFA_restore = 0xc0,
+	CFA_nop = 0x00, CFA_set_loc = 0x01, CFA_advance_loc1 = 0x02, CFA_advance_loc2 = 0x03,
+	CFA_advance_loc4 = 0x04, CFA_offset_extended = 0x05, CFA_restore_extended = 0x06,
+	CFA_undefined = 0x07, CFA_same_value = 0x08, CFA_register = 0x09,
+	CFA_remember_state = 0x0a, CFA_restore_state = 0x0b, CFA_def_cfa = 0x0c,
+	CFA_def_cfa_register = 0x0d, CFA_def_cfa_offset = 0x0e, CFA_def_cfa_expression = 0x0f,
+	CFA_expression = 0x10, CFA_offset_extended_sf = 0x11, CFA_def_cfa_sf = 0x12,
+	CFA_def_cfa_offset_sf = 0x13, CFA_val_offset = 0x14, CFA_val_offset_sf = 0x15,
+	CFA_val_expression = 0x16, CFA_AARCH64_negate_ra_state = 0x2d,
+	CFA_GNU_args_size = 0x2e, CFA_GNU_negative_offset_extended = 0x2f
+};
+
+// Reads the little-endian, LEB128 and encoded-pointer fields of .eh_frame.
+// Running off the end clears ok rather than reading past it.
+class CfiCursor
+{
+public:
+	CfiCursor(const unsigned char *begin_, const unsigned char *end_, unsigned long long addr_)
+	:	p(begin_), begin(begin_), end(end_), addr(addr_), ok(true)
+	{}
+
+	const unsigned char *p, *begin, *end;
+	unsigned long long addr; // where begin is loaded
+	bool ok;
+
+	unsigned long long here() const { return addr + (p - begin); }
+
+	unsigned long long fixed(size_t size)
+	{
+		if ((size_t)(end - p) < size)
+		{
+			ok = false;
+			p = end;
+			return 0;
+		}
+		unsigned long long value = 0;
+		for (size_t i = 0; i < size; i++)
+			value |= (unsigned long long)p[i] << (8 * i);
+		p += size;
+		return value;
+	}
+
+	long long signedFixed(size_t size)
+	{
+		unsigned long long value = fixed(size);
+		if (size < 8 && (value >> (8 * size - 1)) & 1)
+			value |= ~0ULL << (8 * size);
+		return (long long)value;
+	}
+
+	unsigned long long uleb()
+	{
+		unsigned long long value = 0;
+		for (unsigned shift = 0; p < end; shift += 7)
+		{
+			unsigned char byte = *p++;
+			if (shift < 64)
+				value |= (unsigned long long)(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return value;
+		}
+		ok = false;
+		return value;
+	}
+
+	long long sleb()
+	{
+		unsigned long long value = 0;
+		for (unsigned shift = 0; p < end; )
+		{
+			unsigned char byte = *p++;
+			if (shift < 64)
+				value |= (unsigned long long)(byte & 0x7f) << shift;
+			shift += 7;
+			if (!(byte & 0x80))
+			{
+				if (shift < 64 && (byte & 0x40))
+					value |= ~0ULL << shift;
+				return (long long)value;
+			}
+		}
+		ok = false;
+		return (long long)value;
+	}
+
+	void skip(unsigned long long size)
+	{
+		if ((unsigned long long)(end - p) < size)
+		{
+			ok = false;
+			p = end;
+		}
+		else
+			p += size;
+	}
+
+	/// Only the encodings compilers actually emit into .eh_frame are understood.
+	unsigned long long pointer(unsigned char encoding, unsigned long long data_base = 0)
+	{
+		if (encoding == PE_OMIT)
+			return 0;
+
+		unsigned long long field = here();
+		unsigned long long value;
+		switch (encoding & 0x0f)
+		{
+		case PE_ABSPTR:  value = fixed(sizeof(void *)); break;
+		case PE_ULEB128: value = uleb(); break;
+		case PE_UDATA2:  value = fixed(2); break;
+		case PE_UDATA4:  value = fixed(4); break;
+		case PE_UDATA8:  value = fixed(8); break;
+		case PE_SLEB128: value = (unsigned long long)sleb(); break;
+		case PE_SDATA2:  value = (unsigned long long)signedFixed(2); break;
+		case PE_SDATA4:  value = (unsigned long long)signedFixed(4); break;
+		case PE_SDATA8:  value = (unsigned long long)signedFixed(8); break;
+		default:
+			ok = false;
+			return 0;
+		}
+
+		// PE_INDIRECT means value is where the pointer is stored. Only
+		// personality routines are indirect, and those are skipped anyway.
+		switch (encoding & 0x70)
+		{
+		case 0: break;
+		case PE_PCREL:   value += field; break;
+		case PE_DATAREL: value += data_base; break;
+		default:
+			ok = false;
+			return 0;
+		}
+
+		if (sizeof(void *) == 4)
+			value &= 0xffffffffULL;
+		return value;
+	}
+};
+
+struct CieInfo
+{
+	unsigned long long code_align;
+	long long data_align;
+	unsigned long long ra_reg;
+	unsigned char fde_encoding;
+	bool has_augmentation_data;
+	const unsigned char *insns, *insns_end;
+};
+
+// The rules for the registers we track, as a CFA program runs.
+struct RegRule
+{
+	unsigned char rule;
+	long long offset;
+};
+
+struct FrameState
+{
+	unsigned long long cfa_reg;
+	long long cfa_offset;
+	bool cfa_expr;
+	RegRule ra, fp;
+};
+
+typedef std::vector<std::pair<unsigned long long, UnwindRule> > WideRows;
+
+static bool fitsShort(long long value)
+{
+	return value >= -32768 && value <= 32767;
+}
+
+static UnwindRule makeRule(const FrameState &state)
+{
+	UnwindRule rule;
+	memset(&rule, 0, sizeof(rule));
+	rule.cfa_reg = UnwindRule::CFA_NONE;
+
+	if (state.cfa_expr || (state.cfa_reg != kSpReg && state.cfa_reg != kFpReg) ||
+		state.cfa_offset < -0x7fffffffLL || state.cfa_offset > 0x7fffffffLL)
+		return rule;
+
+	if (state.ra.rule == UnwindRule::SAVED && fitsShort(state.ra.offset))
+		rule.ra_offset = (short)state.ra.offset;
+	else if (state.ra.rule != UnwindRule::UNDEFINED)
+		return rule; // e.g. still in a register, as in leaf functions on some machines
+	rule.ra_rule = state.ra.rule;
+
+	if (state.fp.rule == UnwindRule::SAVED && fitsShort(state.fp.offset))
+	{
+		rule.fp_rule = UnwindRule::SAVED;
+		rule.fp_offset = (short)state.fp.offset;
+	}
+	else
+		rule.fp_rule = state.fp.rule == UnwindRule::SAME ? UnwindRule::SAME : UnwindRule::LOST;
+
+	rule.cfa_reg = state.cfa_reg == kSpReg ? UnwindRule::CFA_SP : UnwindRule::CFA_FP;
+	rule.cfa_offset = (int)state.cfa_offset;
+	return rule;
+}
+
+static void setRule(FrameState &state, const CieInfo &cie, unsigned long long reg, unsigned char rule, long long offset)
+{
+	RegRule *target = reg == cie.ra_reg ? &state.ra : reg == kFpReg ? &state.fp : NULL;
+	if (target)
+	{
+		target->rule = rule;
+		target->offset = offset;
+	}
+}
+
+// Runs a CFA program from loc. With rows, a row is added for each range
+// of code the program describes; without (a CIE's initial instructions),
+// only the state is updated. Returns false on anything not understood.
+static bool runProgram(CfiCursor &c, const CieInfo &cie, const FrameState &initial, FrameState &state,
+					   unsigned long long &loc, WideRows *rows)
+{
+	std::vector<FrameState> remembered;
+
+	while (c.p < c.end && c.ok)
+	{
+		unsigned char op = *c.p++;
+		unsigned long long advance = 0, reg;
+		long long offset;
+
+		unsigned char high = op & 0xc0;
+		if (high == CFA_advance_loc)
+			advance = (op & 0x3f) * cie.code_align;
+		else if (high == CFA_offset)
+		{
+			offset = (long long)c.uleb() * cie.data_align;
+			setRule(state, cie, op & 0x3f, UnwindRule::SAVED, offset);
+		}
+		else if (high == CFA_restore)
+		{
+			reg = op & 0x3f;
+			if (reg == cie.ra_reg) state.ra = initial.ra;
+			else if (reg == kFpReg) state.fp = initial.fp;
+		}
+		else switch (op)
+		{
+		case CFA_nop:
+		case CFA_AARCH64_negate_ra_state:
+			break;
+		case CFA_set_loc:
+		{
+			unsigned long long target = c.pointer(cie.fde_encoding);
+			if (target < loc)
+				return false;
+			advance = target - loc;
+			break;
+		}
+		case CFA_advance_loc1: advance = c.fixed(1) * cie.code_align; break;
+		case CFA_advance_loc2: advance = c.fixed(2) * cie.code_align; break;
+		case CFA_advance_loc4: advance = c.fixed(4) * cie.code_align; break;
+		case CFA_offset_extended:
+			reg = c.uleb();
+			offset = (long long)c.uleb() * cie.data_align;
+			setRule(state, cie, reg, UnwindRule::SAVED, offset);
+			break;
+		case CFA_offset_extended_sf:
+			reg = c.uleb();
+			offset = c.sleb() * cie.data_align;
+			setRule(state, cie, reg, UnwindRule::SAVED, offset);
+			break;
+		case CFA_GNU_negative_offset_extended:
+			reg = c.uleb();
+			offset = -(long long)c.uleb() * cie.data_align;
+			setRule(state, cie, reg, UnwindRule::SAVED, offset);
+			break;
+		case CFA_restore_extended:
+			reg = c.uleb();
+			if (reg == cie.ra_reg) state.ra = initial.ra;
+			else if (reg == kFpReg) state.fp = initial.fp;
+			break;
+		case CFA_undefined:
+			setRule(state, cie, c.uleb(), UnwindRule::UNDEFINED, 0);
+			break;
+		case CFA_same_value:
+			setRule(state, cie, c.uleb(), UnwindRule::SAME, 0);
+			break;
+		case CFA_register:
+			reg = c.uleb();
+			c.uleb();
+			setRule(state, cie, reg, UnwindRule::LOST, 0);
+			break;
+		case CFA_val_offset:
+			reg = c.uleb();
+			c.uleb();
+			setRule(state, cie, reg, UnwindRule::LOST, 0);
+			break;
+		case CFA_val_offset_sf:
+			reg = c.uleb();
+			c.sleb();
+			setRule(state, cie, reg, UnwindRule::LOST, 0);
+			break;
+		case CFA_expression:
+		case CFA_val_expression:
+			reg = c.uleb();
+			c.skip(c.uleb());
+			setRule(state, cie, reg, UnwindRule::LOST, 0);
+			break;
+		case CFA_remember_state:
+			remembered.push_back(state);
+			break;
+		case CFA_restore_state:
+			if (remembered.empty())
+				return false;
+			state = remembered.back();
+			remembered.pop_back();
+			break;
+		case CFA_def_cfa:
+			state.cfa_reg = c.uleb();
+			state.cfa_offset = (long long)c.uleb();
+			state.cfa_expr = false;
+			break;
+		case CFA_def_cfa_sf:
+			state.cfa_reg = c.uleb();
+			state.cfa_offset = c.sleb() * cie.data_align;
+			state.cfa_expr = false;
+			break;
+		case CFA_def_cfa_register:
+			state.cfa_reg = c.uleb();
+			state.cfa_expr = false;
+			break;
+		case CFA_def_cfa_offset:
+			state.cfa_offset = (long long)c.uleb();
+			break;
+		case CFA_def_cfa_offset_sf:
+			state.cfa_offset = c.sleb() * cie.data_align;
+			break;
+		case CFA_def_cfa_expression:
+			c.skip(c.uleb());
+			state.cfa_expr = true;
+			break;
+		case CFA_GNU_args_size:
+			c.uleb();
+			break;
+		default:
+			return false;
+		}
+
+		if (advance)
+		{
+			if (!rows)
+				return false; // CIEs describe no code
+			rows->push_back(std::make_pair(loc, makeRule(state)));
+			loc += advance;
+		}
+	}
+	return c.ok;
+}
+
+static bool parseCie(CfiCursor c, CieInfo &cie)
+{
+	unsigned version = (unsigned)c.fixed(1);
+	if (version != 1 && version != 3 && version != 4)
+		return false;
+
+	const char *augmentation = (const char *)c.p;
+	const unsigned char *nul = (const unsigned char *)memchr(c.p, 0, c.end - c.p);
+	if (!nul)
+		return false;
+	c.p = nul + 1;
+
+	if (version == 4)
+	{
+		// address_size, segment_selector_size
+		if (c.fixed(1) != sizeof(void *) || c.fixed(1) != 0)
+			return false;
+	}
+
+	cie.code_align = c.uleb();
+	cie.data_align = c.sleb();
+	cie.ra_reg = version == 1 ? c.fixed(1) : c.uleb();
+	cie.fde_encoding = PE_ABSPTR;
+	cie.has_augmentation_data = augmentation[0] == 'z';
+
+	if (cie.has_augmentation_data)
+	{
+		unsigned long long length = c.uleb();
+		CfiCursor data(c.p, c.p + length < c.end ? c.p + length : c.end, c.here());
+		for (const char *a = augmentation + 1; *a; a++)
+		{
+			switch (*a)
+			{
+			case 'L': data.fixed(1); break;
+			case 'R': cie.fde_encoding = (unsigned char)data.fixed(1); break;
+			case 'P':
+			{
+				unsigned char encoding = (unsigned char)data.fixed(1);
+				data.pointer(encoding & ~PE_INDIRECT);
+				break;
+			}
+			case 'S': case 'B': break;
+			default: return false;
+			}
+		}
+		if (!data.ok)
+			return false;
+		c.skip(length);
+	}
+	else if (augmentation[0])
+		return false; // can't tell how long its augmentation data is
+
+	cie.insns = c.p;
+	cie.insns_end = c.end;
+	return c.ok;
+}
+
+// Finds the start of .eh_frame through .eh_frame_hdr (which is loaded,
+// so is there even in stripped files), or failing that the section table.
+static const unsigned char *findEhFrame(const ElfImage &image, size_t &size, unsigned long long &addr)
+{
+	if (const ElfW(Phdr) *hdr_seg = image.findSegment(PT_GNU_EH_FRAME))
+	{
+		size_t avail;
+		const unsigned char *hdr = image.getDataAt(hdr_seg->p_vaddr, avail);
+		if (hdr && avail >= 4 && hdr[0] == 1)
+		{
+			CfiCursor c(hdr + 4, hdr + avail, hdr_seg->p_vaddr + 4);
+			addr = c.pointer(hdr[1], hdr_seg->p_vaddr);
+			const unsigned char *data = c.ok ? image.getDataAt(addr, size) : NULL;
+			if (data)
+				return data;
+		}
+	}
+	return image.findSection(".eh_frame", size, &addr);
+}
+
+CfiTable::CfiTable()
+:	base(0)
+{
+}
+
+static bool rowOrder(const std::pair<unsigned long long, UnwindRule> &a,
+					 const std::pair<unsigned long long, UnwindRule> &b)
+{
+	// Where one function ends and the next begins, the start of the
+	// next must win over the end of the last, so it goes after it.
+	if (a.first != b.first)
+		return a.first < b.first;
+	return (a.second.cfa_reg != UnwindRule::CFA_NONE) < (b.second.cfa_reg != UnwindRule::CFA_NONE);
+}
+
+bool CfiTable::build(const ElfImage &image)
+{
+	rows.clear();
+
+	size_t size;
+	unsigned long long addr;
+	const unsigned char *eh_frame = findEhFrame(image, size, addr);
+	if (!eh_frame || image.getSegments().empty())
+		return false;
+
+	base = image.getSegments()[0].p_vaddr;
+	for (size_t i = 1; i < image.getSegments().size(); i++)
+		if (image.getSegments()[i].p_vaddr < base)
+			base = image.getSegments()[i].p_vaddr;
+
+	UnwindRule none;
+	memset(&none, 0, sizeof(none));
+	none.cfa_reg = UnwindRule::CFA_NONE;
+
+	std::map<const unsigned char *, CieInfo> cies;
+	WideRows wide;
+
+	CfiCursor c(eh_frame, eh_frame + size, addr);
+	while (c.p < c.end)
+	{
+		unsigned long long length = c.fixed(4);
+		if (!c.ok || length == 0)
+			break; // the terminator
+		if (length == 0xffffffffULL)
+		{
+			// 64-bit DWARF; never emitted into .eh_frame in practice.
+			c.skip(c.fixed(8));
+			continue;
+		}
+
+		const unsigned char *entry = c.p;
+		c.skip(length);
+		if (!c.ok)
+			break;
+
+		CfiCursor e(entry, entry + length, addr + (entry - eh_frame));
+		unsigned long long cie_pointer = e.fixed(4);
+		if (cie_pointer == 0)
+			continue; // a CIE; parsed when an FDE refers to it
+
+		// The CIE pointer is relative to itself.
+		if (cie_pointer > (unsigned long long)(entry - eh_frame))
+			continue;
+		const unsigned char *cie_start = entry - cie_pointer;
+		std::map<const unsigned char *, CieInfo>::iterator it = cies.find(cie_start);
+		if (it == cies.end())
+		{
+			CieInfo cie;
+			memset(&cie, 0, sizeof(cie));
+			CfiCursor cc(cie_start, eh_frame + size, addr + (cie_start - eh_frame));
+			unsigned long long cie_length = cc.fixed(4);
+			bool ok = cc.ok && cie_length != 0xffffffffULL && cie_length <= (unsigned long long)(cc.end - cc.p);
+			if (ok)
+			{
+				CfiCursor body(cc.p, cc.p + cie_length, cc.here());
+				ok = body.fixed(4) == 0 && parseCie(body, cie);
+			}
+			if (!ok)
+				cie.insns = NULL;
+			it = cies.insert(std::make_pair(cie_start, cie)).first;
+		}
+		const CieInfo &cie = it->second;
+		if (!cie.insns)
+			continue;
+
+		unsigned long long pc_begin = e.pointer(cie.fde_encoding);
+		unsigned long long pc_range = e.pointer(cie.fde_encoding & 0x0f);
+		if (cie.has_augmentation_data)
+			e.skip(e.uleb());
+		if (!e.ok || pc_range == 0)
+			continue;
+
+		FrameState initial;
+		memset(&initial, 0, sizeof(initial));
+		initial.ra.rule = UnwindRule::LOST;
+		initial.fp.rule = UnwindRule::SAME;
+		unsigned long long loc = pc_begin;
+		CfiCursor insns(cie.insns, cie.insns_end, 0);
+		if (!runProgram(insns, cie, initial, initial, loc, NULL))
+			continue;
+
+		FrameState state = initial;
+		size_t first = wide.size();
+		if (!runProgram(e, cie, initial, state, loc, &wide))
+		{
+			// Keep what was understood up to here, but no further.
+			if (loc < pc_begin + pc_range)
+				wide.push_back(std::make_pair(loc, none));
+		}
+		else if (loc < pc_begin + pc_range)
+			wide.push_back(std::make_pair(loc, makeRule(state)));
+
+		// Rows from a bad advance past the end of the function are dropped.
+		size_t kept = first;
+		for (size_t i = first; i < wide.size(); i++)
+			if (wide[i].first < pc_begin + pc_range)
+				wide[kept++] = wide[i];
+		wide.resize(kept);
+		wide.push_back(std::make_pair(pc_begin + pc_range, none));
+	}
+
+	std::sort(wide.begin(), wide.end(), rowOrder);
+
+	rows.reserve(wide.size());
+	for (size_t i = 0; i < wide.size(); i++)
+	{
+		if (wide[i].first < base || wide[i].first - base > 0xffffffffULL)
+			continue;
+
+		// Of rows for the same PC, rowOrder put the one that applies last.
+		if (i + 1 < wide.size() && wide[i + 1].first == wide[i].first)
+			continue;
+
+		if (!rows.empty() && rows.back().rule == wide[i].second)
+			continue;
+		Row row = { (unsigned int)(wide[i].first - base), wide[i].second };
+		rows.push_back(row);
+	}
+
+	// Shrink to fit; libraries can have tens of thousands of rows.
+	std::vector<Row>(rows).swap(rows);
+	return !rows.empty();
+}
+
+const UnwindRule *CfiTable::find(unsigned long long addr) const
+{
+	if (addr < base || addr - base > 0xffffffffULL)
+		return NULL;
+
+	unsigned int pc = (unsigned int)(addr - base);
+	std::vector<Row>::const_iterator it = std::upper_bound(rows.begin(), rows.end(), pc, pcBefore);
+	if (it == rows.begin())
+		return NULL;
+	--it;
+	return it->rule.cfa_reg == UnwindRule::CFA_NONE ? NULL : &it->rule;
+}
@@ -0,0 +1,72 @@
+/*=====================================================================
+cfitable.h
+----------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __CFITABLE_H_666_
+#define __CFITABLE_H_666_
+
+#include "../framewalker.h"
+#include <stddef.h>
+#include <vector>
+
+class ElfImage;
+
+/*=====================================================================
+CfiTable
+--------
+A module's DWARF call frame information (.eh_frame), compiled down to
+what a sampler needs: an UnwindRule for each range of code.
+
+The CFA programs are run once, when the table is built, rather than on
+every sample. Rows are sorted by PC; each applies up to the next.
+Rules that need more than the stack pointer and frame pointer to
+evaluate (DWARF expressions, values kept in other registers) are left
+out, and a walker has to fall back on the frame pointer there.
+=====================================================================*/
+class CfiTable
+{
+public:
+	CfiTable();
+
+	/// Compile the image's .eh_frame. Returns false if it has none we can use.
+	bool build(const ElfImage &image);
+
+	/// The rule for addr (an address in the image), or NULL if there is
+	/// no usable rule for it.
+	const UnwindRule *find(unsigned long long addr) const;
+
+	unsigned long long getBase() const { return base; }
+	size_t getNumRows() const { return rows.size(); }
+
+private:
+	struct Row
+	{
+		unsigned int pc; ///< relative to base
+		UnwindRule rule;
+	};
+
+	unsigned long long base;
+	std::vector<Row> rows;
+
+	static bool pcBefore(unsigned int pc, const Row &row) { return pc < row.pc; }
+};
+
+#endif //__CFITABLE_H_666_
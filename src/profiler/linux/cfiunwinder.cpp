@@ -0,0 +1,168 @@
+/*=====================================================================
+cfiunwinder.cpp
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "cfiunwinder.h"
+#include <stdio.h>
+#include <string.h>
+
+// Frames are checked against the process's executable mappings.
+class MappedModules
+{
+public:
+	MappedModules(const ProcMaps &maps_) : maps(maps_) {}
+
+	bool isCode(PROFILER_ADDR addr) const
+	{
+		const ProcMaps::Mapping *mapping = maps.find(addr);
+		return mapping && mapping->executable;
+	}
+	bool keepsFramePointers(PROFILER_ADDR) const { return true; }
+	void chainBroke(PROFILER_ADDR) {}
+
+private:
+	const ProcMaps &maps;
+};
+
+CfiUnwinder::CfiUnwinder()
+:	cacheGeneration(0),
+	cfiFrames(0),
+	fpFrames(0),
+	cacheHits(0),
+	cacheMisses(0)
+{
+}
+
+CfiUnwinder::~CfiUnwinder()
+{
+	for (std::map<std::string, Module *>::iterator it = modules.begin(); it != modules.end(); ++it)
+		delete it->second;
+}
+
+void CfiUnwinder::setProcess(unsigned long process_id)
+{
+	char buf[64];
+	snprintf(buf, sizeof(buf), "/proc/%lu/root", process_id);
+	root = buf;
+}
+
+CfiUnwinder::Module *CfiUnwinder::getModule(const std::string &path)
+{
+	std::map<std::string, Module *>::iterator it = modules.find(path);
+	if (it != modules.end())
+		return it->second;
+
+	Module *module = new Module;
+	module->usable = (module->image.open(root + path) || module->image.open(path)) &&
+		module->table.build(module->image);
+	modules[path] = module;
+	return module;
+}
+
+UnwindRule CfiUnwinder::findRule(const ProcMaps &maps, PROFILER_ADDR pc)
+{
+	UnwindRule none;
+	memset(&none, 0, sizeof(none));
+	none.cfa_reg = UnwindRule::CFA_NONE;
+
+	// Anonymous mappings (JIT code), [vdso] and so on have no file to read.
+	const ProcMaps::Mapping *mapping = maps.find(pc);
+	if (!mapping || !mapping->executable || mapping->path.empty() || mapping->path[0] != '/')
+		return none;
+
+	Module *module = getModule(mapping->path);
+	if (!module->usable)
+		return none;
+
+	// The mapping says where in the file it starts; the file says what
+	// address that was linked at. The difference is the load bias.
+	unsigned long long linked;
+	if (!module->image.getAddrOfOffset(mapping->offset, linked))
+		return none;
+	const UnwindRule *rule = module->table.find(pc - mapping->start + linked);
+	return rule ? *rule : none;
+}
+
+void CfiUnwinder::walk(const ProcMaps &maps, StackFrame frame,
+					   const unsigned char *copy, PROFILER_ADDR copy_addr, size_t copy_size, CallStack &stack)
+{
+	MappedModules code(maps);
+
+	// Rules for code that has since been unmapped may not hold for what replaced it.
+	if (maps.getCodeGeneration() != cacheGeneration)
+	{
+		cache.clear();
+		cacheGeneration = maps.getCodeGeneration();
+	}
+
+	stack.depth = 0;
+	for (bool innermost = true; stack.depth < MAX_CALLSTACK_LEVELS; innermost = false)
+	{
+		stack.addr[stack.depth++] = frame.ip;
+
+		// Return addresses point after the call, which may be past the end
+		// of the function if it never returns; look up the call instead.
+		PROFILER_ADDR pc = innermost ? frame.ip : frame.ip - 1;
+		UnwindRule rule;
+		if (cache.lookup(pc, rule))
+			cacheHits++;
+		else
+		{
+			cacheMisses++;
+			rule = findRule(maps, pc);
+			cache.insert(pc, rule);
+		}
+
+		FrameStep step;
+		if (rule.cfa_reg != UnwindRule::CFA_NONE)
+		{
+			step = stepUnwindRule(rule, copy, copy_addr, copy_size, sizeof(PROFILER_ADDR), code, frame);
+			if (step == FRAME_STEPPED)
+				cfiFrames++;
+		}
+		else
+		{
+			step = stepFramePointer(copy, copy_addr, copy_size, sizeof(PROFILER_ADDR), code, frame);
+			if (step == FRAME_STEPPED || step == FRAME_OUTERMOST)
+				fpFrames++;
+		}
+
+		if (step == FRAME_OUTERMOST && stack.depth < MAX_CALLSTACK_LEVELS)
+			stack.addr[stack.depth++] = frame.ip;
+		if (step != FRAME_STEPPED)
+			return;
+	}
+}
+
+void CfiUnwinder::getStats(std::vector<std::string> &lines) const
+{
+	size_t usable = 0;
+	for (std::map<std::string, Module *>::const_iterator it = modules.begin(); it != modules.end(); ++it)
+		if (it->second->usable)
+			usable++;
+
+	char line[128];
+	snprintf(line, sizeof(line), "Frames unwound: %llu by CFI, %llu by frame pointer", cfiFrames, fpFrames);
+	lines.push_back(line);
+	snprintf(line, sizeof(line), "Modules with unwind tables: %u of %u", (unsigned)usable, (unsigned)modules.size());
+	lines.push_back(line);
+	snprintf(line, sizeof(line), "Unwind cache: %llu hits, %llu misses", cacheHits, cacheMisses);
+	lines.push_back(line);
+}
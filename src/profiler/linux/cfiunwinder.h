@@ -0,0 +1,90 @@
+/*=====================================================================
+cfiunwinder.h
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __CFIUNWINDER_H_666_
+#define __CFIUNWINDER_H_666_
+
+#include "../unwindcache.h"
+#include "cfitable.h"
+#include "elfimage.h"
+#include "procmaps.h"
+#include <map>
+#include <string>
+#include <vector>
+
+/*=====================================================================
+CfiUnwinder
+-----------
+Walks copied stacks of a Linux process, frame by frame, choosing for
+each the way its module allows: by its CfiTable where the module has
+.eh_frame covering the PC, as optimized distro libraries do, otherwise
+by the frame pointer. Nothing is read from the process while walking.
+
+Modules' tables are built the first time one of their PCs turns up,
+from the file the process mapped them from. The rule found for each PC
+is kept in an UnwindCache, so that the same return addresses, met over
+and over, are looked up only once.
+=====================================================================*/
+class CfiUnwinder
+{
+public:
+	CfiUnwinder();
+	~CfiUnwinder();
+
+	/// Files are opened through the process's root, in case it is in a container.
+	void setProcess(unsigned long process_id);
+
+	/// Walk from frame, a stopped thread's registers, reading memory from
+	/// copy, which holds copy_size bytes of stack from copy_addr on.
+	void walk(const ProcMaps &maps, StackFrame frame,
+			  const unsigned char *copy, PROFILER_ADDR copy_addr, size_t copy_size, CallStack &stack);
+
+	void getStats(std::vector<std::string> &lines) const;
+
+private:
+	struct Module
+	{
+		ElfImage image;
+		CfiTable table;
+		bool usable;
+	};
+
+	std::string root;
+	std::map<std::string, Module *> modules; // by path
+
+	/// Rules found by findRule, by PC, for the maps' current code generation.
+	UnwindCache cache;
+	unsigned cacheGeneration;
+
+	unsigned long long cfiFrames, fpFrames;
+	unsigned long long cacheHits, cacheMisses;
+
+	Module *getModule(const std::string &path);
+
+	/// The rule for pc from its module's table, or a CFA_NONE rule if it has none.
+	UnwindRule findRule(const ProcMaps &maps, PROFILER_ADDR pc);
+
+	CfiUnwinder(const CfiUnwinder &);
+	CfiUnwinder &operator=(const CfiUnwinder &);
+};
+
+#endif //__CFIUNWINDER_H_666_
@@ -0,0 +1,771 @@
+/*=====================================================================
+dwarfinlines.cpp
+----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "dwarfinlines.h"
+#include "dwarfreader.h"
+#include "elfimage.h"
+#include <algorithm>
+
+enum
+{
+	DW_TAG_inlined_subroutine = 0x1d, DW_TAG_compile_unit = 0x11, DW_TAG_partial_unit = 0x3c,
+
+	DW_AT_stmt_list = 0x10, DW_AT_low_pc = 0x11, DW_AT_high_pc = 0x12, DW_AT_name = 0x03,
+	DW_AT_abstract_origin = 0x31, DW_AT_specification = 0x47, DW_AT_ranges = 0x55,
+	DW_AT_call_file = 0x58, DW_AT_call_line = 0x59, DW_AT_linkage_name = 0x6e,
+	DW_AT_str_offsets_base = 0x72, DW_AT_addr_base = 0x73, DW_AT_rnglists_base = 0x74,
+	DW_AT_MIPS_linkage_name = 0x2007,
+
+	DW_FORM_addr = 0x01, DW_FORM_block2 = 0x03, DW_FORM_block4 = 0x04, DW_FORM_data2 = 0x05,
+	DW_FORM_data4 = 0x06, DW_FORM_data8 = 0x07, DW_FORM_string = 0x08, DW_FORM_block = 0x09,
+	DW_FORM_block1 = 0x0a, DW_FORM_data1 = 0x0b, DW_FORM_flag = 0x0c, DW_FORM_sdata = 0x0d,
+	DW_FORM_strp = 0x0e, DW_FORM_udata = 0x0f, DW_FORM_ref_addr = 0x10, DW_FORM_ref1 = 0x11,
+	DW_FORM_ref2 = 0x12, DW_FORM_ref4 = 0x13, DW_FORM_ref8 = 0x14, DW_FORM_ref_udata = 0x15,
+	DW_FORM_indirect = 0x16, DW_FORM_sec_offset = 0x17, DW_FORM_exprloc = 0x18,
+	DW_FORM_flag_present = 0x19, DW_FORM_strx = 0x1a, DW_FORM_addrx = 0x1b, DW_FORM_ref_sup4 = 0x1c,
+	DW_FORM_strp_sup = 0x1d, DW_FORM_data16 = 0x1e, DW_FORM_line_strp = 0x1f, DW_FORM_ref_sig8 = 0x20,
+	DW_FORM_implicit_const = 0x21, DW_FORM_loclistx = 0x22, DW_FORM_rnglistx = 0x23,
+	DW_FORM_ref_sup8 = 0x24, DW_FORM_strx1 = 0x25, DW_FORM_strx2 = 0x26, DW_FORM_strx3 = 0x27,
+	DW_FORM_strx4 = 0x28, DW_FORM_addrx1 = 0x29, DW_FORM_addrx2 = 0x2a, DW_FORM_addrx3 = 0x2b,
+	DW_FORM_addrx4 = 0x2c, DW_FORM_GNU_addr_index = 0x1f01, DW_FORM_GNU_str_index = 0x1f02,
+	DW_FORM_GNU_ref_alt = 0x1f20, DW_FORM_GNU_strp_alt = 0x1f21,
+
+	DW_UT_compile = 1, DW_UT_partial = 3,
+
+	DW_RLE_end_of_list = 0, DW_RLE_base_addressx, DW_RLE_startx_endx, DW_RLE_startx_length,
+	DW_RLE_offset_pair, DW_RLE_base_address, DW_RLE_start_end, DW_RLE_start_length
+};
+
+// An attribute as read, before anything it points to is looked up.
+struct Attr
+{
+	enum Kind
+	{
+		OTHER,		///< blocks, flags and so on; nothing we read
+		CONSTANT,	///< data and sec_offset forms
+		ADDRESS,
+		ADDRESS_INDEX,
+		STRING,
+		STRING_INDEX,
+		REFERENCE,	///< offset in .debug_info
+		RNGLIST_INDEX
+	};
+
+	unsigned long long name;
+	Kind kind;
+	unsigned long long value;
+	const char *string;
+};
+
+struct AttrSpec
+{
+	unsigned long long name, form;
+	long long implicit_const;
+};
+
+struct Abbrev
+{
+	unsigned long long tag; ///< 0 if the code wasn't defined
+	bool children;
+	std::vector<AttrSpec> attrs;
+};
+
+// A unit's header, and what its root entry says about the rest of it.
+struct Unit
+{
+	unsigned long long offset, end; ///< in .debug_info
+	unsigned long long dies;		///< offset of the root entry
+	unsigned version, address_size;
+	bool dwarf64;
+	const std::vector<Abbrev> *abbrevs; ///< by code
+
+	unsigned long long base; ///< the unit's DW_AT_low_pc, which ranges may be relative to
+	unsigned long long stmt_list;
+	unsigned long long str_offsets_base, addr_base, rnglists_base;
+};
+
+// The sections .debug_info needs, found once.
+struct InfoSections
+{
+	const unsigned char *info, *abbrev, *str, *line_str, *str_offsets, *addr, *ranges, *rnglists;
+	size_t info_size, abbrev_size, str_size, line_str_size, str_offsets_size, addr_size, ranges_size, rnglists_size;
+};
+
+// Walks .debug_info once, filling in a DwarfInlines.
+class InfoParser
+{
+public:
+	InfoParser(DwarfInlines &inlines_, const InfoSections &s_) : inlines(inlines_), s(s_) {}
+
+	void run();
+
+private:
+	DwarfInlines &inlines;
+	const InfoSections &s;
+
+	std::map<unsigned long long, std::vector<Abbrev> > abbrevTables; // by offset in .debug_abbrev
+	std::vector<Unit> units; // in order of offset
+	std::map<unsigned long long, unsigned> originNames; // by the offset of a call's abstract origin
+	std::map<std::string, unsigned> nameIndexes;
+
+	// A call's ranges, before they are flattened.
+	struct Piece
+	{
+		unsigned long long start, end;
+		unsigned call;
+		unsigned depth; ///< how many calls it is nested in
+	};
+	std::vector<Piece> pieces;
+
+	const std::vector<Abbrev> *getAbbrevs(unsigned long long offset);
+	bool readUnit(DwarfReader &r, Unit &unit);
+	const Unit *findUnit(unsigned long long offset) const;
+	bool readAttrs(DwarfReader &r, const Unit &unit, const Abbrev &abbrev, std::vector<Attr> &attrs) const;
+
+	const char *getString(const Unit &unit, const Attr &attr) const;
+	bool getAddress(const Unit &unit, const Attr &attr, unsigned long long &addr) const;
+	unsigned long long readOffset(const unsigned char *section, size_t size, unsigned long long offset, unsigned width) const;
+
+	void walkUnit(const Unit &unit);
+	void addCall(const Unit &unit, const std::vector<Attr> &attrs, unsigned parent, unsigned depth, unsigned &call);
+	void getRanges(const Unit &unit, const std::vector<Attr> &attrs, std::vector<std::pair<unsigned long long, unsigned long long> > &out) const;
+	void getRangeList(const Unit &unit, unsigned long long offset, std::vector<std::pair<unsigned long long, unsigned long long> > &out) const;
+	void getRngList(const Unit &unit, unsigned long long offset, std::vector<std::pair<unsigned long long, unsigned long long> > &out) const;
+	unsigned getOriginName(unsigned long long offset);
+	void flatten();
+};
+
+static const Attr *findAttr(const std::vector<Attr> &attrs, unsigned long long name)
+{
+	for (size_t i = 0; i < attrs.size(); i++)
+		if (attrs[i].name == name)
+			return &attrs[i];
+	return NULL;
+}
+
+const std::vector<Abbrev> *InfoParser::getAbbrevs(unsigned long long offset)
+{
+	std::map<unsigned long long, std::vector<Abbrev> >::iterator it = abbrevTables.find(offset);
+	if (it != abbrevTables.end())
+		return &it->second;
+
+	std::vector<Abbrev> &table = abbrevTables[offset];
+	if (offset >= s.abbrev_size)
+		return &table;
+
+	DwarfReader r(s.abbrev + offset, s.abbrev + s.abbrev_size);
+	for (;;)
+	{
+		unsigned long long code = r.uleb();
+		if (!r.ok || code == 0 || code > 0x100000)
+			break; // codes are numbered densely from 1 in practice
+
+		Abbrev abbrev;
+		abbrev.tag = r.uleb();
+		abbrev.children = r.u8() != 0;
+		for (;;)
+		{
+			AttrSpec spec;
+			spec.name = r.uleb();
+			spec.form = r.uleb();
+			spec.implicit_const = spec.form == DW_FORM_implicit_const ? r.sleb() : 0;
+			if (!r.ok || (spec.name == 0 && spec.form == 0))
+				break;
+			abbrev.attrs.push_back(spec);
+		}
+		if (!r.ok)
+			break;
+
+		if (table.size() <= code)
+		{
+			Abbrev undefined;
+			undefined.tag = 0;
+			undefined.children = false;
+			table.resize((size_t)code + 1, undefined);
+		}
+		table[(size_t)code] = abbrev;
+	}
+	return &table;
+}
+
+bool InfoParser::readAttrs(DwarfReader &r, const Unit &unit, const Abbrev &abbrev, std::vector<Attr> &attrs) const
+{
+	attrs.clear();
+	unsigned offset_size = unit.dwarf64 ? 8 : 4;
+
+	for (size_t i = 0; i < abbrev.attrs.size(); i++)
+	{
+		Attr attr;
+		attr.name = abbrev.attrs[i].name;
+		attr.kind = Attr::OTHER;
+		attr.value = 0;
+		attr.string = NULL;
+
+		unsigned long long form = abbrev.attrs[i].form;
+		while (form == DW_FORM_indirect && r.ok)
+			form = r.uleb();
+
+		switch (form)
+		{
+		case DW_FORM_addr:			attr.kind = Attr::ADDRESS; attr.value = r.fixed(unit.address_size); break;
+		case DW_FORM_data1:			attr.kind = Attr::CONSTANT; attr.value = r.fixed(1); break;
+		case DW_FORM_data2:			attr.kind = Attr::CONSTANT; attr.value = r.fixed(2); break;
+		case DW_FORM_data4:			attr.kind = Attr::CONSTANT; attr.value = r.fixed(4); break;
+		case DW_FORM_data8:			attr.kind = Attr::CONSTANT; attr.value = r.fixed(8); break;
+		case DW_FORM_sdata:			attr.kind = Attr::CONSTANT; attr.value = (unsigned long long)r.sleb(); break;
+		case DW_FORM_udata:			attr.kind = Attr::CONSTANT; attr.value = r.uleb(); break;
+		case DW_FORM_implicit_const: attr.kind = Attr::CONSTANT; attr.value = (unsigned long long)abbrev.attrs[i].implicit_const; break;
+		case DW_FORM_sec_offset:	attr.kind = Attr::CONSTANT; attr.value = r.fixed(offset_size); break;
+		case DW_FORM_data16:		r.skip(16); break;
+
+		case DW_FORM_flag:			r.skip(1); break;
+		case DW_FORM_flag_present:	break;
+		case DW_FORM_block1:		r.skip(r.fixed(1)); break;
+		case DW_FORM_block2:		r.skip(r.fixed(2)); break;
+		case DW_FORM_block4:		r.skip(r.fixed(4)); break;
+		case DW_FORM_block:
+		case DW_FORM_exprloc:		r.skip(r.uleb()); break;
+
+		case DW_FORM_string:		attr.kind = Attr::STRING; attr.string = r.str(); break;
+		case DW_FORM_strp:			attr.kind = Attr::STRING; attr.string = sectionString(s.str, s.str_size, r.fixed(offset_size)); break;
+		case DW_FORM_line_strp:		attr.kind = Attr::STRING; attr.string = sectionString(s.line_str, s.line_str_size, r.fixed(offset_size)); break;
+		case DW_FORM_strx:			attr.kind = Attr::STRING_INDEX; attr.value = r.uleb(); break;
+		case DW_FORM_strx1:			attr.kind = Attr::STRING_INDEX; attr.value = r.fixed(1); break;
+		case DW_FORM_strx2:			attr.kind = Attr::STRING_INDEX; attr.value = r.fixed(2); break;
+		case DW_FORM_strx3:			attr.kind = Attr::STRING_INDEX; attr.value = r.fixed(3); break;
+		case DW_FORM_strx4:			attr.kind = Attr::STRING_INDEX; attr.value = r.fixed(4); break;
+		// Strings and references in a supplementary (dwz) file.
+		case DW_FORM_strp_sup:
+		case DW_FORM_GNU_strp_alt:
+		case DW_FORM_GNU_ref_alt:	r.skip(offset_size); break;
+		case DW_FORM_ref_sup4:		r.skip(4); break;
+		case DW_FORM_ref_sup8:		r.skip(8); break;
+		// Split DWARF, whose entries live in .dwo files.
+		case DW_FORM_GNU_str_index:
+		case DW_FORM_GNU_addr_index: r.uleb(); break;
+
+		case DW_FORM_addrx:			attr.kind = Attr::ADDRESS_INDEX; attr.value = r.uleb(); break;
+		case DW_FORM_addrx1:		attr.kind = Attr::ADDRESS_INDEX; attr.value = r.fixed(1); break;
+		case DW_FORM_addrx2:		attr.kind = Attr::ADDRESS_INDEX; attr.value = r.fixed(2); break;
+		case DW_FORM_addrx3:		attr.kind = Attr::ADDRESS_INDEX; attr.value = r.fixed(3); break;
+		case DW_FORM_addrx4:		attr.kind = Attr::ADDRESS_INDEX; attr.value = r.fixed(4); break;
+
+		case DW_FORM_ref1:			attr.kind = Attr::REFERENCE; attr.value = unit.offset + r.fixed(1); break;
+		case DW_FORM_ref2:			attr.kind = Attr::REFERENCE; attr.value = unit.offset + r.fixed(2); break;
+		case DW_FORM_ref4:			attr.kind = Attr::REFERENCE; attr.value = unit.offset + r.fixed(4); break;
+		case DW_FORM_ref8:			attr.kind = Attr::REFERENCE; attr.value = unit.offset + r.fixed(8); break;
+		case DW_FORM_ref_udata:		attr.kind = Attr::REFERENCE; attr.value = unit.offset + r.uleb(); break;
+		case DW_FORM_ref_addr:
+			// Version 2 made these address-sized, by mistake.
+			attr.kind = Attr::REFERENCE;
+			attr.value = r.fixed(unit.version <= 2 ? unit.address_size : offset_size);
+			break;
+		case DW_FORM_ref_sig8:		r.skip(8); break;
+
+		case DW_FORM_loclistx:		r.uleb(); break;
+		case DW_FORM_rnglistx:		attr.kind = Attr::RNGLIST_INDEX; attr.value = r.uleb(); break;
+
+		default:
+			return false; // can't tell how big it is
+		}
+
+		if (attr.kind == Attr::STRING && !attr.string)
+			attr.kind = Attr::OTHER;
+		attrs.push_back(attr);
+	}
+	return r.ok;
+}
+
+unsigned long long InfoParser::readOffset(const unsigned char *section, size_t size, unsigned long long offset, unsigned width) const
+{
+	if (!section || offset > size || size - offset < width)
+		return ~0ULL;
+	DwarfReader r(section + offset, section + size);
+	return r.fixed(width);
+}
+
+const char *InfoParser::getString(const Unit &unit, const Attr &attr) const
+{
+	if (attr.kind == Attr::STRING)
+		return attr.string;
+	if (attr.kind != Attr::STRING_INDEX)
+		return NULL;
+
+	unsigned width = unit.dwarf64 ? 8 : 4;
+	unsigned long long offset = readOffset(s.str_offsets, s.str_offsets_size, unit.str_offsets_base + attr.value * width, width);
+	return sectionString(s.str, s.str_size, offset);
+}
+
+bool InfoParser::getAddress(const Unit &unit, const Attr &attr, unsigned long long &addr) const
+{
+	if (attr.kind == Attr::ADDRESS)
+	{
+		addr = attr.value;
+		return true;
+	}
+	if (attr.kind != Attr::ADDRESS_INDEX)
+		return false;
+
+	addr = readOffset(s.addr, s.addr_size, unit.addr_base + attr.value * unit.address_size, unit.address_size);
+	return addr != ~0ULL;
+}
+
+bool InfoParser::readUnit(DwarfReader &r, Unit &unit)
+{
+	unit.offset = r.p - s.info;
+	unsigned long long length = r.u32();
+	unit.dwarf64 = length == 0xFFFFFFFF;
+	if (unit.dwarf64)
+		length = r.fixed(8);
+	if (!r.ok || length > (unsigned long long)(r.end - r.p))
+	{
+		r.skip(r.end - r.p);
+		return false;
+	}
+
+	DwarfReader header(r.p, r.p + length);
+	r.skip(length);
+	unit.end = r.p - s.info;
+
+	unit.version = header.u16();
+	if (unit.version < 2 || unit.version > 5)
+		return false;
+
+	unsigned long long abbrev_offset;
+	if (unit.version >= 5)
+	{
+		// Type units and split units hold no code of their own.
+		unsigned type = header.u8();
+		if (type != DW_UT_compile && type != DW_UT_partial)
+			return false;
+		unit.address_size = header.u8();
+		abbrev_offset = header.fixed(unit.dwarf64 ? 8 : 4);
+	}
+	else
+	{
+		abbrev_offset = header.fixed(unit.dwarf64 ? 8 : 4);
+		unit.address_size = header.u8();
+	}
+	if (!header.ok || unit.address_size == 0 || unit.address_size > 8)
+		return false;
+
+	unit.dies = header.p - s.info;
+	unit.abbrevs = getAbbrevs(abbrev_offset);
+
+	// The root entry says where the unit's strings, addresses and range
+	// lists start, which its own attributes may already need.
+	unit.base = 0;
+	unit.stmt_list = ~0ULL;
+	unit.str_offsets_base = unit.addr_base = unit.dwarf64 ? 16 : 8;
+	unit.rnglists_base = 0;
+
+	unsigned long long code = header.uleb();
+	if (!header.ok || code >= unit.abbrevs->size())
+		return false;
+	const Abbrev &abbrev = (*unit.abbrevs)[(size_t)code];
+	if (abbrev.tag != DW_TAG_compile_unit && abbrev.tag != DW_TAG_partial_unit)
+		return false;
+
+	std::vector<Attr> attrs;
+	if (!readAttrs(header, unit, abbrev, attrs))
+		return false;
+
+	if (const Attr *attr = findAttr(attrs, DW_AT_str_offsets_base))
+		unit.str_offsets_base = attr->value;
+	if (const Attr *attr = findAttr(attrs, DW_AT_addr_base))
+		unit.addr_base = attr->value;
+	if (const Attr *attr = findAttr(attrs, DW_AT_rnglists_base))
+		unit.rnglists_base = attr->value;
+	if (const Attr *attr = findAttr(attrs, DW_AT_stmt_list))
+		unit.stmt_list = attr->value;
+	if (const Attr *attr = findAttr(attrs, DW_AT_low_pc))
+		getAddress(unit, *attr, unit.base);
+	return true;
+}
+
+const Unit *InfoParser::findUnit(unsigned long long offset) const
+{
+	size_t lo = 0, hi = units.size();
+	while (lo < hi)
+	{
+		size_t mid = (lo + hi) / 2;
+		if (units[mid].end <= offset)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == units.size() || offset < units[lo].dies)
+		return NULL;
+	return &units[lo];
+}
+
+void InfoParser::getRangeList(const Unit &unit, unsigned long long offset, std::vector<std::pair<unsigned long long, unsigned long long> > &out) const
+{
+	// Before version 5: pairs of addresses relative to a base, which
+	// starts as the unit's and may be changed by an entry of all ones.
+	if (!s.ranges || offset >= s.ranges_size)
+		return;
+	unsigned long long all_ones = unit.address_size == 8 ? ~0ULL : (1ULL << (8 * unit.address_size)) - 1;
+	unsigned long long base = unit.base;
+
+	DwarfReader r(s.ranges + offset, s.ranges + s.ranges_size);
+	while (r.more())
+	{
+		unsigned long long start = r.fixed(unit.address_size);
+		unsigned long long end = r.fixed(unit.address_size);
+		if (!r.ok || (start == 0 && end == 0))
+			break;
+		if (start == all_ones)
+			base = end;
+		else
+			out.push_back(std::make_pair(base + start, base + end));
+	}
+}
+
+void InfoParser::getRngList(const Unit &unit, unsigned long long offset, std::vector<std::pair<unsigned long long, unsigned long long> > &out) const
+{
+	if (!s.rnglists || offset >= s.rnglists_size)
+		return;
+	unsigned long long base = unit.base;
+
+	DwarfReader r(s.rnglists + offset, s.rnglists + s.rnglists_size);
+	while (r.more())
+	{
+		unsigned long long start = 0, end = 0;
+		Attr index;
+		index.kind = Attr::ADDRESS_INDEX;
+
+		switch (r.u8())
+		{
+		case DW_RLE_end_of_list:
+			return;
+		case DW_RLE_base_addressx:
+			index.value = r.uleb();
+			getAddress(unit, index, base);
+			continue;
+		case DW_RLE_startx_endx:
+			index.value = r.uleb();
+			getAddress(unit, index, start);
+			index.value = r.uleb();
+			getAddress(unit, index, end);
+			break;
+		case DW_RLE_startx_length:
+			index.value = r.uleb();
+			getAddress(unit, index, start);
+			end = start + r.uleb();
+			break;
+		case DW_RLE_offset_pair:
+			start = base + r.uleb();
+			end = base + r.uleb();
+			break;
+		case DW_RLE_base_address:
+			base = r.fixed(unit.address_size);
+			continue;
+		case DW_RLE_start_end:
+			start = r.fixed(unit.address_size);
+			end = r.fixed(unit.address_size);
+			break;
+		case DW_RLE_start_length:
+			start = r.fixed(unit.address_size);
+			end = start + r.uleb();
+			break;
+		default:
+			return;
+		}
+		if (r.ok)
+			out.push_back(std::make_pair(start, end));
+	}
+}
+
+void InfoParser::getRanges(const Unit &unit, const std::vector<Attr> &attrs, std::vector<std::pair<unsigned long long, unsigned long long> > &out) const
+{
+	out.clear();
+
+	const Attr *ranges = findAttr(attrs, DW_AT_ranges);
+	if (ranges)
+	{
+		if (ranges->kind == Attr::RNGLIST_INDEX)
+		{
+			// An index into the offsets that follow the unit's list header.
+			unsigned width = unit.dwarf64 ? 8 : 4;
+			unsigned long long offset = readOffset(s.rnglists, s.rnglists_size, unit.rnglists_base + ranges->value * width, width);
+			if (offset != ~0ULL)
+				getRngList(unit, unit.rnglists_base + offset, out);
+		}
+		else if (ranges->kind == Attr::CONSTANT)
+		{
+			if (unit.version >= 5)
+				getRngList(unit, ranges->value, out);
+			else
+				getRangeList(unit, ranges->value, out);
+		}
+		return;
+	}
+
+	const Attr *low = findAttr(attrs, DW_AT_low_pc);
+	const Attr *high = findAttr(attrs, DW_AT_high_pc);
+	unsigned long long start, end;
+	if (!low || !high || !getAddress(unit, *low, start))
+		return;
+
+	// Since version 4, high_pc may be a length instead of an address.
+	if (high->kind == Attr::CONSTANT)
+		end = start + high->value;
+	else if (!getAddress(unit, *high, end))
+		return;
+	out.push_back(std::make_pair(start, end));
+}
+
+unsigned InfoParser::getOriginName(unsigned long long offset)
+{
+	std::map<unsigned long long, unsigned>::iterator cached = originNames.find(offset);
+	if (cached != originNames.end())
+		return cached->second;
+
+	// The abstract origin may only have a plain name, leaving the linkage
+	// name to the declaration it specifies, in its class; follow the chain.
+	std::string linkage, plain;
+	std::vector<Attr> attrs;
+	unsigned long long die = offset;
+	for (int hops = 0; hops < 8 && linkage.empty(); hops++)
+	{
+		const Unit *unit = findUnit(die);
+		if (!unit)
+			break;
+
+		DwarfReader r(s.info + die, s.info + unit->end);
+		unsigned long long code = r.uleb();
+		if (!r.ok || code == 0 || code >= unit->abbrevs->size() || !readAttrs(r, *unit, (*unit->abbrevs)[(size_t)code], attrs))
+			break;
+
+		const Attr *attr = findAttr(attrs, DW_AT_linkage_name);
+		if (!attr)
+			attr = findAttr(attrs, DW_AT_MIPS_linkage_name);
+		if (const char *name = attr ? getString(*unit, *attr) : NULL)
+			linkage = name;
+
+		attr = findAttr(attrs, DW_AT_name);
+		if (const char *name = attr && plain.empty() ? getString(*unit, *attr) : NULL)
+			plain = name;
+
+		attr = findAttr(attrs, DW_AT_abstract_origin);
+		if (!attr)
+			attr = findAttr(attrs, DW_AT_specification);
+		if (!attr || attr->kind != Attr::REFERENCE)
+			break;
+		die = attr->value;
+	}
+
+	const std::string &name = linkage.empty() ? plain : linkage;
+	std::map<std::string, unsigned>::iterator it = nameIndexes.find(name);
+	unsigned index;
+	if (it != nameIndexes.end())
+	{
+		index = it->second;
+	}
+	else
+	{
+		index = (unsigned)inlines.names.size();
+		inlines.names.push_back(name);
+		nameIndexes[name] = index;
+	}
+	originNames[offset] = index;
+	return index;
+}
+
+void InfoParser::addCall(const Unit &unit, const std::vector<Attr> &attrs, unsigned parent, unsigned depth, unsigned &call)
+{
+	// Calls in abstract instances, and those the linker threw away,
+	// have no code of their own.
+	std::vector<std::pair<unsigned long long, unsigned long long> > ranges;
+	getRanges(unit, attrs, ranges);
+	size_t first_piece = pieces.size();
+	for (size_t i = 0; i < ranges.size(); i++)
+	{
+		if (ranges[i].first == 0 || ranges[i].first >= ranges[i].second)
+			continue;
+		Piece piece = { ranges[i].first, ranges[i].second, (unsigned)inlines.calls.size(), depth };
+		pieces.push_back(piece);
+	}
+	if (pieces.size() == first_piece)
+		return;
+
+	DwarfInlines::Call c;
+	const Attr *origin = findAttr(attrs, DW_AT_abstract_origin);
+	c.name = getOriginName(origin && origin->kind == Attr::REFERENCE ? origin->value : ~0ULL);
+	c.parent = parent;
+	c.unit = unit.stmt_list;
+	const Attr *file = findAttr(attrs, DW_AT_call_file);
+	const Attr *line = findAttr(attrs, DW_AT_call_line);
+	c.file = file && file->kind == Attr::CONSTANT ? (unsigned)file->value : 0;
+	c.line = line && line->kind == Attr::CONSTANT ? (unsigned)line->value : 0;
+
+	call = (unsigned)inlines.calls.size();
+	inlines.calls.push_back(c);
+}
+
+void InfoParser::walkUnit(const Unit &unit)
+{
+	// For each entry whose children we're in: the innermost call that
+	// encloses them, and how deeply that is nested.
+	std::vector<std::pair<unsigned, unsigned> > open;
+	std::vector<Attr> attrs;
+
+	DwarfReader r(s.info + unit.dies, s.info + unit.end);
+	while (r.more())
+	{
+		unsigned long long code = r.uleb();
+		if (code == 0)
+		{
+			// The end of a list of children.
+			if (open.empty())
+				break;
+			open.pop_back();
+			continue;
+		}
+		if (code >= unit.abbrevs->size())
+			break;
+		const Abbrev &abbrev = (*unit.abbrevs)[(size_t)code];
+		if (abbrev.tag == 0 || !readAttrs(r, unit, abbrev, attrs))
+			break;
+
+		unsigned call = open.empty() ? (unsigned)DwarfInlines::NONE : open.back().first;
+		unsigned depth = open.empty() ? 0 : open.back().second;
+		if (abbrev.tag == DW_TAG_inlined_subroutine)
+		{
+			unsigned parent = call;
+			addCall(unit, attrs, parent, depth, call);
+			if (call != parent)
+				depth++;
+		}
+
+		if (abbrev.children)
+			open.push_back(std::make_pair(call, depth));
+	}
+}
+
+void InfoParser::flatten()
+{
+	// Sorted by start, and where calls start together, the outer first.
+	struct PieceBefore
+	{
+		bool operator()(const Piece &a, const Piece &b) const
+		{
+			if (a.start != b.start)
+				return a.start < b.start;
+			return a.depth < b.depth;
+		}
+	};
+	std::sort(pieces.begin(), pieces.end(), PieceBefore());
+
+	// Sweep through them keeping a stack of the calls in force: each
+	// nests within the one below it, so the top one is the innermost.
+	std::vector<DwarfInlines::Range> &ranges = inlines.ranges;
+	std::vector<const Piece *> stack;
+	for (size_t i = 0; i <= pieces.size(); i++)
+	{
+		unsigned long long start = i < pieces.size() ? pieces[i].start : ~0ULL;
+
+		while (!stack.empty() && stack.back()->end <= start)
+		{
+			unsigned long long end = stack.back()->end;
+			stack.pop_back();
+			// A call that overran the one it was inlined into ends with it.
+			while (!stack.empty() && stack.back()->end <= end)
+				stack.pop_back();
+
+			DwarfInlines::Range range = { end, stack.empty() ? (unsigned)DwarfInlines::NONE : stack.back()->call };
+			ranges.push_back(range);
+		}
+		if (i == pieces.size())
+			break;
+
+		stack.push_back(&pieces[i]);
+		DwarfInlines::Range range = { start, pieces[i].call };
+		ranges.push_back(range);
+	}
+
+	// Where several ranges start at one address, the last is in force.
+	size_t out = 0;
+	for (size_t i = 0; i < ranges.size(); i++)
+	{
+		if (out > 0 && ranges[out - 1].addr == ranges[i].addr)
+			out--;
+		ranges[out++] = ranges[i];
+	}
+	ranges.resize(out);
+	std::vector<DwarfInlines::Range>(ranges).swap(ranges);
+	std::vector<Piece>().swap(pieces);
+}
+
+void InfoParser::run()
+{
+	DwarfReader r(s.info, s.info + s.info_size);
+	while (r.more())
+	{
+		Unit unit;
+		if (readUnit(r, unit))
+			units.push_back(unit);
+	}
+
+	for (size_t i = 0; i < units.size(); i++)
+		walkUnit(units[i]);
+
+	flatten();
+}
+
+DwarfInlines::DwarfInlines()
+{
+}
+
+bool DwarfInlines::build(const ElfImage &image)
+{
+	ranges.clear();
+	calls.clear();
+	names.clear();
+
+	InfoSections s;
+	s.info = image.findSection(".debug_info", s.info_size);
+	s.abbrev = image.findSection(".debug_abbrev", s.abbrev_size);
+	if (!s.info || !s.abbrev)
+		return false;
+	s.str = image.findSection(".debug_str", s.str_size);
+	s.line_str = image.findSection(".debug_line_str", s.line_str_size);
+	s.str_offsets = image.findSection(".debug_str_offsets", s.str_offsets_size);
+	s.addr = image.findSection(".debug_addr", s.addr_size);
+	s.ranges = image.findSection(".debug_ranges", s.ranges_size);
+	s.rnglists = image.findSection(".debug_rnglists", s.rnglists_size);
+
+	InfoParser parser(*this, s);
+	parser.run();
+
+	std::vector<Call>(calls).swap(calls);
+	return !calls.empty();
+}
+
+const DwarfInlines::Call *DwarfInlines::find(unsigned long long addr) const
+{
+	std::vector<Range>::const_iterator it = std::upper_bound(ranges.begin(), ranges.end(), addr, addrBefore);
+	if (it == ranges.begin())
+		return NULL;
+	--it;
+	return it->call == NONE ? NULL : &calls[it->call];
+}
@@ -0,0 +1,93 @@
+/*=====================================================================
+dwarfinlines.h
+--------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __DWARFINLINES_H_666_
+#define __DWARFINLINES_H_666_
+
+#include <stddef.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class ElfImage;
+
+/*=====================================================================
+DwarfInlines
+------------
+Where the compiler inlined one function into another, as the
+DW_TAG_inlined_subroutine entries of a module's .debug_info record it:
+for any address, the chain of inlined calls its code came from.
+
+The entries are read once, and flattened into a table of address
+ranges sorted by address, each giving the innermost call that covers
+it; each call points to the one it was itself inlined into. Calls
+give the file they were made from by its number in the unit's line
+program, which DwarfLines::getUnitFile turns into a path.
+Versions 2 to 5 of the format are understood.
+=====================================================================*/
+class DwarfInlines
+{
+public:
+	enum { NONE = ~0u };
+
+	struct Call
+	{
+		unsigned name;				///< index into names
+		unsigned parent;			///< the call this one was inlined into, or NONE
+		unsigned long long unit;	///< the unit's line program (DW_AT_stmt_list)
+		unsigned file, line;		///< where the call was made, in the caller
+	};
+
+	DwarfInlines();
+
+	/// Read image's .debug_info. Returns false if nothing in it was inlined.
+	bool build(const ElfImage &image);
+
+	/// The innermost call inlined at addr (an address in the image),
+	/// or NULL if the code there wasn't inlined.
+	const Call *find(unsigned long long addr) const;
+
+	const Call *getParent(const Call &call) const { return call.parent == NONE ? NULL : &calls[call.parent]; }
+
+	/// The called function's linkage (mangled) name where it has one,
+	/// otherwise its plain name. Empty if it has neither.
+	const std::string &getName(const Call &call) const { return names[call.name]; }
+
+	size_t getNumCalls() const { return calls.size(); }
+
+private:
+	struct Range
+	{
+		unsigned long long addr;
+		unsigned call; ///< NONE between calls
+	};
+
+	std::vector<Range> ranges;
+	std::vector<Call> calls;
+	std::vector<std::string> names;
+
+	static bool addrBefore(unsigned long long addr, const Range &range) { return addr < range.addr; }
+
+	friend class InfoParser;
+};
+
+#endif //__DWARFINLINES_H_666_
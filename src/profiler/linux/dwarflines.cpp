@@ -0,0 +1,404 @@
+/*=====================================================================
+dwarflines.cpp
+--------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "dwarflines.h"
+#include "dwarfreader.h"
+#include "elfimage.h"
+#include <algorithm>
+
+enum
+{
+	DW_LNS_copy = 1, DW_LNS_advance_pc, DW_LNS_advance_line, DW_LNS_set_file,
+	DW_LNS_set_column, DW_LNS_negate_stmt, DW_LNS_set_basic_block, DW_LNS_const_add_pc,
+	DW_LNS_fixed_advance_pc, DW_LNS_set_prologue_end, DW_LNS_set_epilogue_begin, DW_LNS_set_isa,
+
+	DW_LNE_end_sequence = 1, DW_LNE_set_address, DW_LNE_define_file,
+
+	DW_LNCT_path = 1, DW_LNCT_directory_index,
+
+	DW_FORM_block = 0x09, DW_FORM_data1 = 0x0b, DW_FORM_data2 = 0x05, DW_FORM_data4 = 0x06,
+	DW_FORM_data8 = 0x07, DW_FORM_data16 = 0x1e, DW_FORM_string = 0x08, DW_FORM_strp = 0x0e,
+	DW_FORM_udata = 0x0f, DW_FORM_line_strp = 0x1f
+};
+
+// One unit's line number program: its header, then the state machine.
+class LineProgram
+{
+public:
+	LineProgram(DwarfLines &lines_, const StringSections &strings_) : lines(lines_), strings(strings_) {}
+
+	/// Reads the unit at r, which is at offset in .debug_line, leaving r
+	/// after it. Returns false if the unit can't be read; r is still left
+	/// after it if its length is sane.
+	bool run(DwarfReader &r, unsigned long long offset);
+
+private:
+	DwarfLines &lines;
+	const StringSections &strings;
+
+	bool dwarf64;
+	unsigned version, address_size;
+	unsigned min_inst_length, line_range, opcode_base;
+	int line_base;
+	std::vector<unsigned> standard_lengths;
+	std::vector<std::string> dirs;
+	std::vector<unsigned> fileIndexes; ///< by the unit's file number, into lines.files
+
+	bool readV4Tables(DwarfReader &r);
+	bool readV5Tables(DwarfReader &r);
+	bool readV5Entries(DwarfReader &r, bool are_files);
+	void addFile(const std::string &name, unsigned long long dir);
+	bool runProgram(DwarfReader &r);
+};
+
+bool LineProgram::run(DwarfReader &r, unsigned long long offset)
+{
+	unsigned long long length = r.u32();
+	dwarf64 = length == 0xFFFFFFFF;
+	if (dwarf64)
+		length = r.fixed(8);
+	if (!r.ok || length > (unsigned long long)(r.end - r.p))
+	{
+		r.skip(r.end - r.p);
+		return false;
+	}
+
+	DwarfReader unit(r.p, r.p + length);
+	r.skip(length);
+
+	version = unit.u16();
+	if (version < 2 || version > 5)
+		return false;
+	address_size = sizeof(void *);
+	if (version >= 5)
+	{
+		address_size = unit.u8();
+		unit.u8(); // segment selector size
+	}
+
+	unsigned long long header_length = unit.fixed(dwarf64 ? 8 : 4);
+	if (!unit.ok || header_length > (unsigned long long)(unit.end - unit.p))
+		return false;
+	DwarfReader program(unit.p + header_length, unit.end);
+
+	min_inst_length = unit.u8();
+	if (version >= 4)
+		unit.u8(); // maximum operations per instruction; only for VLIW
+	unit.u8(); // default_is_stmt
+	line_base = (signed char)unit.u8();
+	line_range = unit.u8();
+	opcode_base = unit.u8();
+	if (!unit.ok || line_range == 0 || opcode_base == 0)
+		return false;
+
+	standard_lengths.clear();
+	for (unsigned i = 1; i < opcode_base; i++)
+		standard_lengths.push_back(unit.u8());
+
+	dirs.clear();
+	fileIndexes.clear();
+	if (!(version >= 5 ? readV5Tables(unit) : readV4Tables(unit)))
+		return false;
+
+	// .debug_info refers to files by the unit's numbers (DW_AT_call_file),
+	// including any the program defines as it goes.
+	bool ok = runProgram(program);
+	lines.unitFiles[offset].swap(fileIndexes);
+	return ok;
+}
+
+bool LineProgram::readV4Tables(DwarfReader &r)
+{
+	// Directory 0 is the compilation directory, which only .debug_info knows.
+	dirs.push_back("");
+	for (;;)
+	{
+		const char *dir = r.str();
+		if (!r.ok || !*dir)
+			break;
+		dirs.push_back(dir);
+	}
+
+	// Files are numbered from 1.
+	fileIndexes.push_back(DwarfLines::NO_FILE);
+	for (;;)
+	{
+		const char *name = r.str();
+		if (!r.ok || !*name)
+			break;
+		unsigned long long dir = r.uleb();
+		r.uleb(); // modification time
+		r.uleb(); // length
+		addFile(name, dir);
+	}
+	return r.ok;
+}
+
+bool LineProgram::readV5Tables(DwarfReader &r)
+{
+	return readV5Entries(r, false) && readV5Entries(r, true);
+}
+
+bool LineProgram::readV5Entries(DwarfReader &r, bool are_files)
+{
+	std::vector<std::pair<unsigned long long, unsigned long long> > formats; // content type, form
+	unsigned num_formats = r.u8();
+	for (unsigned i = 0; i < num_formats; i++)
+	{
+		unsigned long long type = r.uleb();
+		unsigned long long form = r.uleb();
+		formats.push_back(std::make_pair(type, form));
+	}
+
+	unsigned long long count = r.uleb();
+	for (unsigned long long n = 0; n < count && r.ok; n++)
+	{
+		const char *path = "";
+		unsigned long long dir = 0;
+		for (size_t i = 0; i < formats.size(); i++)
+		{
+			unsigned long long value = 0;
+			const char *s = NULL;
+			switch (formats[i].second)
+			{
+			case DW_FORM_string:	s = r.str(); break;
+			case DW_FORM_line_strp:	s = sectionString(strings.line_str, strings.line_str_size, r.fixed(dwarf64 ? 8 : 4)); break;
+			case DW_FORM_strp:		s = sectionString(strings.str, strings.str_size, r.fixed(dwarf64 ? 8 : 4)); break;
+			case DW_FORM_udata:		value = r.uleb(); break;
+			case DW_FORM_data1:		value = r.fixed(1); break;
+			case DW_FORM_data2:		value = r.fixed(2); break;
+			case DW_FORM_data4:		value = r.fixed(4); break;
+			case DW_FORM_data8:		value = r.fixed(8); break;
+			case DW_FORM_data16:	r.skip(16); break;
+			case DW_FORM_block:		r.skip(r.uleb()); break;
+			default:
+				return false; // can't tell how big it is
+			}
+
+			if (formats[i].first == DW_LNCT_path)
+				path = s ? s : "";
+			else if (formats[i].first == DW_LNCT_directory_index)
+				dir = value;
+		}
+
+		if (are_files)
+			addFile(path, dir);
+		else
+			dirs.push_back(path);
+	}
+	return r.ok;
+}
+
+void LineProgram::addFile(const std::string &name, unsigned long long dir)
+{
+	// Relative names are relative to their directory, and relative
+	// directories to directory 0, the compilation directory.
+	std::string path = name;
+	if (!path.empty() && path[0] != '/' && dir < dirs.size() && !dirs[(size_t)dir].empty())
+		path = dirs[(size_t)dir] + "/" + path;
+	if (!path.empty() && path[0] != '/' && dir != 0 && !dirs[0].empty())
+		path = dirs[0] + "/" + path;
+	fileIndexes.push_back(lines.addFile(path));
+}
+
+bool LineProgram::runProgram(DwarfReader &r)
+{
+	// The state machine's registers, as far as we need them.
+	unsigned long long address = 0;
+	unsigned long long file = 1;
+	long long line = 1;
+
+	std::vector<DwarfLines::Row> &rows = lines.rows;
+	size_t sequence_start = rows.size();
+
+	while (r.more())
+	{
+		bool emit = false;
+		unsigned opcode = r.u8();
+
+		if (opcode >= opcode_base)
+		{
+			unsigned adjusted = opcode - opcode_base;
+			address += (unsigned long long)(adjusted / line_range) * min_inst_length;
+			line += line_base + (int)(adjusted % line_range);
+			emit = true;
+		}
+		else if (opcode == 0)
+		{
+			unsigned long long length = r.uleb();
+			if (length == 0 || length > (unsigned long long)(r.end - r.p))
+				return false;
+			DwarfReader ext(r.p, r.p + length);
+			r.skip(length);
+
+			switch (ext.u8())
+			{
+			case DW_LNE_end_sequence:
+			{
+				// Rows at the very end cover nothing.
+				while (rows.size() > sequence_start && rows.back().addr >= address)
+					rows.pop_back();
+
+				DwarfLines::Row end = { address, DwarfLines::NO_FILE, 0 };
+				rows.push_back(end);
+
+				// A sequence the linker threw away (its function was
+				// discarded) starts again from address 0; drop it.
+				if (rows[sequence_start].addr == 0)
+					rows.resize(sequence_start);
+				sequence_start = rows.size();
+
+				address = 0;
+				file = 1;
+				line = 1;
+				break;
+			}
+			case DW_LNE_set_address:
+				address = ext.fixed(length - 1 < 8 ? (size_t)(length - 1) : 8);
+				break;
+			case DW_LNE_define_file:
+			{
+				const char *name = ext.str();
+				unsigned long long dir = ext.uleb();
+				addFile(name, dir);
+				break;
+			}
+			default:
+				break; // set_discriminator and vendor extensions
+			}
+		}
+		else
+		{
+			switch (opcode)
+			{
+			case DW_LNS_copy:				emit = true; break;
+			case DW_LNS_advance_pc:			address += r.uleb() * min_inst_length; break;
+			case DW_LNS_advance_line:		line += r.sleb(); break;
+			case DW_LNS_set_file:			file = r.uleb(); break;
+			case DW_LNS_const_add_pc:		address += (unsigned long long)((255 - opcode_base) / line_range) * min_inst_length; break;
+			case DW_LNS_fixed_advance_pc:	address += r.u16(); break;
+			default:
+				// Operands we don't need, or of opcodes newer than us; the
+				// header says how many there are.
+				for (unsigned i = 0; i < standard_lengths[opcode - 1]; i++)
+					r.uleb();
+				break;
+			}
+		}
+
+		if (emit)
+		{
+			DwarfLines::Row row;
+			row.addr = address;
+			row.file = file < fileIndexes.size() ? fileIndexes[(size_t)file] : DwarfLines::NO_FILE;
+			row.line = line > 0 ? (unsigned)line : 0;
+			rows.push_back(row);
+		}
+	}
+
+	// Rows of an unfinished sequence have nothing to end them.
+	rows.resize(sequence_start);
+	return r.ok;
+}
+
+DwarfLines::DwarfLines()
+{
+}
+
+unsigned DwarfLines::addFile(const std::string &path)
+{
+	std::map<std::string, unsigned>::iterator it = fileIndexes.find(path);
+	if (it != fileIndexes.end())
+		return it->second;
+
+	unsigned index = (unsigned)files.size();
+	files.push_back(path);
+	fileIndexes[path] = index;
+	return index;
+}
+
+bool DwarfLines::rowBefore(const Row &a, const Row &b)
+{
+	// Where sequences meet, the end of one comes before the start of the next.
+	if (a.addr != b.addr)
+		return a.addr < b.addr;
+	return (a.file == NO_FILE) > (b.file == NO_FILE);
+}
+
+bool DwarfLines::build(const ElfImage &image)
+{
+	rows.clear();
+	files.clear();
+	fileIndexes.clear();
+	unitFiles.clear();
+
+	size_t size;
+	const unsigned char *section = image.findSection(".debug_line", size);
+	if (!section)
+		return false;
+
+	StringSections strings;
+	strings.str = image.findSection(".debug_str", strings.str_size);
+	strings.line_str = image.findSection(".debug_line_str", strings.line_str_size);
+
+	DwarfReader r(section, section + size);
+	while (r.more())
+	{
+		LineProgram program(*this, strings);
+		program.run(r, r.p - section);
+	}
+
+	// Several rows at one address leave the last in force.
+	std::stable_sort(rows.begin(), rows.end(), rowBefore);
+	size_t out = 0;
+	for (size_t i = 0; i < rows.size(); i++)
+	{
+		if (out > 0 && rows[out - 1].addr == rows[i].addr)
+			out--;
+		rows[out++] = rows[i];
+	}
+	rows.resize(out);
+	std::vector<Row>(rows).swap(rows);
+
+	return !rows.empty();
+}
+
+bool DwarfLines::find(unsigned long long addr, std::string &file, unsigned &line) const
+{
+	std::vector<Row>::const_iterator it = std::upper_bound(rows.begin(), rows.end(), addr, addrBefore);
+	if (it == rows.begin())
+		return false;
+	--it;
+	if (it->file == NO_FILE || it->line == 0)
+		return false;
+
+	file = files[it->file];
+	line = it->line;
+	return true;
+}
+
+const std::string *DwarfLines::getUnitFile(unsigned long long unit, unsigned long long file) const
+{
+	std::map<unsigned long long, std::vector<unsigned> >::const_iterator it = unitFiles.find(unit);
+	if (it == unitFiles.end() || file >= it->second.size() || it->second[(size_t)file] == NO_FILE)
+		return NULL;
+	return &files[it->second[(size_t)file]];
+}
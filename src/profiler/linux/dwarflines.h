@@ -0,0 +1,83 @@
+/*=====================================================================
+dwarflines.h
+------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __DWARFLINES_H_666_
+#define __DWARFLINES_H_666_
+
+#include <stddef.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class ElfImage;
+
+/*=====================================================================
+DwarfLines
+----------
+A module's DWARF line number programs (.debug_line), run once and kept
+as a table of the source line at each address.
+
+Rows are sorted by address; each applies up to the next. The ends of
+sequences are kept as rows with no line, so that gaps between them
+don't take the line before. File names are shared by all the rows
+that use them. Versions 2 to 5 of the format are understood.
+=====================================================================*/
+class DwarfLines
+{
+public:
+	DwarfLines();
+
+	/// Run image's .debug_line. Returns false if it has none we can use.
+	bool build(const ElfImage &image);
+
+	/// The source file and line for addr, an address in the image.
+	bool find(unsigned long long addr, std::string &file, unsigned &line) const;
+
+	/// The path of file number file in the unit whose line program is at
+	/// offset unit in .debug_line (its DW_AT_stmt_list), or NULL.
+	const std::string *getUnitFile(unsigned long long unit, unsigned long long file) const;
+
+	size_t getNumRows() const { return rows.size(); }
+
+private:
+	struct Row
+	{
+		unsigned long long addr;
+		unsigned file; ///< index into files, or NO_FILE at the end of a sequence
+		unsigned line;
+	};
+	enum { NO_FILE = ~0u };
+
+	std::vector<Row> rows;
+	std::vector<std::string> files;
+	std::map<std::string, unsigned> fileIndexes;
+	std::map<unsigned long long, std::vector<unsigned> > unitFiles; ///< by offset, each unit's file numbers into files
+
+	unsigned addFile(const std::string &path);
+
+	static bool addrBefore(unsigned long long addr, const Row &row) { return addr < row.addr; }
+	static bool rowBefore(const Row &a, const Row &b);
+
+	friend class LineProgram;
+};
+
+#endif //__DWARFLINES_H_666_
@@ -0,0 +1,139 @@
+/*=====================================================================
+dwarfreader.h
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __DWARFREADER_H_666_
+#define __DWARFREADER_H_666_
+
+#include <stddef.h>
+#include <string.h>
+
+/*=====================================================================
+DwarfReader
+-----------
+Reads the little-endian, variable-length encodings DWARF uses, from
+p up to end. Reads past the end set ok to false, and return zeroes,
+so a parser can check once at the end of a record rather than on
+every field.
+=====================================================================*/
+class DwarfReader
+{
+public:
+	DwarfReader(const unsigned char *p_, const unsigned char *end_) : p(p_), end(end_), ok(true) {}
+
+	bool more() const { return ok && p < end; }
+
+	unsigned long long fixed(size_t size)
+	{
+		if ((size_t)(end - p) < size)
+			return fail();
+		unsigned long long value = 0;
+		for (size_t i = 0; i < size; i++)
+			value |= (unsigned long long)p[i] << (8 * i);
+		p += size;
+		return value;
+	}
+	unsigned u8() { return (unsigned)fixed(1); }
+	unsigned u16() { return (unsigned)fixed(2); }
+	unsigned u32() { return (unsigned)fixed(4); }
+
+	unsigned long long uleb()
+	{
+		unsigned long long value = 0;
+		for (unsigned shift = 0; p < end; shift += 7)
+		{
+			unsigned char byte = *p++;
+			if (shift < 64)
+				value |= (unsigned long long)(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+				return value;
+		}
+		return fail();
+	}
+
+	long long sleb()
+	{
+		long long value = 0;
+		unsigned shift = 0;
+		while (p < end)
+		{
+			unsigned char byte = *p++;
+			if (shift < 64)
+				value |= (long long)(byte & 0x7F) << shift;
+			shift += 7;
+			if (!(byte & 0x80))
+			{
+				if (shift < 64 && (byte & 0x40))
+					value |= -(1LL << shift);
+				return value;
+			}
+		}
+		return (long long)fail();
+	}
+
+	const char *str()
+	{
+		const unsigned char *nul = (const unsigned char *)memchr(p, 0, end - p);
+		if (!nul)
+		{
+			fail();
+			return "";
+		}
+		const char *s = (const char *)p;
+		p = nul + 1;
+		return s;
+	}
+
+	void skip(unsigned long long size)
+	{
+		if ((unsigned long long)(end - p) < size)
+			fail();
+		else
+			p += size;
+	}
+
+	const unsigned char *p, *end;
+	bool ok;
+
+private:
+	unsigned long long fail()
+	{
+		ok = false;
+		p = end;
+		return 0;
+	}
+};
+
+// The string sections that attributes and DWARF 5 file tables point into.
+struct StringSections
+{
+	const unsigned char *str, *line_str;
+	size_t str_size, line_str_size;
+};
+
+inline const char *sectionString(const unsigned char *section, size_t size, unsigned long long offset)
+{
+	if (!section || offset >= size || !memchr(section + offset, 0, size - offset))
+		return NULL;
+	return (const char *)section + offset;
+}
+
+#endif //__DWARFREADER_H_666_
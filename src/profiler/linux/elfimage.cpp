@@ -0,0 +1,228 @@
+/*=====================================================================
+elfimage.cpp
+------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "elfimage.h"
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if __WORDSIZE == 64
+static const unsigned char kOurClass = ELFCLASS64;
+#else
+static const unsigned char kOurClass = ELFCLASS32;
+#endif
+
+ElfImage::ElfImage()
+:	data(NULL),
+	size(0),
+	header(NULL)
+{
+}
+
+ElfImage::~ElfImage()
+{
+	close();
+}
+
+void ElfImage::close()
+{
+	if (data)
+		munmap((void *)data, size);
+	data = NULL;
+	size = 0;
+	header = NULL;
+	segments.clear();
+	programHeaders.clear();
+}
+
+bool ElfImage::open(const std::string &path)
+{
+	close();
+
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return false;
+
+	struct stat st;
+	void *mapped = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && (size_t)st.st_size >= sizeof(ElfW(Ehdr)))
+		mapped = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (mapped == MAP_FAILED)
+		return false;
+
+	data = (const unsigned char *)mapped;
+	size = (size_t)st.st_size;
+	header = (const ElfW(Ehdr) *)data;
+
+	if (memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 ||
+		header->e_ident[EI_CLASS] != kOurClass ||
+		header->e_phentsize != sizeof(ElfW(Phdr)) ||
+		header->e_phoff > size ||
+		(size - header->e_phoff) / sizeof(ElfW(Phdr)) < header->e_phnum)
+	{
+		close();
+		return false;
+	}
+
+	const ElfW(Phdr) *phdrs = (const ElfW(Phdr) *)(data + header->e_phoff);
+	for (unsigned i = 0; i < header->e_phnum; i++)
+	{
+		programHeaders.push_back(phdrs[i]);
+		if (phdrs[i].p_type == PT_LOAD)
+			segments.push_back(phdrs[i]);
+	}
+	return true;
+}
+
+const unsigned char *ElfImage::findSection(const char *name, size_t &section_size, unsigned long long *addr) const
+{
+	if (!header || !header->e_shoff || header->e_shentsize != sizeof(ElfW(Shdr)) ||
+		header->e_shoff > size ||
+		(size - header->e_shoff) / sizeof(ElfW(Shdr)) < header->e_shnum ||
+		header->e_shstrndx >= header->e_shnum)
+		return NULL;
+
+	const ElfW(Shdr) *sections = (const ElfW(Shdr) *)(data + header->e_shoff);
+	const ElfW(Shdr) &names = sections[header->e_shstrndx];
+	if (names.sh_offset > size || names.sh_size > size - names.sh_offset)
+		return NULL;
+
+	size_t len = strlen(name);
+	for (unsigned i = 0; i < header->e_shnum; i++)
+	{
+		const ElfW(Shdr) &section = sections[i];
+		if (section.sh_name + len >= names.sh_size ||
+			memcmp(data + names.sh_offset + section.sh_name, name, len + 1) != 0)
+			continue;
+
+		// Sections without contents (.bss) have nothing to read, and
+		// compressed ones (as debug info may be) nothing we can read in place.
+		if (section.sh_type == SHT_NOBITS || (section.sh_flags & SHF_COMPRESSED) ||
+			section.sh_offset > size || section.sh_size > size - section.sh_offset)
+			return NULL;
+
+		section_size = (size_t)section.sh_size;
+		if (addr)
+			*addr = (section.sh_flags & SHF_ALLOC) ? section.sh_addr : 0;
+		return data + section.sh_offset;
+	}
+	return NULL;
+}
+
+const ElfW(Phdr) *ElfImage::findSegment(unsigned type) const
+{
+	for (size_t i = 0; i < programHeaders.size(); i++)
+		if (programHeaders[i].p_type == type)
+			return &programHeaders[i];
+	return NULL;
+}
+
+const unsigned char *ElfImage::getDataAt(unsigned long long addr, size_t &avail) const
+{
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		const ElfW(Phdr) &seg = segments[i];
+		if (addr < seg.p_vaddr || addr - seg.p_vaddr >= seg.p_filesz)
+			continue;
+
+		unsigned long long offset = seg.p_offset + (addr - seg.p_vaddr);
+		if (offset >= size)
+			return NULL;
+		avail = (size_t)(seg.p_filesz - (addr - seg.p_vaddr));
+		if (avail > size - offset)
+			avail = (size_t)(size - offset);
+		return data + offset;
+	}
+	return NULL;
+}
+
+bool ElfImage::getAddrOfOffset(unsigned long long offset, unsigned long long &addr) const
+{
+	// Segments are mapped from the start of the page they begin in, so a
+	// mapping's offset is usually a little before its segment's. Where a
+	// page holds the end of one segment and the start of the next, the
+	// mapping that starts there is the later segment's.
+	const unsigned long long page_mask = (unsigned long long)sysconf(_SC_PAGESIZE) - 1;
+	bool found = false;
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		const ElfW(Phdr) &seg = segments[i];
+		unsigned long long start = seg.p_offset & ~page_mask;
+		if (offset < start || offset >= seg.p_offset + seg.p_memsz)
+			continue;
+		addr = (seg.p_vaddr - (seg.p_offset - start)) + (offset - start);
+		found = true;
+		if (offset == start)
+			break;
+	}
+	return found;
+}
+
+std::string ElfImage::getBuildId() const
+{
+	for (size_t i = 0; i < programHeaders.size(); i++)
+	{
+		const ElfW(Phdr) &note = programHeaders[i];
+		if (note.p_type != PT_NOTE || note.p_offset > size || note.p_filesz > size - note.p_offset)
+			continue;
+
+		// Each note is a header, then its name and its description, both
+		// padded to four bytes.
+		const unsigned char *p = data + note.p_offset;
+		const unsigned char *end = p + note.p_filesz;
+		while ((size_t)(end - p) >= sizeof(ElfW(Nhdr)))
+		{
+			const ElfW(Nhdr) *header = (const ElfW(Nhdr) *)p;
+			size_t name_size = (header->n_namesz + 3) & ~3u;
+			size_t desc_size = (header->n_descsz + 3) & ~3u;
+			p += sizeof(ElfW(Nhdr));
+			if ((size_t)(end - p) < name_size || (size_t)(end - p) - name_size < desc_size)
+				break;
+
+			if (header->n_type == NT_GNU_BUILD_ID && header->n_namesz == 4 && memcmp(p, "GNU", 4) == 0)
+			{
+				static const char digits[] = "0123456789abcdef";
+				std::string id;
+				const unsigned char *desc = p + name_size;
+				for (unsigned j = 0; j < header->n_descsz; j++)
+				{
+					id += digits[desc[j] >> 4];
+					id += digits[desc[j] & 15];
+				}
+				return id;
+			}
+			p += name_size + desc_size;
+		}
+	}
+	return "";
+}
+
+std::string ElfImage::getDebugLink() const
+{
+	size_t link_size;
+	const unsigned char *link = findSection(".gnu_debuglink", link_size);
+	if (!link || !memchr(link, 0, link_size))
+		return "";
+	return (const char *)link;
+}
@@ -0,0 +1,89 @@
+/*=====================================================================
+elfimage.h
+----------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __ELFIMAGE_H_666_
+#define __ELFIMAGE_H_666_
+
+#include <link.h>
+#include <string>
+#include <vector>
+
+/*=====================================================================
+ElfImage
+--------
+An ELF file mapped read-only into our address space, for reading the
+tables a module carries about itself. Only files of our own class
+(32- or 64-bit) are understood, as only those can be sampled.
+
+Addresses are the file's own, before the module is relocated; adding
+a mapping's load bias gives the address in the process.
+=====================================================================*/
+class ElfImage
+{
+public:
+	ElfImage();
+	~ElfImage();
+
+	/// Returns false if the file can't be read or isn't an ELF file we understand.
+	bool open(const std::string &path);
+	void close();
+
+	/// The contents of the named section, or NULL if there is none, or
+	/// it is compressed. addr receives where it is loaded, or 0 if it isn't.
+	const unsigned char *findSection(const char *name, size_t &size, unsigned long long *addr = NULL) const;
+
+	/// Loadable segments, from the program header table.
+	const std::vector<ElfW(Phdr)> &getSegments() const { return segments; }
+
+	/// The program header of the given type, or NULL.
+	const ElfW(Phdr) *findSegment(unsigned type) const;
+
+	/// The file data loaded at addr; avail receives how much follows it
+	/// within the segment. NULL if addr isn't loaded from the file.
+	const unsigned char *getDataAt(unsigned long long addr, size_t &avail) const;
+
+	/// Where the file data at offset is loaded, for working out the load
+	/// bias of a mapping. Returns false if it isn't loaded at all.
+	bool getAddrOfOffset(unsigned long long offset, unsigned long long &addr) const;
+
+	/// The GNU build-id note, in hex, or an empty string if there is none.
+	std::string getBuildId() const;
+
+	/// The file name in .gnu_debuglink, or an empty string if there is none.
+	std::string getDebugLink() const;
+
+	const unsigned char *getData() const { return data; }
+	size_t getSize() const { return size; }
+
+private:
+	const unsigned char *data;
+	size_t size;
+
+	const ElfW(Ehdr) *header;
+	std::vector<ElfW(Phdr)> segments; // PT_LOAD only
+	std::vector<ElfW(Phdr)> programHeaders;
+
+	ElfImage(const ElfImage &);
+	ElfImage &operator=(const ElfImage &);
+};
+
+#endif //__ELFIMAGE_H_666_
@@ -0,0 +1,227 @@
+/*=====================================================================
+elfsymbolizer.cpp
+-----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "elfsymbolizer.h"
+#include <cxxabi.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Where distributions install separate debug files.
+static const char kDebugDir[] = "/usr/lib/debug";
+
+ElfSymbolizer::ElfSymbolizer()
+:	numInlined(0),
+	numCached(0)
+{
+}
+
+ElfSymbolizer::~ElfSymbolizer()
+{
+	for (std::map<std::string, Module *>::iterator it = modules.begin(); it != modules.end(); ++it)
+		delete it->second;
+}
+
+void ElfSymbolizer::setProcess(unsigned long process_id)
+{
+	char buf[64];
+	snprintf(buf, sizeof(buf), "/proc/%lu/root", process_id);
+	root = buf;
+}
+
+bool ElfSymbolizer::openFile(ElfImage &image, const std::string &path) const
+{
+	return image.open(root + path) || image.open(path);
+}
+
+bool ElfSymbolizer::openDebugFile(Module &module, const std::string &path) const
+{
+	std::string id = module.image.getBuildId();
+	if (id.size() > 2 && openFile(module.debug, std::string(kDebugDir) + "/.build-id/" + id.substr(0, 2) + "/" + id.substr(2) + ".debug"))
+		return true;
+
+	std::string link = module.image.getDebugLink();
+	if (link.empty())
+		return false;
+
+	// The places gdb looks, next to the file and under the debug directory.
+	std::string dir = path.substr(0, path.rfind('/'));
+	const std::string candidates[] = {
+		dir + "/" + link,
+		dir + "/.debug/" + link,
+		kDebugDir + dir + "/" + link
+	};
+	for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++)
+	{
+		// A debug file for some other build would give wrong answers.
+		if (candidates[i] != path && openFile(module.debug, candidates[i]) &&
+			(id.empty() || module.debug.getBuildId() == id))
+			return true;
+	}
+	module.debug.close();
+	return false;
+}
+
+ElfSymbolizer::Module *ElfSymbolizer::getModule(const std::string &path)
+{
+	std::map<std::string, Module *>::iterator it = modules.find(path);
+	if (it != modules.end())
+		return it->second;
+
+	Module *module = new Module;
+	module->path = path;
+	module->cached = NULL;
+	module->loaded = true; // if it can't be opened, there's nothing more to read
+	module->hasSymbols = module->hasLines = module->hasInlines = false;
+	if (openFile(module->image, path))
+	{
+		module->loaded = false;
+		// Without a build-id there's no telling one build from another.
+		std::string id = module->image.getBuildId();
+		if (!id.empty())
+			module->cached = cache.getModule(path.substr(path.rfind('/') + 1) + "-" + id);
+	}
+	modules[path] = module;
+	return module;
+}
+
+void ElfSymbolizer::load(Module &module)
+{
+	module.loaded = true;
+
+	// Stripped files keep their full symbol table in the debug file,
+	// and only the exports in .dynsym.
+	bool hasDebug = openDebugFile(module, module.path);
+	module.hasSymbols = (hasDebug && module.symbols.build(module.debug)) || module.symbols.build(module.image);
+
+	// Inlined calls name their files by the numbers of the line
+	// tables, so both have to come from the same file.
+	const ElfImage *dwarf = NULL;
+	if (hasDebug && module.lines.build(module.debug))
+		dwarf = &module.debug;
+	else if (module.lines.build(module.image))
+		dwarf = &module.image;
+	module.hasLines = dwarf != NULL;
+	module.hasInlines = dwarf && module.inlines.build(*dwarf);
+}
+
+std::string ElfSymbolizer::demangle(const char *name)
+{
+	int status;
+	char *demangled = abi::__cxa_demangle(name, NULL, NULL, &status);
+	if (!demangled)
+		return name; // C, or not a name the ABI knows
+	std::string result = demangled;
+	free(demangled);
+	return result;
+}
+
+void ElfSymbolizer::resolve(const ProcMaps &maps, PROFILER_ADDR addr, std::string &proc, std::string &file, unsigned &line,
+							std::vector<InlineFrame> &inlined)
+{
+	proc.clear();
+	file.clear();
+	line = 0;
+	inlined.clear();
+
+	// Anonymous mappings (JIT code), [vdso] and so on have no file to read.
+	const ProcMaps::Mapping *mapping = maps.find(addr);
+	if (!mapping || mapping->path.empty() || mapping->path[0] != '/')
+		return;
+
+	Module *module = getModule(mapping->path);
+
+	// The mapping says where in the file it starts; the file says what
+	// address that was linked at. The difference is the load bias.
+	unsigned long long linked;
+	if (!module->image.getAddrOfOffset(mapping->offset, linked))
+		return;
+	unsigned long long image_addr = addr - mapping->start + linked;
+
+	// The cache keeps addresses as 32-bit offsets into the module.
+	unsigned rva = (unsigned)image_addr;
+	CachedSymbols *cached = rva == image_addr ? module->cached : NULL;
+	if (cached && cached->findAddr(rva, proc, file, line, &inlined))
+		numCached++;
+	else
+	{
+		if (!module->loaded)
+			load(*module);
+		lookup(*module, image_addr, proc, file, line, inlined);
+		if (cached)
+			cached->addAddr(rva, proc, file, line, &inlined);
+	}
+
+	if (!inlined.empty())
+		numInlined++;
+}
+
+void ElfSymbolizer::lookup(Module &module, unsigned long long image_addr, std::string &proc, std::string &file, unsigned &line,
+						   std::vector<InlineFrame> &inlined)
+{
+	if (module.hasSymbols)
+	{
+		if (const char *name = module.symbols.find(image_addr))
+			proc = demangle(name);
+	}
+	if (module.hasLines)
+		module.lines.find(image_addr, file, line);
+
+	// The line table has the innermost call's line; each call says where
+	// it was made from in the function around it.
+	for (const DwarfInlines::Call *call = module.hasInlines ? module.inlines.find(image_addr) : NULL;
+		 call; call = module.inlines.getParent(*call))
+	{
+		InlineFrame frame;
+		frame.proc = demangle(module.inlines.getName(*call).c_str());
+		frame.file = file;
+		frame.line = line;
+		inlined.push_back(frame);
+
+		const std::string *caller_file = module.lines.getUnitFile(call->unit, call->file);
+		file = caller_file ? *caller_file : std::string();
+		line = caller_file ? call->line : 0;
+	}
+}
+
+void ElfSymbolizer::getStats(std::vector<std::string> &lines) const
+{
+	size_t onlyCached = 0, withSymbols = 0, withLines = 0, withInlines = 0;
+	for (std::map<std::string, Module *>::const_iterator it = modules.begin(); it != modules.end(); ++it)
+	{
+		if (!it->second->loaded)
+			onlyCached++;
+		if (it->second->hasSymbols)
+			withSymbols++;
+		if (it->second->hasLines)
+			withLines++;
+		if (it->second->hasInlines)
+			withInlines++;
+	}
+
+	char line[128];
+	snprintf(line, sizeof(line), "Modules with symbols: %u of %u, with line numbers: %u, with inlining: %u",
+			 (unsigned)withSymbols, (unsigned)modules.size(), (unsigned)withLines, (unsigned)withInlines);
+	lines.push_back(line);
+	snprintf(line, sizeof(line), "Modules only in the symbol cache: %u, addresses from it: %llu", (unsigned)onlyCached, numCached);
+	lines.push_back(line);
+	snprintf(line, sizeof(line), "Addresses in inlined code: %llu", numInlined);
+	lines.push_back(line);
+}
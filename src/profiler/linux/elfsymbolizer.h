@@ -0,0 +1,115 @@
+/*=====================================================================
+elfsymbolizer.h
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __ELFSYMBOLIZER_H_666_
+#define __ELFSYMBOLIZER_H_666_
+
+#include "dwarfinlines.h"
+#include "dwarflines.h"
+#include "elfimage.h"
+#include "elfsymbols.h"
+#include "procmaps.h"
+#include "../symbolcache.h"
+#include <map>
+#include <string>
+#include <vector>
+
+/*=====================================================================
+ElfSymbolizer
+-------------
+Names the functions, source files and lines of addresses in a Linux
+process, as SymbolInfo does on Windows, by reading the ELF files it
+mapped ourselves.
+
+Each module is opened the first time one of its addresses turns up.
+Given a cache directory, what was found for an address is kept there
+by the module's build-id, and a module whose addresses are all in the
+cache is never read any further. Otherwise its separate debug file is
+opened too, if it has one: found by its build-id under
+/usr/lib/debug/.build-id, or by .gnu_debuglink. Its symbol table and
+line table are read once, and then searched for every address in it.
+
+Where the code at an address was inlined, its debug information says
+from what: the address then stands for a chain of calls, the innermost
+of which is where the line table puts it, and each outer one at the
+line it called the next from.
+=====================================================================*/
+class ElfSymbolizer
+{
+public:
+	ElfSymbolizer();
+	~ElfSymbolizer();
+
+	/// Files are opened through the process's root, in case it is in a container.
+	void setProcess(unsigned long process_id);
+
+	/// Where to keep what's been looked up (see SymbolCache); set before
+	/// the first resolve.
+	void setCacheDirectory(const std::string &dir) { cache.setDirectory(dir); }
+	void saveCache() { cache.save(); }
+
+	/// A function inlined at an address.
+	typedef CachedSymbols::Inlined InlineFrame;
+
+	/// Look up addr, in the process whose memory map is maps. proc is
+	/// demangled, and empty if no function holds addr; file is empty and
+	/// line 0 if there's no line information for it. If code was inlined
+	/// there, inlined gets the functions it came from, innermost first,
+	/// and file and line are where proc called the outermost of them.
+	void resolve(const ProcMaps &maps, PROFILER_ADDR addr, std::string &proc, std::string &file, unsigned &line,
+				 std::vector<InlineFrame> &inlined);
+
+	void getStats(std::vector<std::string> &lines) const;
+
+private:
+	struct Module
+	{
+		std::string path;
+		CachedSymbols *cached; ///< NULL if not cached
+		bool loaded; ///< whether the rest has been read
+
+		ElfImage image;
+		ElfImage debug; ///< not open if there's no separate debug file
+		ElfSymbols symbols;
+		DwarfLines lines;
+		DwarfInlines inlines;
+		bool hasSymbols, hasLines, hasInlines;
+	};
+
+	std::string root;
+	std::map<std::string, Module *> modules; // by path
+	SymbolCache cache;
+	unsigned long long numInlined, numCached;
+
+	Module *getModule(const std::string &path);
+	void load(Module &module);
+	void lookup(Module &module, unsigned long long image_addr, std::string &proc, std::string &file, unsigned &line,
+				std::vector<InlineFrame> &inlined);
+	bool openFile(ElfImage &image, const std::string &path) const;
+	bool openDebugFile(Module &module, const std::string &path) const;
+	static std::string demangle(const char *name);
+
+	ElfSymbolizer(const ElfSymbolizer &);
+	ElfSymbolizer &operator=(const ElfSymbolizer &);
+};
+
+#endif //__ELFSYMBOLIZER_H_666_
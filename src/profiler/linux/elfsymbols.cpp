@@ -0,0 +1,106 @@
+/*=====================================================================
+elfsymbols.cpp
+--------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "elfsymbols.h"
+#include "elfimage.h"
+#include <algorithm>
+#include <string.h>
+
+ElfSymbols::ElfSymbols()
+{
+}
+
+bool ElfSymbols::readTable(const ElfImage &image, const char *symtab_name, const char *strtab_name)
+{
+	size_t symtab_size, strtab_size;
+	const unsigned char *symtab = image.findSection(symtab_name, symtab_size);
+	const char *strtab = (const char *)image.findSection(strtab_name, strtab_size);
+	if (!symtab || !strtab || !strtab_size || strtab[strtab_size - 1] != 0)
+		return false;
+
+	const ElfW(Sym) *syms = (const ElfW(Sym) *)symtab;
+	size_t count = symtab_size / sizeof(ElfW(Sym));
+	for (size_t i = 0; i < count; i++)
+	{
+		// st_info is laid out the same in both classes.
+		const ElfW(Sym) &sym = syms[i];
+		unsigned type = ELF32_ST_TYPE(sym.st_info);
+		if ((type != STT_FUNC && type != STT_GNU_IFUNC) ||
+			sym.st_shndx == SHN_UNDEF || !sym.st_value || sym.st_name >= strtab_size)
+			continue;
+
+		Function f;
+		f.start = sym.st_value;
+		f.end = sym.st_value + sym.st_size;
+		f.name = strtab + sym.st_name;
+		f.binding = ELF32_ST_BIND(sym.st_info);
+		functions.push_back(f);
+	}
+	return !functions.empty();
+}
+
+bool ElfSymbols::functionBefore(const Function &a, const Function &b)
+{
+	if (a.start != b.start)
+		return a.start < b.start;
+
+	// Of aliases, the global name is the one people know, then the weak.
+	static const int rank[] = { 2, 0, 1 }; // STB_LOCAL, STB_GLOBAL, STB_WEAK
+	int rank_a = a.binding <= STB_WEAK ? rank[a.binding] : 3;
+	int rank_b = b.binding <= STB_WEAK ? rank[b.binding] : 3;
+	if (rank_a != rank_b)
+		return rank_a < rank_b;
+	return strcmp(a.name, b.name) < 0;
+}
+
+bool ElfSymbols::build(const ElfImage &image)
+{
+	functions.clear();
+	if (!readTable(image, ".symtab", ".strtab"))
+		readTable(image, ".dynsym", ".dynstr");
+
+	// Keep one name per address.
+	std::sort(functions.begin(), functions.end(), functionBefore);
+	size_t out = 0;
+	for (size_t i = 0; i < functions.size(); i++)
+		if (out == 0 || functions[out - 1].start != functions[i].start)
+			functions[out++] = functions[i];
+	functions.resize(out);
+
+	for (size_t i = 0; i < functions.size(); i++)
+	{
+		Function &f = functions[i];
+		if (f.end == f.start && i + 1 < functions.size())
+			f.end = functions[i + 1].start;
+	}
+
+	std::vector<Function>(functions).swap(functions);
+	return !functions.empty();
+}
+
+const char *ElfSymbols::find(unsigned long long addr) const
+{
+	std::vector<Function>::const_iterator it = std::upper_bound(functions.begin(), functions.end(), addr, addrBefore);
+	if (it == functions.begin())
+		return NULL;
+	--it;
+	return addr < it->end ? it->name : NULL;
+}
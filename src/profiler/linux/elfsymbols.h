@@ -0,0 +1,72 @@
+/*=====================================================================
+elfsymbols.h
+------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __ELFSYMBOLS_H_666_
+#define __ELFSYMBOLS_H_666_
+
+#include <stddef.h>
+#include <vector>
+
+class ElfImage;
+
+/*=====================================================================
+ElfSymbols
+----------
+The functions in a module's symbol table, as address ranges sorted by
+start. Names point into the image's string table, so the image has to
+stay open for as long as they are used.
+
+.symtab is used if there is one, otherwise .dynsym, which only has
+exported functions. Functions without a size are taken to run up to
+the next one, except the last, which can't be told from what follows.
+=====================================================================*/
+class ElfSymbols
+{
+public:
+	ElfSymbols();
+
+	/// Read image's symbol table. Returns false if it has no functions.
+	bool build(const ElfImage &image);
+
+	/// The (mangled) name of the function holding addr, an address in
+	/// the image, or NULL.
+	const char *find(unsigned long long addr) const;
+
+	size_t getNumFunctions() const { return functions.size(); }
+
+private:
+	struct Function
+	{
+		unsigned long long start, end; ///< [start, end)
+		const char *name;
+		unsigned char binding;
+	};
+
+	std::vector<Function> functions;
+
+	bool readTable(const ElfImage &image, const char *symtab_name, const char *strtab_name);
+
+	static bool addrBefore(unsigned long long addr, const Function &f) { return addr < f.start; }
+	static bool functionBefore(const Function &a, const Function &b);
+};
+
+#endif //__ELFSYMBOLS_H_666_
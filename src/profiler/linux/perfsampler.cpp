@@ -0,0 +1,275 @@
+/*=====================================================================
+perfsampler.cpp
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "perfsampler.h"
+#include "monotonic.h"
+#include <dirent.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <set>
+
+// How often to look for threads started or exited since the last scan.
+static const unsigned long long kRescanIntervalNs = 100 * 1000 * 1000;
+
+// Ring buffer pages per thread (a power of two). Locked memory is
+// limited for unprivileged users, so fewer are tried if this fails.
+static const size_t kRingPages = 16;
+
+static std::wstring widen(const char *s)
+{
+	return std::wstring(s, s + strlen(s));
+}
+
+static int perfEventOpen(struct perf_event_attr *attr, pid_t tid)
+{
+	return (int)syscall(__NR_perf_event_open, attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+PerfSampler::PerfSampler(double rate)
+:	pid(0),
+	period((unsigned long long)(1e9 / rate)),
+	next_rescan(0),
+	page_size((size_t)sysconf(_SC_PAGESIZE)),
+	numLost(0),
+	lastError(0)
+{
+	if (!period)
+		period = 1;
+}
+
+PerfSampler::~PerfSampler()
+{
+	detach();
+}
+
+void PerfSampler::attach(unsigned long process_id)
+{
+	pid = (pid_t)process_id;
+	rescanThreads(monotonicNow());
+	if (threads.empty())
+	{
+		std::wstring reason = widen(strerror(lastError ? lastError : ESRCH));
+		if (lastError == EACCES || lastError == EPERM)
+			reason += L" (see /proc/sys/kernel/perf_event_paranoid)";
+		throw ProfilerExcep(L"Could not open perf events for the process: " + reason);
+	}
+}
+
+bool PerfSampler::openThread(pid_t tid, Thread &thread)
+{
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_SOFTWARE;
+	attr.config = PERF_COUNT_SW_TASK_CLOCK;
+	attr.sample_period = period;
+	attr.sample_type = PERF_SAMPLE_IP | PERF_SAMPLE_TID | PERF_SAMPLE_TIME | PERF_SAMPLE_CALLCHAIN;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.exclude_callchain_kernel = 1;
+	attr.use_clockid = 1;
+	attr.clockid = CLOCK_MONOTONIC;
+
+	int fd = perfEventOpen(&attr, tid);
+	if (fd == -1)
+	{
+		lastError = errno;
+		return false;
+	}
+
+	for (size_t pages = kRingPages; pages >= 1; pages /= 2)
+	{
+		size_t size = (pages + 1) * page_size;
+		void *ring = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (ring != MAP_FAILED)
+		{
+			thread.tid = tid;
+			thread.fd = fd;
+			thread.ring = (unsigned char *)ring;
+			thread.data_size = pages * page_size;
+			return true;
+		}
+		lastError = errno;
+	}
+
+	close(fd);
+	return false;
+}
+
+void PerfSampler::closeThread(Thread &thread)
+{
+	munmap(thread.ring, thread.data_size + page_size);
+	close(thread.fd);
+}
+
+void PerfSampler::rescanThreads(unsigned long long now)
+{
+	next_rescan = now + kRescanIntervalNs;
+
+	char dirname[64];
+	snprintf(dirname, sizeof(dirname), "/proc/%d/task", (int)pid);
+	DIR *dir = opendir(dirname);
+	if (!dir)
+	{
+		// The process has gone. Its rings have been drained already.
+		for (size_t i = 0; i < threads.size(); i++)
+			closeThread(threads[i]);
+		threads.clear();
+		return;
+	}
+
+	std::set<pid_t> current;
+	while (struct dirent *entry = readdir(dir))
+	{
+		pid_t tid = (pid_t)atoi(entry->d_name);
+		if (tid > 0)
+			current.insert(tid);
+	}
+	closedir(dir);
+
+	// An exited thread's event stays open, but will never sample again.
+	size_t kept = 0;
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		if (current.erase(threads[i].tid))
+			threads[kept++] = threads[i];
+		else
+			closeThread(threads[i]);
+	}
+	threads.resize(kept);
+
+	// What's left is new.
+	for (auto it = current.begin(); it != current.end(); ++it)
+	{
+		Thread thread;
+		if (openThread(*it, thread))
+			threads.push_back(thread);
+	}
+}
+
+void PerfSampler::drain(Thread &thread, SampleSink &sink)
+{
+	struct perf_event_mmap_page *meta = (struct perf_event_mmap_page *)thread.ring;
+	const unsigned char *data = thread.ring + page_size;
+	const size_t mask = thread.data_size - 1;
+
+	// The kernel publishes data_head after writing the records before it,
+	// and reuses the space before data_tail once we publish it.
+	unsigned long long head = __atomic_load_n(&meta->data_head, __ATOMIC_ACQUIRE);
+	unsigned long long tail = meta->data_tail;
+
+	CallStack stack;
+	while (tail < head)
+	{
+		struct perf_event_header header;
+		for (size_t i = 0; i < sizeof(header); i++)
+			((unsigned char *)&header)[i] = data[(tail + i) & mask];
+		if (header.size < sizeof(header) || tail + header.size > head)
+			break;
+
+		record.resize(header.size);
+		size_t start = (size_t)(tail & mask);
+		size_t first = thread.data_size - start;
+		if (first >= header.size)
+			memcpy(&record[0], data + start, header.size);
+		else
+		{
+			memcpy(&record[0], data + start, first);
+			memcpy(&record[first], data, header.size - first);
+		}
+		tail += header.size;
+
+		if (header.type == PERF_RECORD_LOST)
+		{
+			// header, u64 id, u64 lost
+			uint64_t lost;
+			memcpy(&lost, &record[sizeof(header) + 8], sizeof(lost));
+			numLost += lost;
+			continue;
+		}
+		if (header.type != PERF_RECORD_SAMPLE)
+			continue;
+
+		// header, u64 ip, u32 pid, u32 tid, u64 time, u64 nr, u64 ips[nr]
+		const unsigned char *p = &record[sizeof(header)];
+		const unsigned char *end = &record[0] + header.size;
+		if (end - p < 32)
+			continue;
+		uint64_t ip, time, nr;
+		uint32_t tid;
+		memcpy(&ip, p, 8);
+		memcpy(&tid, p + 12, 4);
+		memcpy(&time, p + 16, 8);
+		memcpy(&nr, p + 24, 8);
+		p += 32;
+		if (nr > (uint64_t)(end - p) / 8)
+			continue;
+
+		// The callchain is innermost first, like a CallStack, but interleaved
+		// with markers saying whether what follows is kernel or user code.
+		stack.depth = 0;
+		for (uint64_t i = 0; i < nr && stack.depth < MAX_CALLSTACK_LEVELS; i++)
+		{
+			uint64_t addr;
+			memcpy(&addr, p + i * 8, 8);
+			if (addr >= (uint64_t)PERF_CONTEXT_MAX)
+				continue;
+			stack.addr[stack.depth++] = (PROFILER_ADDR)addr;
+		}
+		if (stack.depth == 0)
+			stack.addr[stack.depth++] = (PROFILER_ADDR)ip;
+
+		sink.addSample(time, tid, stack, period * 1e-9);
+	}
+
+	__atomic_store_n(&meta->data_tail, tail, __ATOMIC_RELEASE);
+}
+
+void PerfSampler::sampleRound(SampleSink &sink)
+{
+	for (size_t i = 0; i < threads.size(); i++)
+		drain(threads[i], sink);
+
+	unsigned long long now = monotonicNow();
+	if (now >= next_rescan)
+		rescanThreads(now);
+}
+
+void PerfSampler::detach()
+{
+	for (size_t i = 0; i < threads.size(); i++)
+		closeThread(threads[i]);
+	threads.clear();
+}
+
+void PerfSampler::getStats(std::vector<std::string> &lines) const
+{
+	char line[128];
+	snprintf(line, sizeof(line), "Lost samples (ring buffer full): %llu", numLost);
+	lines.push_back(line);
+}
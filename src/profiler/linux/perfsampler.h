@@ -0,0 +1,84 @@
+/*=====================================================================
+perfsampler.h
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __PERFSAMPLER_H_666_
+#define __PERFSAMPLER_H_666_
+
+#include "samplerbackend.h"
+#include <sys/types.h>
+#include <vector>
+
+/*=====================================================================
+PerfSampler
+-----------
+Has the kernel take the samples: each thread of the target gets a
+task-clock perf event, which records the thread's user-mode callchain
+into a ring buffer every so much CPU time. sampleRound just drains the
+rings, so the target is never stopped, and the rate can be much higher
+than stopping threads allows.
+
+Unlike the other backends, only time spent running is sampled; a
+thread that is blocked gets no samples. Callchains are walked by the
+kernel through frame pointers.
+=====================================================================*/
+class PerfSampler : public SamplerBackend
+{
+public:
+	/// rate is in samples per second of CPU time, per thread.
+	PerfSampler(double rate);
+	virtual ~PerfSampler();
+
+	virtual void attach(unsigned long process_id);//throws ProfilerExcep
+	virtual void sampleRound(SampleSink &sink);
+	virtual void detach();
+	virtual size_t getNumThreads() const { return threads.size(); }
+	virtual void getStats(std::vector<std::string> &lines) const;
+
+private:
+	struct Thread
+	{
+		pid_t tid;
+		int fd;
+		/// The perf_event_mmap_page, followed by data_size bytes of ring buffer.
+		unsigned char *ring;
+		size_t data_size;
+	};
+
+	pid_t pid;
+	unsigned long long period; // nanoseconds of CPU time
+	std::vector<Thread> threads;
+	unsigned long long next_rescan;
+	size_t page_size;
+
+	unsigned long long numLost;
+	int lastError;
+
+	/// One record at a time, so that records wrapping around the end of a ring are contiguous.
+	std::vector<unsigned char> record;
+
+	void rescanThreads(unsigned long long now);
+	bool openThread(pid_t tid, Thread &thread);
+	void closeThread(Thread &thread);
+	void drain(Thread &thread, SampleSink &sink);
+};
+
+#endif //__PERFSAMPLER_H_666_
@@ -0,0 +1,115 @@
+/*=====================================================================
+procmaps.cpp
+------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "procmaps.h"
+#include <stdio.h>
+#include <string.h>
+
+static bool sameCode(const std::vector<ProcMaps::Mapping> &a, const std::vector<ProcMaps::Mapping> &b)
+{
+	size_t i = 0, j = 0;
+	for (;;)
+	{
+		while (i < a.size() && !a[i].executable)
+			i++;
+		while (j < b.size() && !b[j].executable)
+			j++;
+		if (i == a.size() || j == b.size())
+			return i == a.size() && j == b.size();
+		if (a[i].start != b[j].start || a[i].end != b[j].end ||
+			a[i].offset != b[j].offset || a[i].path != b[j].path)
+			return false;
+		i++;
+		j++;
+	}
+}
+
+bool ProcMaps::load(unsigned long process_id)
+{
+	char filename[64];
+	snprintf(filename, sizeof(filename), "/proc/%lu/maps", process_id);
+
+	FILE *file = fopen(filename, "r");
+	if (!file)
+		return false;
+
+	std::vector<Mapping> old;
+	old.swap(mappings);
+
+	// start-end perms offset dev inode [path]
+	char line[4096 + 256];
+	while (fgets(line, sizeof(line), file))
+	{
+		unsigned long long start, end, offset;
+		char perms[8];
+		int pathpos = 0;
+		if (sscanf(line, "%llx-%llx %7s %llx %*s %*s %n", &start, &end, perms, &offset, &pathpos) < 4)
+			continue;
+
+		Mapping mapping;
+		mapping.start = (PROFILER_ADDR)start;
+		mapping.end = (PROFILER_ADDR)end;
+		mapping.offset = offset;
+		mapping.executable = perms[2] == 'x';
+		if (pathpos > 0)
+		{
+			mapping.path = line + pathpos;
+			while (!mapping.path.empty() && (mapping.path.back() == '\n' || mapping.path.back() == ' '))
+				mapping.path.pop_back();
+		}
+		mappings.push_back(mapping);
+	}
+
+	fclose(file);
+
+	if (!sameCode(old, mappings))
+		codeGeneration++;
+	return true;
+}
+
+const ProcMaps::Mapping *ProcMaps::find(PROFILER_ADDR addr) const
+{
+	// The kernel lists mappings in address order.
+	size_t lo = 0, hi = mappings.size();
+	while (lo < hi)
+	{
+		size_t mid = (lo + hi) / 2;
+		if (mappings[mid].end <= addr)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo < mappings.size() && mappings[lo].start <= addr)
+		return &mappings[lo];
+	return NULL;
+}
+
+std::string ProcMaps::getModuleName(PROFILER_ADDR addr) const
+{
+	const Mapping *mapping = find(addr);
+	if (!mapping || mapping->path.empty() || mapping->path[0] == '[')
+		return "";
+
+	size_t slash = mapping->path.rfind('/');
+	if (slash == std::string::npos)
+		return mapping->path;
+	return mapping->path.substr(slash + 1);
+}
@@ -0,0 +1,73 @@
+/*=====================================================================
+procmaps.h
+----------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __PROCMAPS_H_666_
+#define __PROCMAPS_H_666_
+
+#include "../profilertypes.h"
+#include <string>
+#include <vector>
+
+/*=====================================================================
+ProcMaps
+--------
+The memory map of a Linux process, as read from /proc/<pid>/maps.
+Tells us which module an address belongs to, and where each thread's
+stack ends.
+=====================================================================*/
+class ProcMaps
+{
+public:
+	struct Mapping
+	{
+		PROFILER_ADDR start, end;
+		/// Offset of start within the mapped file.
+		unsigned long long offset;
+		bool executable;
+		/// The mapped file, or a pseudo-name such as "[stack]"; empty for anonymous memory.
+		std::string path;
+	};
+
+	ProcMaps() : codeGeneration(0) {}
+
+	/// Returns false if the process has gone.
+	bool load(unsigned long process_id);
+
+	/// The mapping containing addr, or NULL.
+	const Mapping *find(PROFILER_ADDR addr) const;
+
+	/// File name of the mapping containing addr, without its directory.
+	std::string getModuleName(PROFILER_ADDR addr) const;
+
+	const std::vector<Mapping> &getMappings() const { return mappings; }
+
+	/// Changes whenever a load finds code mapped or unmapped, so that
+	/// anything remembered about code addresses can be dropped.
+	unsigned getCodeGeneration() const { return codeGeneration; }
+
+private:
+	/// Sorted by address; mappings never overlap.
+	std::vector<Mapping> mappings;
+	unsigned codeGeneration;
+};
+
+#endif //__PROCMAPS_H_666_
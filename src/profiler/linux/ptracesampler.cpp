@@ -0,0 +1,270 @@
+/*=====================================================================
+ptracesampler.cpp
+-----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "ptracesampler.h"
+#include "monotonic.h"
+#include <dirent.h>
+#include <elf.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ptrace.h>
+#include <sys/uio.h>
+#include <sys/user.h>
+#include <sys/wait.h>
+
+// How often to look for threads started since the last scan.
+static const unsigned long long kRescanIntervalNs = 100 * 1000 * 1000;
+
+static std::wstring widen(const char *s)
+{
+	return std::wstring(s, s + strlen(s));
+}
+
+PtraceSampler::PtraceSampler()
+:	pid(0),
+	next_rescan(0),
+	maps_reloaded(false),
+	stackcopy(MAX_STACK_COPY)
+{
+}
+
+PtraceSampler::~PtraceSampler()
+{
+	detach();
+}
+
+void PtraceSampler::attach(unsigned long process_id)
+{
+	pid = (pid_t)process_id;
+	unwinder.setProcess(process_id);
+	if (!maps.load(pid))
+		throw ProfilerExcep(L"No such process");
+
+	errno = 0;
+	rescanThreads(monotonicNow());
+	if (threads.empty())
+		throw ProfilerExcep(L"Could not attach to the process: " + widen(strerror(errno ? errno : ESRCH)));
+}
+
+bool PtraceSampler::hasThread(pid_t tid) const
+{
+	for (size_t i = 0; i < threads.size(); i++)
+		if (threads[i].tid == tid)
+			return true;
+	return false;
+}
+
+void PtraceSampler::rescanThreads(unsigned long long now)
+{
+	next_rescan = now + kRescanIntervalNs;
+
+	char dirname[64];
+	snprintf(dirname, sizeof(dirname), "/proc/%d/task", (int)pid);
+	DIR *dir = opendir(dirname);
+	if (!dir)
+		return; // the process has gone
+
+	while (struct dirent *entry = readdir(dir))
+	{
+		pid_t tid = (pid_t)atoi(entry->d_name);
+		if (tid <= 0 || hasThread(tid))
+			continue;
+
+		// Threads can exit between being listed and being seized.
+		if (ptrace(PTRACE_SEIZE, tid, 0, 0) == -1)
+			continue;
+
+		Thread thread = { tid, now };
+		threads.push_back(thread);
+	}
+
+	closedir(dir);
+}
+
+bool PtraceSampler::stopThread(pid_t tid, bool &group_stop)
+{
+	group_stop = false;
+	if (ptrace(PTRACE_INTERRUPT, tid, 0, 0) == -1)
+	{
+		// Reap its exit notification, if it has exited.
+		int status;
+		waitpid(tid, &status, __WALL | WNOHANG);
+		return false;
+	}
+
+	for (;;)
+	{
+		int status;
+		if (waitpid(tid, &status, __WALL) == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		if (WIFEXITED(status) || WIFSIGNALED(status))
+			return false;
+		if (!WIFSTOPPED(status))
+			continue;
+
+		int sig = WSTOPSIG(status);
+		int event = status >> 16;
+		if (event == PTRACE_EVENT_STOP)
+		{
+			// Our interrupt reports SIGTRAP; anything else means the
+			// whole process was stopped by job control, and must stay so.
+			group_stop = sig == SIGSTOP || sig == SIGTSTP || sig == SIGTTIN || sig == SIGTTOU;
+			return true;
+		}
+
+		// A signal arrived before our interrupt took effect. Deliver it,
+		// then wait on; the interrupt stays pending until it is reported.
+		if (ptrace(PTRACE_CONT, tid, 0, event ? 0 : sig) == -1)
+			return false;
+	}
+}
+
+void PtraceSampler::resumeThread(pid_t tid, bool group_stop)
+{
+	ptrace(group_stop ? PTRACE_LISTEN : PTRACE_CONT, tid, 0, 0);
+}
+
+bool PtraceSampler::captureStack(pid_t tid, Registers &regs, size_t &copied)
+{
+	struct user_regs_struct raw;
+	struct iovec iov = { &raw, sizeof(raw) };
+	if (ptrace(PTRACE_GETREGSET, tid, (void *)NT_PRSTATUS, &iov) == -1)
+		return false;
+
+	copied = 0;
+	if (iov.iov_len != sizeof(raw))
+	{
+		// A 32-bit process under a 64-bit sampler; not supported.
+		regs.pc = regs.sp = regs.fp = 0;
+		return true;
+	}
+
+#if defined(__x86_64__)
+	regs.pc = raw.rip;
+	regs.sp = raw.rsp;
+	regs.fp = raw.rbp;
+#elif defined(__i386__)
+	regs.pc = raw.eip;
+	regs.sp = raw.esp;
+	regs.fp = raw.ebp;
+#elif defined(__aarch64__)
+	regs.pc = raw.pc;
+	regs.sp = raw.sp;
+	regs.fp = raw.regs[29];
+#else
+#error "PtraceSampler doesn't know this architecture's registers"
+#endif
+
+	// Copy no further than the end of the stack's mapping, or the read fails.
+	// Stacks of new threads aren't in the map yet, so reload it once a round.
+	const ProcMaps::Mapping *mapping = maps.find(regs.sp);
+	if (!mapping && !maps_reloaded)
+	{
+		maps.load(pid);
+		maps_reloaded = true;
+		mapping = maps.find(regs.sp);
+	}
+	if (!mapping)
+		return true;
+
+	size_t size = (size_t)(mapping->end - regs.sp);
+	if (size > stackcopy.size())
+		size = stackcopy.size();
+
+	struct iovec local = { &stackcopy[0], size };
+	struct iovec remote = { (void *)(uintptr_t)regs.sp, size };
+	ssize_t result = process_vm_readv(pid, &local, 1, &remote, 1, 0);
+	if (result > 0)
+		copied = (size_t)result;
+	return true;
+}
+
+void PtraceSampler::walkFrames(const Registers &regs, size_t copied, CallStack &stack)
+{
+	stack.depth = 0;
+	if (!regs.pc)
+		return;
+
+	StackFrame frame = { regs.pc, regs.sp, regs.fp };
+	unwinder.walk(maps, frame, &stackcopy[0], regs.sp, copied, stack);
+}
+
+void PtraceSampler::sampleRound(SampleSink &sink)
+{
+	unsigned long long start = monotonicNow();
+	if (start >= next_rescan)
+		rescanThreads(start);
+	maps_reloaded = false;
+
+	CallStack stack;
+	size_t kept = 0;
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		Thread thread = threads[i];
+
+		bool group_stop;
+		if (!stopThread(thread.tid, group_stop))
+			continue; // exited
+
+		unsigned long long stopped = monotonicNow();
+		Registers regs;
+		size_t copied;
+		bool alive = captureStack(thread.tid, regs, copied);
+		resumeThread(thread.tid, group_stop);
+		if (!alive)
+			continue;
+
+		// The copy is ours, so the thread needn't wait for the walk.
+		walkFrames(regs, copied, stack);
+
+		SAMPLE_TYPE weight = (stopped - thread.last_sample) * 1e-9;
+		thread.last_sample = stopped;
+		sink.addSample(stopped, (unsigned long)thread.tid, stack, weight);
+
+		threads[kept++] = thread;
+	}
+	threads.resize(kept);
+}
+
+void PtraceSampler::detach()
+{
+	// A thread must be stopped for PTRACE_DETACH.
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		bool group_stop;
+		if (stopThread(threads[i].tid, group_stop))
+			ptrace(PTRACE_DETACH, threads[i].tid, 0, group_stop ? SIGSTOP : 0);
+	}
+	threads.clear();
+}
+
+void PtraceSampler::getStats(std::vector<std::string> &lines) const
+{
+	unwinder.getStats(lines);
+}
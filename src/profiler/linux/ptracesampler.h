@@ -0,0 +1,95 @@
+/*=====================================================================
+ptracesampler.h
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __PTRACESAMPLER_H_666_
+#define __PTRACESAMPLER_H_666_
+
+#include "samplerbackend.h"
+#include "cfiunwinder.h"
+#include "procmaps.h"
+#include <sys/types.h>
+#include <vector>
+
+/*=====================================================================
+PtraceSampler
+-------------
+Samples a Linux process the way Profiler samples a Windows one: each
+round, every thread is stopped in turn (PTRACE_INTERRUPT), its
+registers are read and the top of its stack is copied out with
+process_vm_readv, and it is let go again before the copy is walked
+by a CfiUnwinder.
+
+Threads are attached with PTRACE_SEIZE, which unlike PTRACE_ATTACH
+doesn't send them a SIGSTOP. Threads started later are picked up by
+rescanning /proc/<pid>/task every so often.
+=====================================================================*/
+class PtraceSampler : public SamplerBackend
+{
+public:
+	PtraceSampler();
+	virtual ~PtraceSampler();
+
+	virtual void attach(unsigned long process_id);//throws ProfilerExcep
+	virtual void sampleRound(SampleSink &sink);
+	virtual void detach();
+	virtual size_t getNumThreads() const { return threads.size(); }
+	virtual void getStats(std::vector<std::string> &lines) const;
+
+private:
+	struct Thread
+	{
+		pid_t tid;
+		/// When this thread was last sampled; the next sample is weighted by the time since.
+		unsigned long long last_sample;
+	};
+
+	pid_t pid;
+	std::vector<Thread> threads;
+	unsigned long long next_rescan;
+
+	/// Used to bound stack copies to the mapping the stack pointer is in.
+	ProcMaps maps;
+	bool maps_reloaded;
+
+	std::vector<unsigned char> stackcopy;
+	CfiUnwinder unwinder;
+
+	void rescanThreads(unsigned long long now);
+	bool hasThread(pid_t tid) const;
+
+	struct Registers
+	{
+		PROFILER_ADDR pc, sp, fp;
+	};
+
+	/// Returns false if the thread has exited.
+	bool stopThread(pid_t tid, bool &group_stop);
+	void resumeThread(pid_t tid, bool group_stop);
+
+	/// Read the registers of a stopped thread and copy the top of its stack
+	/// into stackcopy; copied receives how much, from regs.sp onwards.
+	/// Returns false if the thread has exited.
+	bool captureStack(pid_t tid, Registers &regs, size_t &copied);
+	void walkFrames(const Registers &regs, size_t copied, CallStack &stack);
+};
+
+#endif //__PTRACESAMPLER_H_666_
@@ -0,0 +1,75 @@
+/*=====================================================================
+samplerbackend.h
+----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __SAMPLERBACKEND_H_666_
+#define __SAMPLERBACKEND_H_666_
+
+#include "../profilertypes.h"
+#include <string>
+#include <vector>
+
+/*=====================================================================
+SampleSink
+----------
+Receives the samples taken by a SamplerBackend.
+=====================================================================*/
+class SampleSink
+{
+public:
+	virtual ~SampleSink() {}
+
+	/// time is in nanoseconds on the backend's clock; weight is in seconds.
+	/// The stack is innermost frame first.
+	virtual void addSample(unsigned long long time, unsigned long thread_id, const CallStack &stack, SAMPLE_TYPE weight) = 0;
+};
+
+/*=====================================================================
+SamplerBackend
+--------------
+How sleepycapture samples a process: PtraceSampler stops each thread in
+turn, PerfSampler has the kernel do it. What becomes of the samples
+(aggregation into a CallStackTrie, writing the capture) is up to the
+SampleSink.
+=====================================================================*/
+class SamplerBackend
+{
+public:
+	virtual ~SamplerBackend() {}
+
+	/// Start sampling the process.
+	virtual void attach(unsigned long process_id) = 0;//throws ProfilerExcep
+
+	/// Sample every thread once, or hand over the samples taken since the
+	/// last call, depending on whether the backend or the OS keeps time.
+	virtual void sampleRound(SampleSink &sink) = 0;//throws ProfilerExcep
+
+	/// Stop sampling and let the process run undisturbed.
+	virtual void detach() = 0;
+
+	/// Number of threads being sampled; 0 once the process has exited.
+	virtual size_t getNumThreads() const = 0;
+
+	/// Lines to add to Stats.txt about how sampling went.
+	virtual void getStats(std::vector<std::string> &/*lines*/) const {}
+};
+
+#endif //__SAMPLERBACKEND_H_666_
@@ -0,0 +1,248 @@
+/*=====================================================================
+sleepycapture.cpp
+-----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+// Headless capture tool for Linux. Samples a running process and saves
+// a capture file that the GUI opens like any other:
+//
+//	sleepycapture -p <pid> [-o <file>] [-r <rate in Hz>] [-d <seconds>] [-b ptrace|perf] [-c <dir>]
+//
+// Sampling stops after the given duration, on Ctrl+C, or when the
+// process exits. The ptrace backend (the default) stops each thread to
+// sample it, like the Windows profiler; the perf backend has the kernel
+// sample running threads without stopping them.
+//
+// Symbols are cached for the next capture of the same builds, in -c's
+// directory, by default ~/.cache/sleepy/symbols; -c "" turns that off.
+
+#include "../callstacktrie.h"
+#include "ptracesampler.h"
+#include "perfsampler.h"
+#include "capturewriter.h"
+#include "monotonic.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <memory>
+#include <string>
+
+// How often the perf backend's ring buffers are drained.
+static const double kPerfDrainRate = 100;
+
+// How often to reread the process's memory map while sampling.
+static const unsigned long long kMapsIntervalNs = 1000 * 1000 * 1000;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void onSignal(int)
+{
+	stop_requested = 1;
+}
+
+class TrieSink : public SampleSink
+{
+public:
+	TrieSink(CallStackTrie &callstacks_) : callstacks(callstacks_), numSamples(0) {}
+
+	virtual void addSample(unsigned long long, unsigned long, const CallStack &stack, SAMPLE_TYPE weight)
+	{
+		callstacks.addSample(stack, weight);
+		numSamples++;
+	}
+
+	CallStackTrie &callstacks;
+	unsigned long long numSamples;
+};
+
+static void sleepUntil(unsigned long long deadline)
+{
+	struct timespec ts;
+	ts.tv_sec = (time_t)(deadline / 1000000000ULL);
+	ts.tv_nsec = (long)(deadline % 1000000000ULL);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR && !stop_requested)
+		;
+}
+
+static void usage()
+{
+	fprintf(stderr, "Usage: sleepycapture -p <pid> [-o <file>] [-r <rate in Hz>] [-d <seconds>] [-b ptrace|perf] [-c <dir>]\n");
+	exit(1);
+}
+
+static std::string getDefaultCacheDir()
+{
+	const char *base = getenv("XDG_CACHE_HOME");
+	if (base && base[0])
+		return std::string(base) + "/sleepy/symbols";
+	const char *home = getenv("HOME");
+	if (home && home[0])
+		return std::string(home) + "/.cache/sleepy/symbols";
+	return "";
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long pid = 0;
+	std::string output = "capture.sleepy";
+	double rate = 1000;
+	double duration = -1;
+	std::string backendName = "ptrace";
+	std::string cacheDir = getDefaultCacheDir();
+
+	int opt;
+	while ((opt = getopt(argc, argv, "p:o:r:d:b:c:")) != -1)
+	{
+		switch (opt)
+		{
+		case 'p': pid = strtoul(optarg, NULL, 10); break;
+		case 'o': output = optarg; break;
+		case 'r': rate = atof(optarg); break;
+		case 'd': duration = atof(optarg); break;
+		case 'b': backendName = optarg; break;
+		case 'c': cacheDir = optarg; break;
+		default: usage();
+		}
+	}
+	if (!pid || rate <= 0 || (backendName != "ptrace" && backendName != "perf"))
+		usage();
+	const bool usePerf = backendName == "perf";
+
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+
+	std::unique_ptr<SamplerBackend> backend;
+	if (usePerf)
+		backend.reset(new PerfSampler(rate));
+	else
+		backend.reset(new PtraceSampler());
+	try {
+		backend->attach(pid);
+	} catch (const ProfilerExcep &e) {
+		fprintf(stderr, "Error: %ls\n", e.what().c_str());
+		return 1;
+	}
+
+	CallStackTrie callstacks;
+	TrieSink sink(callstacks);
+
+	// Symbols are looked up after sampling, by which time the process may
+	// have exited, so keep a recent copy of its memory map.
+	ProcMaps maps;
+	maps.load(pid);
+	unsigned long long next_maps = 0;
+
+	// Pace rounds with absolute deadlines, as SampleScheduler does,
+	// so that time spent sampling doesn't slow the rate down.
+	// The kernel keeps time for perf events; we only need to keep up with it.
+	const unsigned long long period = (unsigned long long)(1e9 / (usePerf ? kPerfDrainRate : rate));
+	const unsigned long long start = monotonicNow();
+	unsigned long long deadline = start;
+	unsigned long long numRounds = 0, numMissed = 0;
+
+	while (!stop_requested && backend->getNumThreads() > 0)
+	{
+		try {
+			backend->sampleRound(sink);
+		} catch (const ProfilerExcep &e) {
+			fprintf(stderr, "Error: %ls\n", e.what().c_str());
+			break;
+		}
+		numRounds++;
+
+		unsigned long long now = monotonicNow();
+		if (duration >= 0 && now - start >= duration * 1e9)
+			break;
+
+		if (now >= next_maps)
+		{
+			maps.load(pid);
+			next_maps = now + kMapsIntervalNs;
+		}
+
+		deadline += period;
+		if (now >= deadline + period)
+		{
+			// Too far behind to catch up; skip the rounds we missed.
+			numMissed += (now - deadline) / period;
+			deadline = now;
+		}
+		sleepUntil(deadline);
+	}
+
+	double elapsed = (monotonicNow() - start) * 1e-9;
+	backend->detach();
+
+	// Includes every module loaded meanwhile, unless the process has gone.
+	maps.load(pid);
+
+	ElfSymbolizer symbolizer;
+	symbolizer.setProcess(pid);
+	symbolizer.setCacheDirectory(cacheDir);
+	CaptureWriter writer(callstacks, maps, symbolizer);
+
+	char exe[4096] = "?";
+	char link[64];
+	snprintf(link, sizeof(link), "/proc/%lu/exe", pid);
+	ssize_t len = readlink(link, exe, sizeof(exe) - 1);
+	if (len > 0)
+		exe[len] = 0;
+
+	time_t rawtime;
+	time(&rawtime);
+	std::string date = asctime(localtime(&rawtime));
+	if (!date.empty() && date[date.size() - 1] == '\n')
+		date.erase(date.size() - 1);
+
+	char line[256];
+	writer.stats.push_back(std::string("Filename: ") + exe);
+	snprintf(line, sizeof(line), "Duration: %g", elapsed);
+	writer.stats.push_back(line);
+	writer.stats.push_back("Date: " + date);
+	snprintf(line, sizeof(line), "Samples: %llu", sink.numSamples);
+	writer.stats.push_back(line);
+	writer.stats.push_back("Sampler: " + backendName);
+	if (usePerf)
+	{
+		snprintf(line, sizeof(line), "Sample rate: %g Hz of CPU time requested", rate);
+		writer.stats.push_back(line);
+	}
+	else
+	{
+		snprintf(line, sizeof(line), "Sample rate: %g Hz requested, %.1f Hz achieved", rate, elapsed > 0 ? numRounds / elapsed : 0);
+		writer.stats.push_back(line);
+		snprintf(line, sizeof(line), "Missed deadlines: %llu", numMissed);
+		writer.stats.push_back(line);
+	}
+	backend->getStats(writer.stats);
+
+	if (!writer.save(output))
+	{
+		fprintf(stderr, "Error writing to %s\n", output.c_str());
+		return 1;
+	}
+	symbolizer.saveCache();
+
+	printf("%llu samples saved to %s\n", sink.numSamples, output.c_str());
+	return 0;
+}
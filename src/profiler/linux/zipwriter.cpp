@@ -0,0 +1,171 @@
+/*=====================================================================
+zipwriter.cpp
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "zipwriter.h"
+#include <time.h>
+
+static unsigned long crc32(const void *data, size_t size)
+{
+	static unsigned long table[256];
+	if (!table[1])
+	{
+		for (unsigned long n = 0; n < 256; n++)
+		{
+			unsigned long c = n;
+			for (int k = 0; k < 8; k++)
+				c = (c & 1) ? 0xEDB88320UL ^ (c >> 1) : c >> 1;
+			table[n] = c;
+		}
+	}
+
+	const unsigned char *p = (const unsigned char *)data;
+	unsigned long crc = 0xFFFFFFFFUL;
+	for (size_t i = 0; i < size; i++)
+		crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFFUL;
+}
+
+// ZIP entries carry MS-DOS timestamps.
+static void dosDateTime(unsigned &date, unsigned &time_)
+{
+	time_t now = time(NULL);
+	struct tm tm;
+	localtime_r(&now, &tm);
+	date = ((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) | tm.tm_mday;
+	time_ = (tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2);
+}
+
+ZipWriter::ZipWriter()
+:	file(NULL),
+	offset(0),
+	ok(false)
+{
+}
+
+ZipWriter::~ZipWriter()
+{
+	if (file)
+		fclose(file);
+}
+
+bool ZipWriter::open(const std::string &path)
+{
+	file = fopen(path.c_str(), "wb");
+	ok = file != NULL;
+	return ok;
+}
+
+void ZipWriter::write(const void *data, size_t size)
+{
+	if (size && fwrite(data, 1, size, file) != size)
+		ok = false;
+	offset += (unsigned long)size;
+}
+
+void ZipWriter::write16(unsigned value)
+{
+	unsigned char bytes[2] = { (unsigned char)value, (unsigned char)(value >> 8) };
+	write(bytes, 2);
+}
+
+void ZipWriter::write32(unsigned long value)
+{
+	unsigned char bytes[4] = { (unsigned char)value, (unsigned char)(value >> 8), (unsigned char)(value >> 16), (unsigned char)(value >> 24) };
+	write(bytes, 4);
+}
+
+void ZipWriter::addEntry(const std::string &name, const void *data, size_t size)
+{
+	if (!file)
+		return;
+
+	Entry entry;
+	entry.name = name;
+	entry.crc = crc32(data, size);
+	entry.size = (unsigned long)size;
+	entry.offset = offset;
+	entries.push_back(entry);
+
+	unsigned date, time_;
+	dosDateTime(date, time_);
+
+	write32(0x04034b50);      // local file header
+	write16(10);              // version needed
+	write16(0x0800);          // flags: names are UTF-8
+	write16(0);               // stored
+	write16(time_);
+	write16(date);
+	write32(entry.crc);
+	write32(entry.size);      // compressed
+	write32(entry.size);      // uncompressed
+	write16((unsigned)name.size());
+	write16(0);               // extra field length
+	write(name.data(), name.size());
+	write(data, size);
+}
+
+bool ZipWriter::close()
+{
+	if (!file)
+		return false;
+
+	unsigned date, time_;
+	dosDateTime(date, time_);
+
+	unsigned long dir_offset = offset;
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		const Entry &entry = entries[i];
+		write32(0x02014b50);  // central directory header
+		write16(0x0314);      // made by: Unix, 2.0
+		write16(10);          // version needed
+		write16(0x0800);
+		write16(0);
+		write16(time_);
+		write16(date);
+		write32(entry.crc);
+		write32(entry.size);
+		write32(entry.size);
+		write16((unsigned)entry.name.size());
+		write16(0);           // extra field length
+		write16(0);           // comment length
+		write16(0);           // disk number
+		write16(0);           // internal attributes
+		write32(0100644UL << 16); // external attributes: a regular file
+		write32(entry.offset);
+		write(entry.name.data(), entry.name.size());
+	}
+	unsigned long dir_size = offset - dir_offset;
+
+	write32(0x06054b50);      // end of central directory
+	write16(0);
+	write16(0);
+	write16((unsigned)entries.size());
+	write16((unsigned)entries.size());
+	write32(dir_size);
+	write32(dir_offset);
+	write16(0);               // comment length
+
+	if (fclose(file) != 0)
+		ok = false;
+	file = NULL;
+	return ok;
+}
@@ -0,0 +1,72 @@
+/*=====================================================================
+zipwriter.h
+-----------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __ZIPWRITER_H_666_
+#define __ZIPWRITER_H_666_
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+/*=====================================================================
+ZipWriter
+---------
+Writes a ZIP archive of uncompressed ("stored") entries, which is all
+a capture file needs to be readable by wxZipInputStream. The GUI build
+uses wxZipOutputStream instead; this is for tools built without wx.
+=====================================================================*/
+class ZipWriter
+{
+public:
+	ZipWriter();
+	~ZipWriter();
+
+	bool open(const std::string &path);
+
+	/// Each entry is written in one go, so that its size and CRC are
+	/// known up front and no data descriptor is needed.
+	void addEntry(const std::string &name, const void *data, size_t size);
+	void addEntry(const std::string &name, const std::string &data) { addEntry(name, data.data(), data.size()); }
+
+	/// Write the central directory. Returns false if anything failed to write.
+	bool close();
+
+private:
+	struct Entry
+	{
+		std::string name;
+		unsigned long crc;
+		unsigned long size;
+		unsigned long offset;
+	};
+
+	FILE *file;
+	std::vector<Entry> entries;
+	unsigned long offset;
+	bool ok;
+
+	void write(const void *data, size_t size);
+	void write16(unsigned value);
+	void write32(unsigned long value);
+};
+
+#endif //__ZIPWRITER_H_666_
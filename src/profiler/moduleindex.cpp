@@ -0,0 +1,44 @@
+/*=====================================================================
+moduleindex.cpp
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "moduleindex.h"
+#include <algorithm>
+
+ModuleIndex::ModuleIndex(const std::vector<Range> &ranges_)
+:	ranges(ranges_)
+{
+	std::sort(ranges.begin(), ranges.end(), startBefore);
+
+	starts.reserve(ranges.size());
+	for (size_t i = 0; i < ranges.size(); i++)
+		starts.push_back(ranges[i].start);
+}
+
+Module *ModuleIndex::find(PROFILER_ADDR addr) const
+{
+	// The last range starting at or below addr is the only one that can hold it.
+	std::vector<PROFILER_ADDR>::const_iterator it = std::upper_bound(starts.begin(), starts.end(), addr);
+	if (it == starts.begin())
+		return NULL;
+
+	const Range &range = ranges[(it - starts.begin()) - 1];
+	return addr < range.end ? range.module : NULL;
+}
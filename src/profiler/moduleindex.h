@@ -0,0 +1,66 @@
+/*=====================================================================
+moduleindex.h
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __MODULEINDEX_H_666_
+#define __MODULEINDEX_H_666_
+
+#include "profilertypes.h"
+#include <vector>
+
+class Module;
+
+/*=====================================================================
+ModuleIndex
+-----------
+Finds the module an address lies in, by binary search over the
+modules' start addresses, kept in an array of their own so that the
+search touches as few cache lines as possible.
+
+An index never changes once built. To take in new modules, build a
+new one and swap the pointer to it; walkers part way through a lookup
+carry on with the old one, which has to outlive them.
+=====================================================================*/
+class ModuleIndex
+{
+public:
+	struct Range
+	{
+		PROFILER_ADDR start, end; ///< [start, end)
+		Module *module;
+	};
+
+	/// The ranges needn't be sorted, but mustn't overlap.
+	explicit ModuleIndex(const std::vector<Range> &ranges);
+
+	/// NULL if addr isn't in any of the modules.
+	Module *find(PROFILER_ADDR addr) const;
+
+	size_t getNumModules() const { return ranges.size(); }
+
+private:
+	std::vector<PROFILER_ADDR> starts;
+	std::vector<Range> ranges; ///< in the same order as starts
+
+	static bool startBefore(const Range &a, const Range &b) { return a.start < b.start; }
+};
+
+#endif //__MODULEINDEX_H_666_
@@ -1,341 +1,862 @@
-/*=====================================================================
-profiler.cpp
-------------
-File created by ClassTemplate on Thu Feb 24 19:00:30 2005
-
-Copyright (C) Nicholas Chapman
-Copyright (C) 2015 Ashod Nakashian
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html..
-=====================================================================*/
-
-#include "profiler.h"
-
-
-#include "../utils/stringutils.h"
-#include "../utils/osutils.h"
-#include "symbolinfo.h"
-#include <process.h>
-#include <iostream>
-#include <assert.h>
-#include <winnt.h>
-#include "../utils/dbginterface.h"
-#include "../utils/WoW64.h"
-
-#ifdef _WIN64
-#define CONTEXT64_FLAGS		(CONTEXT_AMD64 | CONTEXT_FULL)
-#define CONTEXT32_FLAGS		(WOW64_CONTEXT_i386 | WOW64_CONTEXT_FULL)
-typedef CONTEXT CONTEXT64;
-typedef WOW64_CONTEXT CONTEXT32;
-#else
-#define CONTEXT32_FLAGS		(CONTEXT_i386 | CONTEXT_FULL)
-typedef CONTEXT CONTEXT32;
-#endif
-
-
-// DE: 20090325: Profiler no longer owns callstack and flatcounts since it is shared between multipler profilers
-
-Profiler::Profiler(HANDLE target_process_, HANDLE target_thread_,
-				   std::map<CallStack, SAMPLE_TYPE>& callstacks_, std::map<PROFILER_ADDR, SAMPLE_TYPE>& flatcounts_)
-:	target_process(target_process_),
-	target_thread(target_thread_),
-	callstacks(callstacks_),
-	flatcounts(flatcounts_),
-	is64BitProcess(Is64BitProcess(target_process_))
-{
-}
-
-// DE: 20090325: Need copy constructor since it is put in a std::vector
-
-Profiler::Profiler(const Profiler& iOther)
-:	target_process(iOther.target_process),
-	target_thread(iOther.target_thread),
-	callstacks(iOther.callstacks),
-	flatcounts(iOther.flatcounts),
-	is64BitProcess(iOther.is64BitProcess)
-{
-}
-
-// DE: 20090325: Need copy assignement since it is put in a std::vector
-
-Profiler& Profiler::operator=(const Profiler& iOther)
-{
-	target_process = iOther.target_process;
-	target_thread = iOther.target_thread;
-	callstacks = iOther.callstacks;
-	flatcounts = iOther.flatcounts;
-
-	return *this;
-}
-
-Profiler::~Profiler()
-{
-
-}
-
-// There are a couple of things than can cause StackWalk64 to not produce a correct callstack,
-// if we happen to have stopped the process in an unfortunate place.
-//
-// We can hack around them ourselves here. This isn't essential, but helps clean up some
-// otherwise bad callstacks.
-void applyHacks(HANDLE process_handle, CONTEXT32 &context)
-{
-	// If we happen to be unlucky enough to stop in a DLL import forward,
-	// (for example, if you call GetLastError in KERNEL32 nowadays, it actually forwards
-	// to GetLastError in KERNELBASE via a little jump routine), then we have a problem.
-	// DbgHelp will not provide the necessary FPO data to traverse the callstack from there,
-	// presumably because these routine were generated by a tool other than the C++ compiler,
-	// and there's no EBP frame to help either. This can cause parts of the callstack to go missing.
-	//
-	// So what we do is to search forward a few bytes, and if we see a jump, we pretend
-	// we took the sample from there instead. This hopefully will give a much better result.
-	//
-	// Visual Studio seems not to suffer from the same problem generally, although you can still
-	// trip it up on occasion, which makes me think they also have some kind of hack in there.
-	BYTE tmp[16];
-	SIZE_T numRead=0;
-
-	// First, skip over any stub functions (a useless push/mov/pop header, followed by a jump).
-	// Move instead to the jump target.
-	if (ReadProcessMemory(process_handle, (LPCVOID)context.Eip, tmp, 16, &numRead) && numRead >= 16)
-	{
-		int n = 0;
-
-		// Sometimes there's a small function header first, skip over that.
-		if (tmp[n] == 0x8b && tmp[n+1] == 0xff) // mov edi, edi
-			n += 2;
-		if (tmp[n] == 0x55) // push ebp
-			n++;
-		if (tmp[n] == 0x8b && tmp[n+1] == 0xec) // mov ebp, esp
-			n += 2;
-		if (tmp[n] == 0x5d) // pop ebp
-			n++;
-
-		// Look for "jmp foo", and move the IP forward to 'foo'.
-		BYTE *p = &tmp[n];
-		if (p[0] == 0xeb)
-		{
-			char offset = (char)p[1];
-			context.Eip += n+2 + (int)offset;
-		}
-	}
-
-	// Skip over any jmp [__imp__blah] thunks.
-	if (ReadProcessMemory(process_handle, (LPCVOID)context.Eip, tmp, 16, &numRead) && numRead >= 16)
-	{
-		// Look for "jmp [foo]", and move the IP forward to '[foo]'.
-		if (tmp[0] == 0xff && tmp[1] == 0x25)
-		{
-			DWORD ptr = (tmp[5] << 24) | (tmp[4] << 16) | (tmp[3] << 8) | (tmp[2] << 0);
-			if (ReadProcessMemory(process_handle, (LPCVOID)ptr, tmp, 4, &numRead) && numRead >= 4)
-			{
-				context.Eip = (tmp[3] << 24) | (tmp[2] << 16) | (tmp[1] << 8) | (tmp[0] << 0);
-			}
-		}
-	}
-}
-
-bool Profiler::sampleTarget(SAMPLE_TYPE timeSpent, SymbolInfo *syminfo)
-{
-	// DE: 20090325: Moved declaration of stack variables to reduce size of code inside Suspend/Resume thread
-
-	CallStack stack;
-	stack.depth = 0;
-
-	STACKFRAME64 frame;
-	PROFILER_ADDR ip, sp, bp;
-	void *context;
-	DWORD machine;
-
-#if defined(_WIN64)
-	CONTEXT64 threadcontext64;
-	CONTEXT32 threadcontext32;
-	if (is64BitProcess)
-	{
-		context = &threadcontext64;
-		threadcontext64.ContextFlags = CONTEXT64_FLAGS;
-		machine = IMAGE_FILE_MACHINE_AMD64;
-
-		// Can fail occasionally, for example if you have a debugger attached to the process.
-		HRESULT result = SuspendThread(target_thread);
-		if(result == 0xffffffff)
-			return false;
-
-		int prev_priority = GetThreadPriority(target_thread);
-		SetThreadPriority(target_thread, THREAD_PRIORITY_TIME_CRITICAL);
-		result = GetThreadContext(target_thread, &threadcontext64);
-		SetThreadPriority(target_thread, prev_priority);
-
-		if(!result){
-			// DE: 20090325: If GetThreadContext fails we must be sure to resume thread again
-			ResumeThread(target_thread);
-			return false;
-		}
-
-		ip = threadcontext64.Rip;
-		sp = threadcontext64.Rsp;
-		bp = threadcontext64.Rbp;
-	} else {
-		context = &threadcontext32;
-		threadcontext32.ContextFlags = CONTEXT32_FLAGS;
-		machine = IMAGE_FILE_MACHINE_I386;
-
-		// Can fail occasionally, for example if you have a debugger attached to the process.
-		HRESULT result = fn_Wow64SuspendThread(target_thread);
-		if(result == 0xffffffff)
-			return false;
-
-		int prev_priority = GetThreadPriority(target_thread);
-		SetThreadPriority(target_thread, THREAD_PRIORITY_TIME_CRITICAL);
-		result = fn_Wow64GetThreadContext(target_thread, &threadcontext32);
-		SetThreadPriority(target_thread, prev_priority);
-
-		if(!result){
-			// DE: 20090325: If GetThreadContext fails we must be sure to resume thread again
-			ResumeThread(target_thread);
-			return false;
-		}
-
-		ip = threadcontext32.Eip;
-		sp = threadcontext32.Esp;
-		bp = threadcontext32.Ebp;
-	}
-#else
-	CONTEXT32 threadcontext32;
-	context = &threadcontext32;
-	threadcontext32.ContextFlags = CONTEXT32_FLAGS;
-	machine = IMAGE_FILE_MACHINE_I386;
-
-	// Can fail occasionally, for example if you have a debugger attached to the process.
-	HRESULT result = SuspendThread(target_thread);
-	if(result == 0xffffffff)
-		return false;
-
-	int prev_priority = GetThreadPriority(target_thread);
-	SetThreadPriority(target_thread, THREAD_PRIORITY_TIME_CRITICAL);
-	result = GetThreadContext(target_thread, &threadcontext32);
-	SetThreadPriority(target_thread, prev_priority);
-
-	if(!result){
-		// DE: 20090325: If GetThreadContext fails we must be sure to resume thread again
-		ResumeThread(target_thread);
-		return false;
-	}
-
-	applyHacks(target_process, threadcontext32);
-
-	ip = threadcontext32.Eip;
-	sp = threadcontext32.Esp;
-	bp = threadcontext32.Ebp;
-#endif
-
-	DbgHelp *prevDbgHelp = NULL;
-	bool first = true;
-
-	for (;;)
-	{
-		// See which module this IP is in.
-		Module *mod = syminfo->getModuleForAddr(ip);
-		DbgHelp *dbgHelp = mod ? mod->dbghelp : &dbgHelpMs;
-		if (!dbgHelp->Loaded)
-			break;
-
-		// Use whichever dbghelp stack walker is best for this module type.
-		// If we're switching between types, restart the stack walk from
-		// the current place.
-		if (dbgHelp != prevDbgHelp)
-		{
-			prevDbgHelp = dbgHelp;
-			memset(&frame, 0, sizeof(frame));
-			frame.AddrStack.Offset = sp;
-			frame.AddrPC.Offset = ip;
-			frame.AddrFrame.Offset = bp;
-			frame.AddrStack.Mode = frame.AddrPC.Mode = frame.AddrFrame.Mode = AddrModeFlat;
-			frame.AddrReturn.Offset = ip;
-			first = true;
-		}
-
-		// Add this IP to the stack trace.
-		// We skip the first one, as the first call to StackWalk64
-		// simply fills in more registers for the current frame,
-		// rather than walking down to the next one.
-		if (!first)
-			stack.addr[stack.depth++] = ip;
-		first = false;
-
-		BOOL result = dbgHelp->StackWalk64(
-			machine,
-			target_process,
-			target_thread,
-			&frame,
-			context,
-			NULL,
-			dbgHelp->SymFunctionTableAccess64,
-			dbgHelp->SymGetModuleBase64,
-			NULL
-		);
-
-		if (!result || stack.depth >= MAX_CALLSTACK_LEVELS)
-			break;
-
-		ip = (PROFILER_ADDR)frame.AddrPC.Offset;
-		sp = (PROFILER_ADDR)frame.AddrStack.Offset;
-		bp = (PROFILER_ADDR)frame.AddrFrame.Offset;
-
-		// Stop once we hit the end of the stack.
-		if (frame.AddrReturn.Offset == 0)
-		{
-			stack.addr[stack.depth++] = ip;
-			break;
-		}
-	}
-
-	// TODO: Don't count samples for suspended threads
-
-	if (ResumeThread(target_thread) == 0xffffffff)
-		throw ProfilerExcep(L"ResumeThread failed.");
-
-	//NOTE: this has to go after ResumeThread.  Otherwise mem allocation needed by std::map
-	//may hit a lock held by the suspended thread.
-	if (stack.depth > 0)
-	{
-		flatcounts[stack.addr[0]]+=timeSpent;
-		callstacks[stack]+=timeSpent;
-	}
-	return true;
-}
-
-// returns true if the target thread has finished
-bool Profiler::targetExited() const
-{
-	DWORD code = WaitForSingleObject(target_thread, 0);
-	return (code == WAIT_OBJECT_0);
-}
-
-
-//void Profiler::saveIPs(std::ostream& stream)
-//{
-//	for (auto i = counts.begin(); i != counts.end(); ++i)
-//	{
-//		const Sample &sample = i->first;
-//		int count = i->second;
-//		stream << ::toHexString(sample.addr) << " " << count << "\n";
-//	}
-//
-//	stream.flush();
-//}
-//
+/*=====================================================================
+profiler.cpp
+------------
+File created by ClassTemplate on Thu Feb 24 19:00:30 2005
+
+Copyright (C) Nicholas Chapman
+Copyright (C) 2015 Ashod Nakashian
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "profiler.h"
+
+
+#include "../utils/stringutils.h"
+#include "../utils/osutils.h"
+#include "symbolinfo.h"
+#include "callstacktrie.h"
+#include "unwindthread.h"
+#include "sampletimings.h"
+#include "samplelog.h"
+#include "stacksnapshot.h"
+#include "framewalker.h"
+#include "unwindcache.h"
+#include <process.h>
+#include <algorithm>
+#include <iostream>
+#include <assert.h>
+#include <winnt.h>
+#include "../utils/dbginterface.h"
+#include "../utils/WoW64.h"
+
+
+// DE: 20090325: Profiler no longer owns callstack and flatcounts since it is shared between multipler profilers
+
+Profiler::Profiler(HANDLE target_process_, HANDLE target_thread_, CallStackTrie& callstacks_, SampleTimings& timings_, SampleLog *samplelog_, UnwindCache *unwind_cache_)
+:	target_process(target_process_),
+	target_thread(target_thread_),
+	thread_id(GetThreadId(target_thread_)),
+	callstacks(callstacks_),
+	timings(timings_),
+	samplelog(samplelog_),
+	unwind_cache(unwind_cache_),
+	is64BitProcess(Is64BitProcess(target_process_)),
+	stack_region_base(0),
+	stack_limit(0),
+	last_sample(0)
+{
+}
+
+// DE: 20090325: Need copy constructor since it is put in a std::vector
+
+Profiler::Profiler(const Profiler& iOther)
+:	target_process(iOther.target_process),
+	target_thread(iOther.target_thread),
+	thread_id(iOther.thread_id),
+	callstacks(iOther.callstacks),
+	timings(iOther.timings),
+	samplelog(iOther.samplelog),
+	unwind_cache(iOther.unwind_cache),
+	is64BitProcess(iOther.is64BitProcess),
+	stack_region_base(iOther.stack_region_base),
+	stack_limit(iOther.stack_limit),
+	last_sample(iOther.last_sample)
+{
+}
+
+// DE: 20090325: Need copy assignement since it is put in a std::vector
+
+Profiler& Profiler::operator=(const Profiler& iOther)
+{
+	target_process = iOther.target_process;
+	target_thread = iOther.target_thread;
+	thread_id = iOther.thread_id;
+	samplelog = iOther.samplelog;
+	unwind_cache = iOther.unwind_cache;
+	// callstacks and timings are references to the trie and timings shared
+	// by all profilers of a ProfilerThread, so there is nothing to reseat here.
+	stack_region_base = iOther.stack_region_base;
+	stack_limit = iOther.stack_limit;
+	last_sample = iOther.last_sample;
+
+	return *this;
+}
+
+Profiler::~Profiler()
+{
+
+}
+
+// There are a couple of things than can cause StackWalk64 to not produce a correct callstack,
+// if we happen to have stopped the process in an unfortunate place.
+//
+// We can hack around them ourselves here. This isn't essential, but helps clean up some
+// otherwise bad callstacks.
+void applyHacks(HANDLE process_handle, CONTEXT32 &context)
+{
+	// If we happen to be unlucky enough to stop in a DLL import forward,
+	// (for example, if you call GetLastError in KERNEL32 nowadays, it actually forwards
+	// to GetLastError in KERNELBASE via a little jump routine), then we have a problem.
+	// DbgHelp will not provide the necessary FPO data to traverse the callstack from there,
+	// presumably because these routine were generated by a tool other than the C++ compiler,
+	// and there's no EBP frame to help either. This can cause parts of the callstack to go missing.
+	//
+	// So what we do is to search forward a few bytes, and if we see a jump, we pretend
+	// we took the sample from there instead. This hopefully will give a much better result.
+	//
+	// Visual Studio seems not to suffer from the same problem generally, although you can still
+	// trip it up on occasion, which makes me think they also have some kind of hack in there.
+	BYTE tmp[16];
+	SIZE_T numRead=0;
+
+	// First, skip over any stub functions (a useless push/mov/pop header, followed by a jump).
+	// Move instead to the jump target.
+	if (ReadProcessMemory(process_handle, (LPCVOID)context.Eip, tmp, 16, &numRead) && numRead >= 16)
+	{
+		int n = 0;
+
+		// Sometimes there's a small function header first, skip over that.
+		if (tmp[n] == 0x8b && tmp[n+1] == 0xff) // mov edi, edi
+			n += 2;
+		if (tmp[n] == 0x55) // push ebp
+			n++;
+		if (tmp[n] == 0x8b && tmp[n+1] == 0xec) // mov ebp, esp
+			n += 2;
+		if (tmp[n] == 0x5d) // pop ebp
+			n++;
+
+		// Look for "jmp foo", and move the IP forward to 'foo'.
+		BYTE *p = &tmp[n];
+		if (p[0] == 0xeb)
+		{
+			char offset = (char)p[1];
+			context.Eip += n+2 + (int)offset;
+		}
+	}
+
+	// Skip over any jmp [__imp__blah] thunks.
+	if (ReadProcessMemory(process_handle, (LPCVOID)context.Eip, tmp, 16, &numRead) && numRead >= 16)
+	{
+		// Look for "jmp [foo]", and move the IP forward to '[foo]'.
+		if (tmp[0] == 0xff && tmp[1] == 0x25)
+		{
+			DWORD ptr = (tmp[5] << 24) | (tmp[4] << 16) | (tmp[3] << 8) | (tmp[2] << 0);
+			if (ReadProcessMemory(process_handle, (LPCVOID)ptr, tmp, 4, &numRead) && numRead >= 4)
+			{
+				context.Eip = (tmp[3] << 24) | (tmp[2] << 16) | (tmp[1] << 8) | (tmp[0] << 0);
+			}
+		}
+	}
+}
+
+// Suspends the target thread and reads its registers.
+// On failure the thread is left running and false is returned.
+bool Profiler::suspendTarget(ThreadContext &context)
+{
+#if defined(_WIN64)
+	if (is64BitProcess)
+	{
+		context.context64.ContextFlags = CONTEXT64_FLAGS;
+
+		// Can fail occasionally, for example if you have a debugger attached to the process.
+		HRESULT result = SuspendThread(target_thread);
+		if(result == 0xffffffff)
+			return false;
+
+		int prev_priority = GetThreadPriority(target_thread);
+		SetThreadPriority(target_thread, THREAD_PRIORITY_TIME_CRITICAL);
+		result = GetThreadContext(target_thread, &context.context64);
+		SetThreadPriority(target_thread, prev_priority);
+
+		if(!result){
+			// DE: 20090325: If GetThreadContext fails we must be sure to resume thread again
+			ResumeThread(target_thread);
+			return false;
+		}
+	} else {
+		context.context32.ContextFlags = CONTEXT32_FLAGS;
+
+		// Can fail occasionally, for example if you have a debugger attached to the process.
+		HRESULT result = fn_Wow64SuspendThread(target_thread);
+		if(result == 0xffffffff)
+			return false;
+
+		int prev_priority = GetThreadPriority(target_thread);
+		SetThreadPriority(target_thread, THREAD_PRIORITY_TIME_CRITICAL);
+		result = fn_Wow64GetThreadContext(target_thread, &context.context32);
+		SetThreadPriority(target_thread, prev_priority);
+
+		if(!result){
+			// DE: 20090325: If GetThreadContext fails we must be sure to resume thread again
+			ResumeThread(target_thread);
+			return false;
+		}
+	}
+#else
+	context.context32.ContextFlags = CONTEXT32_FLAGS;
+
+	// Can fail occasionally, for example if you have a debugger attached to the process.
+	HRESULT result = SuspendThread(target_thread);
+	if(result == 0xffffffff)
+		return false;
+
+	int prev_priority = GetThreadPriority(target_thread);
+	SetThreadPriority(target_thread, THREAD_PRIORITY_TIME_CRITICAL);
+	result = GetThreadContext(target_thread, &context.context32);
+	SetThreadPriority(target_thread, prev_priority);
+
+	if(!result){
+		// DE: 20090325: If GetThreadContext fails we must be sure to resume thread again
+		ResumeThread(target_thread);
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+static void getRegisters(bool is64BitProcess, const ThreadContext &context,
+						 PROFILER_ADDR &ip, PROFILER_ADDR &sp, PROFILER_ADDR &bp)
+{
+#if defined(_WIN64)
+	if (is64BitProcess)
+	{
+		ip = context.context64.Rip;
+		sp = context.context64.Rsp;
+		bp = context.context64.Rbp;
+		return;
+	}
+#endif
+	ip = context.context32.Eip;
+	sp = context.context32.Esp;
+	bp = context.context32.Ebp;
+}
+
+static void setRegisters(bool is64BitProcess, ThreadContext &context, const StackFrame &frame)
+{
+#if defined(_WIN64)
+	if (is64BitProcess)
+	{
+		context.context64.Rip = frame.ip;
+		context.context64.Rsp = frame.sp;
+		context.context64.Rbp = frame.fp;
+		return;
+	}
+#endif
+	context.context32.Eip = (DWORD)frame.ip;
+	context.context32.Esp = (DWORD)frame.sp;
+	context.context32.Ebp = (DWORD)frame.fp;
+}
+
+// StackWalk64's memory callback has no user parameter,
+// so the snapshot being walked is passed in a thread-local.
+static __declspec(thread) const StackSnapshot *t_snapshot;
+
+static BOOL CALLBACK readSnapshotMemory(HANDLE hProcess, DWORD64 qwBaseAddress, PVOID lpBuffer, DWORD nSize, LPDWORD lpNumberOfBytesRead)
+{
+	const StackSnapshot *snapshot = t_snapshot;
+	*lpNumberOfBytesRead = 0;
+
+	if (snapshot->contains((PROFILER_ADDR)qwBaseAddress))
+	{
+		DWORD64 offset = qwBaseAddress - snapshot->stack_addr;
+		if (offset + nSize > snapshot->stack_size)
+			return FALSE;
+		memcpy(lpBuffer, &snapshot->stack[(size_t)offset], nSize);
+		*lpNumberOfBytesRead = nSize;
+		return TRUE;
+	}
+
+	// Anything outside the stack (code, mostly) is not expected
+	// to have changed since the thread was resumed.
+	SIZE_T numRead = 0;
+	BOOL result = ReadProcessMemory(hProcess, (LPCVOID)qwBaseAddress, lpBuffer, nSize, &numRead);
+	*lpNumberOfBytesRead = (DWORD)numRead;
+	return result;
+}
+
+// Frame-pointer chains are checked against the bounds of the target's modules.
+// Neither needs DbgHelp, so the fast path doesn't take its lock.
+// A chain can break once in a while in a module that keeps frame pointers
+// (a sample taken in a prologue, say); only a module where it keeps on
+// breaking is given up on.
+static const LONG MAX_FRAME_POINTER_BREAKS = 16;
+
+class LoadedModules
+{
+public:
+	LoadedModules(SymbolInfo *syminfo_) : syminfo(syminfo_) {}
+
+	bool isCode(PROFILER_ADDR addr) const
+	{
+		// The index stretches modules of unknown size up to the next one,
+		// which would let a stray pointer pass for a return address.
+		Module *mod = syminfo->getModuleForAddr(addr);
+		return mod && mod->isCode(addr);
+	}
+	bool keepsFramePointers(PROFILER_ADDR ip) const
+	{
+		Module *mod = syminfo->getModuleForAddr(ip);
+		return mod && mod->frame_pointer_breaks < MAX_FRAME_POINTER_BREAKS;
+	}
+	void chainBroke(PROFILER_ADDR ip)
+	{
+		if (Module *mod = syminfo->getModuleForAddr(ip))
+			InterlockedIncrement(&mod->frame_pointer_breaks);
+	}
+
+private:
+	SymbolInfo *syminfo;
+};
+
+#if defined(_WIN64)
+// x64 unwind data, as described under "x64 exception handling" on MSDN.
+// Not every SDK's winnt.h has these.
+struct X64RuntimeFunction
+{
+	DWORD BeginAddress;
+	DWORD EndAddress;
+	DWORD UnwindInfoAddress;
+};
+
+enum
+{
+	UWOP_PUSH_NONVOL = 0, UWOP_ALLOC_LARGE, UWOP_ALLOC_SMALL, UWOP_SET_FPREG,
+	UWOP_SAVE_NONVOL, UWOP_SAVE_NONVOL_FAR, UWOP_EPILOG, UWOP_SPARE_CODE,
+	UWOP_SAVE_XMM128, UWOP_SAVE_XMM128_FAR, UWOP_PUSH_MACHFRAME
+};
+
+static const BYTE kUnwindChainInfo = 4; // UNW_FLAG_CHAININFO
+static const BYTE kRegRbp = 5;
+
+// One prologue operation, in the order the prologue does them.
+struct X64PrologueOp
+{
+	BYTE op, info;
+	DWORD operand;    // allocation size or save offset
+	BYTE frame_reg, frame_offset; // for UWOP_SET_FPREG
+};
+
+// Collects the operations of the prologue that have run by pc_offset bytes
+// into the function. A chained entry's parent has always run in full, and
+// comes first. Returns false for unwind data we don't understand.
+static bool readPrologue(HANDLE process, DWORD64 base, DWORD unwind_rva, DWORD64 pc_offset, bool whole,
+						 int depth, std::vector<X64PrologueOp> &ops)
+{
+	BYTE info[4 + 2 * 256 + sizeof(X64RuntimeFunction)];
+	SIZE_T numRead;
+	if (depth > 8 || !ReadProcessMemory(process, (LPCVOID)(base + unwind_rva), info, 4, &numRead) || numRead != 4)
+		return false;
+
+	BYTE version = info[0] & 7, flags = info[0] >> 3, count = info[2];
+	BYTE frame_reg = info[3] & 15, frame_offset = info[3] >> 4;
+	if (version != 1 && version != 2)
+		return false;
+
+	// Codes are padded to an even count, then followed by the parent of a chained entry.
+	SIZE_T size = 2 * ((count + 1) & ~1) + ((flags & kUnwindChainInfo) ? sizeof(X64RuntimeFunction) : 0);
+	if (size && (!ReadProcessMemory(process, (LPCVOID)(base + unwind_rva + 4), info + 4, size, &numRead) || numRead != size))
+		return false;
+
+	if (flags & kUnwindChainInfo)
+	{
+		const X64RuntimeFunction *parent = (const X64RuntimeFunction *)(info + 4 + 2 * ((count + 1) & ~1));
+		if (!readPrologue(process, base, parent->UnwindInfoAddress, 0, true, depth + 1, ops))
+			return false;
+	}
+
+	// Codes are listed last operation first.
+	size_t first = ops.size();
+	for (int i = 0; i < count; )
+	{
+		const BYTE *code = info + 4 + 2 * i;
+		X64PrologueOp op = { (BYTE)(code[1] & 15), (BYTE)(code[1] >> 4), 0, frame_reg, frame_offset };
+		int slots = 1;
+		switch (op.op)
+		{
+		case UWOP_PUSH_NONVOL:
+		case UWOP_SET_FPREG:
+			break;
+		case UWOP_ALLOC_SMALL:
+			op.operand = op.info * 8 + 8;
+			break;
+		case UWOP_ALLOC_LARGE:
+			slots = op.info ? 3 : 2;
+			if (i + slots > count)
+				return false;
+			op.operand = op.info ? *(const DWORD *)(code + 2) : *(const USHORT *)(code + 2) * 8;
+			break;
+		case UWOP_SAVE_NONVOL:
+			slots = 2;
+			if (i + slots > count)
+				return false;
+			op.operand = *(const USHORT *)(code + 2) * 8;
+			break;
+		case UWOP_SAVE_NONVOL_FAR:
+			slots = 3;
+			if (i + slots > count)
+				return false;
+			op.operand = *(const DWORD *)(code + 2);
+			break;
+		case UWOP_SAVE_XMM128:
+			slots = 2;
+			break;
+		case UWOP_SAVE_XMM128_FAR:
+			slots = 3;
+			break;
+		case UWOP_EPILOG:
+			// Version 2 lists epilogues among the codes; they aren't part of the prologue.
+			if (version != 2)
+				return false;
+			i += slots;
+			continue;
+		default:
+			return false; // UWOP_PUSH_MACHFRAME: an interrupt or exception frame
+		}
+
+		if (whole || code[0] <= pc_offset)
+			ops.push_back(op);
+		i += slots;
+	}
+	std::reverse(ops.begin() + first, ops.end());
+	return true;
+}
+
+// Epilogues aren't described by the unwind codes; an x64 epilogue is
+// made up of an optional "add rsp"/"lea rsp", pops, and a ret or jmp.
+// Anything that might be one is flagged, rather than decoded.
+static bool maybeEpilogue(HANDLE process, PROFILER_ADDR ip)
+{
+	BYTE code[4] = { 0 };
+	SIZE_T numRead = 0;
+	ReadProcessMemory(process, (LPCVOID)ip, code, sizeof(code), &numRead);
+	if (numRead < 2)
+		return true;
+
+	size_t i = 0;
+	if ((code[0] & 0xF0) == 0x40 || code[0] == 0xF3 || code[0] == 0xF2) // REX; rep ret, bnd ret
+		i = 1;
+	BYTE op = code[i], modrm = code[i + 1];
+
+	return (op >= 0x58 && op <= 0x5F) ||                        // pop
+		op == 0xC3 || op == 0xC2 ||                             // ret
+		op == 0xE9 ||                                           // jmp
+		(op == 0xFF && ((modrm & 0x38) == 0x20 || (modrm & 0x38) == 0x28)) || // jmp indirect
+		((op == 0x81 || op == 0x83) && modrm == 0xC4) ||        // add rsp, imm
+		(op == 0x8D && (modrm & 0x38) == 0x20);                 // lea rsp, [...]
+}
+#endif
+
+// Works out the UnwindRule for pc in a 64-bit process from its function's
+// unwind data, which DbgHelp finds. Call with dbghelp_mutex held.
+static UnwindRule resolveUnwindRule(HANDLE process, SymbolInfo *syminfo, PROFILER_ADDR pc)
+{
+	UnwindRule rule;
+	memset(&rule, 0, sizeof(rule));
+	rule.cfa_reg = UnwindRule::CFA_NONE;
+
+#if defined(_WIN64)
+	Module *mod = syminfo->getModuleForAddr(pc);
+	if (!mod || !mod->dbghelp->Loaded)
+		return rule;
+
+	DWORD64 base = mod->dbghelp->SymGetModuleBase64(process, pc);
+	const X64RuntimeFunction *func = (const X64RuntimeFunction *)mod->dbghelp->SymFunctionTableAccess64(process, pc);
+	if (!base)
+		return rule;
+
+	// Leaf functions have no unwind data, as they leave the stack alone.
+	DWORD size = 0;
+	DWORD fpreg_size = 0, frame_offset = 0;
+	bool frame_set = false;
+	int fp_rule = UnwindRule::SAME;
+	long long fp_offset = 0;
+
+	if (func)
+	{
+		std::vector<X64PrologueOp> ops;
+		if (!readPrologue(process, base, func->UnwindInfoAddress, pc - (base + func->BeginAddress), false, 0, ops))
+			return rule;
+
+		bool rbp_saved_by_mov = false;
+		DWORD rbp_save_offset = 0;
+		for (size_t i = 0; i < ops.size(); i++)
+		{
+			const X64PrologueOp &op = ops[i];
+			switch (op.op)
+			{
+			case UWOP_PUSH_NONVOL:
+				size += 8;
+				if (op.info == kRegRbp)
+				{
+					fp_rule = UnwindRule::SAVED;
+					fp_offset = -8 - (long long)size;
+				}
+				break;
+			case UWOP_ALLOC_SMALL:
+			case UWOP_ALLOC_LARGE:
+				size += op.operand;
+				break;
+			case UWOP_SET_FPREG:
+				if (op.frame_reg != kRegRbp)
+					return rule;
+				frame_set = true;
+				fpreg_size = size;
+				frame_offset = op.frame_offset * 16;
+				break;
+			case UWOP_SAVE_NONVOL:
+			case UWOP_SAVE_NONVOL_FAR:
+				if (op.info == kRegRbp)
+				{
+					rbp_saved_by_mov = true;
+					rbp_save_offset = op.operand;
+				}
+				break;
+			}
+		}
+
+		// Saves are relative to the bottom of the fixed allocation,
+		// which is where the frame register points, less its offset.
+		if (rbp_saved_by_mov)
+		{
+			fp_rule = UnwindRule::SAVED;
+			fp_offset = -8 - (long long)(frame_set ? fpreg_size : size) + rbp_save_offset;
+		}
+	}
+
+	// The return address is just above everything the prologue pushed or allocated.
+	long long cfa_offset = frame_set ? 8 + (long long)fpreg_size - frame_offset : 8 + (long long)size;
+	if (cfa_offset > 0x7fffffff)
+		return rule;
+	if (fp_rule == UnwindRule::SAVED && (fp_offset < -32768 || fp_offset > 32767))
+		fp_rule = UnwindRule::LOST;
+
+	rule.cfa_reg = frame_set ? UnwindRule::CFA_FP : UnwindRule::CFA_SP;
+	rule.cfa_offset = (int)cfa_offset;
+	rule.ra_rule = UnwindRule::SAVED;
+	rule.ra_offset = -8;
+	rule.fp_rule = (unsigned char)fp_rule;
+	rule.fp_offset = fp_rule == UnwindRule::SAVED ? (short)fp_offset : 0;
+	if (func && maybeEpilogue(process, pc))
+		rule.flags = UnwindRule::MAYBE_EPILOGUE;
+#endif
+
+	return rule;
+}
+
+// The unwind rule for pc, from the cache if it has been worked out before.
+static bool findUnwindRule(HANDLE process, SymbolInfo *syminfo, UnwindCache &cache, SampleTimings &timings, PROFILER_ADDR pc, UnwindRule &rule)
+{
+	if (cache.lookup(pc, rule))
+		timings.unwind_cache_hits++;
+	else
+	{
+		timings.unwind_cache_misses++;
+		Lock lock(syminfo->dbghelp_mutex);
+		rule = resolveUnwindRule(process, syminfo, pc);
+		cache.insert(pc, rule);
+	}
+	return rule.cfa_reg != UnwindRule::CFA_NONE;
+}
+
+// Walks the stack of a thread from the registers and stack copy in a snapshot.
+// Each frame is unwound through the copy by its unwind rule where one is known
+// (64-bit processes only), or else by its frame pointer if that can be trusted,
+// which between them usually covers the whole stack. Whatever is left is walked
+// by DbgHelp, which reads the copy too.
+static void walkStack(StackSnapshot &snapshot, SymbolInfo *syminfo, UnwindCache *unwind_cache, SampleTimings &timings, CallStack &stack)
+{
+	stack.depth = 0;
+
+	HANDLE target_process = snapshot.target_process;
+	HANDLE target_thread = snapshot.target_thread;
+	bool is64BitProcess = snapshot.is64BitProcess;
+	ThreadContext &context = snapshot.context;
+
+	STACKFRAME64 frame;
+	PROFILER_ADDR ip, sp, bp;
+	DWORD machine = is64BitProcess ? IMAGE_FILE_MACHINE_AMD64 : IMAGE_FILE_MACHINE_I386;
+	void *contextRecord = &context;
+
+#if !defined(_WIN64)
+	applyHacks(target_process, context.context32);
+#endif
+
+	StackFrame fpframe;
+	getRegisters(is64BitProcess, context, fpframe.ip, fpframe.sp, fpframe.fp);
+
+	LoadedModules modules(syminfo);
+	size_t ptr_size = is64BitProcess ? 8 : 4;
+	while (stack.depth < MAX_CALLSTACK_LEVELS)
+	{
+		// Return addresses point after the call, which may be past the end
+		// of the function if it never returns; look up the call instead.
+		PROFILER_ADDR frame_ip = fpframe.ip;
+		bool innermost = stack.depth == 0;
+		PROFILER_ADDR pc = innermost ? frame_ip : frame_ip - 1;
+
+		FrameStep step;
+		UnwindRule rule;
+		if (unwind_cache && is64BitProcess && findUnwindRule(target_process, syminfo, *unwind_cache, timings, pc, rule) &&
+			!(innermost && (rule.flags & UnwindRule::MAYBE_EPILOGUE)))
+			step = stepUnwindRule(rule, &snapshot.stack[0], snapshot.stack_addr, snapshot.stack_size, ptr_size, modules, fpframe);
+		else
+			step = stepFramePointer(&snapshot.stack[0], snapshot.stack_addr, snapshot.stack_size, ptr_size, modules, fpframe);
+
+		if (step == FRAME_UNKNOWN || step == FRAME_BROKEN)
+			break;
+
+		stack.addr[stack.depth++] = frame_ip;
+		if (step == FRAME_LAST)
+			return;
+		if (step == FRAME_OUTERMOST)
+		{
+			if (stack.depth < MAX_CALLSTACK_LEVELS)
+				stack.addr[stack.depth++] = fpframe.ip;
+			return;
+		}
+	}
+	if (stack.depth >= MAX_CALLSTACK_LEVELS)
+		return;
+
+	// Carry on from the first frame neither could vouch for.
+	if (stack.depth > 0)
+		setRegisters(is64BitProcess, context, fpframe);
+	ip = fpframe.ip;
+	sp = fpframe.sp;
+	bp = fpframe.fp;
+
+	DbgHelp *prevDbgHelp = NULL;
+	bool first = true;
+
+	Lock lock(syminfo->dbghelp_mutex);
+	t_snapshot = &snapshot;
+
+	for (;;)
+	{
+		// See which module this IP is in.
+		Module *mod = syminfo->getModuleForAddr(ip);
+		DbgHelp *dbgHelp = mod ? mod->dbghelp : &dbgHelpMs;
+		if (!dbgHelp->Loaded)
+			break;
+
+		// Use whichever dbghelp stack walker is best for this module type.
+		// If we're switching between types, restart the stack walk from
+		// the current place.
+		if (dbgHelp != prevDbgHelp)
+		{
+			prevDbgHelp = dbgHelp;
+			memset(&frame, 0, sizeof(frame));
+			frame.AddrStack.Offset = sp;
+			frame.AddrPC.Offset = ip;
+			frame.AddrFrame.Offset = bp;
+			frame.AddrStack.Mode = frame.AddrPC.Mode = frame.AddrFrame.Mode = AddrModeFlat;
+			frame.AddrReturn.Offset = ip;
+			first = true;
+		}
+
+		// Add this IP to the stack trace.
+		// We skip the first one, as the first call to StackWalk64
+		// simply fills in more registers for the current frame,
+		// rather than walking down to the next one.
+		if (!first)
+			stack.addr[stack.depth++] = ip;
+		first = false;
+
+		BOOL result = dbgHelp->StackWalk64(
+			machine,
+			target_process,
+			target_thread,
+			&frame,
+			contextRecord,
+			readSnapshotMemory,
+			dbgHelp->SymFunctionTableAccess64,
+			dbgHelp->SymGetModuleBase64,
+			NULL
+		);
+
+		if (!result || stack.depth >= MAX_CALLSTACK_LEVELS)
+			break;
+
+		ip = (PROFILER_ADDR)frame.AddrPC.Offset;
+		sp = (PROFILER_ADDR)frame.AddrStack.Offset;
+		bp = (PROFILER_ADDR)frame.AddrFrame.Offset;
+
+		// Stop once we hit the end of the stack.
+		if (frame.AddrReturn.Offset == 0)
+		{
+			stack.addr[stack.depth++] = ip;
+			break;
+		}
+	}
+
+	t_snapshot = NULL;
+}
+
+void Profiler::resetClock(LONGLONG now)
+{
+	last_sample = now;
+}
+
+// A sample stands for all the time since this thread was last sampled,
+// however long the scheduler or the other threads actually took.
+SAMPLE_TYPE Profiler::takeInterval(LONGLONG now)
+{
+	SAMPLE_TYPE interval = SampleTimings::toSeconds(now - last_sample);
+	last_sample = now;
+	return interval;
+}
+
+bool Profiler::sampleTarget(SymbolInfo *syminfo, StackSnapshot &scratch, UnwindThread *unwinder)
+{
+	if (unwinder)
+		return captureSnapshot(unwinder);
+
+	// DE: 20090325: Moved declaration of stack variables to reduce size of code inside Suspend/Resume thread
+
+	CallStack stack;
+
+	LONGLONG suspendStart = SampleTimings::now();
+	if (!suspendTarget(scratch.context))
+		return false;
+	SAMPLE_TYPE timeSpent = takeInterval(suspendStart);
+
+	// One bulk read of the stack, then the thread goes again: the walk
+	// follows the copy, and may wait for DbgHelp's lock behind other
+	// workers, which the target shouldn't be kept suspended for.
+	copyStack(scratch);
+
+	// TODO: Don't count samples for suspended threads
+
+	if (ResumeThread(target_thread) == 0xffffffff)
+		throw ProfilerExcep(L"ResumeThread failed.");
+	LONGLONG resumed = SampleTimings::now();
+
+	walkStack(scratch, syminfo, unwind_cache, timings, stack);
+	LONGLONG walkEnd = SampleTimings::now();
+
+	//NOTE: this has to go after ResumeThread.  Otherwise mem allocation needed by the trie
+	//may hit a lock held by the suspended thread.
+	CallStackTrie::NodeID node = callstacks.addSample(stack, timeSpent);
+	if (samplelog)
+		samplelog->add(suspendStart, thread_id, node, timeSpent);
+	LONGLONG aggregated = SampleTimings::now();
+
+	timings.suspend  .add(SampleTimings::toNanoseconds(resumed    - suspendStart));
+	timings.walk     .add(SampleTimings::toNanoseconds(walkEnd    - resumed     ));
+	timings.aggregate.add(SampleTimings::toNanoseconds(aggregated - walkEnd     ));
+	return true;
+}
+
+// Copies the top of the suspended thread's stack, from its stack pointer
+// up to MAX_STACK_COPY bytes, into a snapshot whose context is filled in.
+void Profiler::copyStack(StackSnapshot &snapshot)
+{
+	PROFILER_ADDR ip, sp, bp;
+	getRegisters(is64BitProcess, snapshot.context, ip, sp, bp);
+
+	// The top of the stack only needs to be looked up once per thread.
+	if (sp < stack_region_base || sp >= stack_limit)
+	{
+		MEMORY_BASIC_INFORMATION info;
+		if (VirtualQueryEx(target_process, (LPCVOID)sp, &info, sizeof(info)))
+		{
+			stack_region_base = (PROFILER_ADDR)info.BaseAddress;
+			stack_limit = (PROFILER_ADDR)info.BaseAddress + (PROFILER_ADDR)info.RegionSize;
+		}
+		else
+			stack_region_base = stack_limit = 0;
+	}
+
+	SIZE_T numRead = 0;
+	if (sp >= stack_region_base && sp < stack_limit)
+	{
+		PROFILER_ADDR available = stack_limit - sp;
+		SIZE_T size = available < MAX_STACK_COPY ? (SIZE_T)available : MAX_STACK_COPY;
+		if (!ReadProcessMemory(target_process, (LPCVOID)sp, &snapshot.stack[0], size, &numRead))
+			numRead = 0;
+	}
+
+	snapshot.target_process = target_process;
+	snapshot.target_thread = target_thread;
+	snapshot.is64BitProcess = is64BitProcess;
+	snapshot.stack_addr = sp;
+	snapshot.stack_limit = numRead ? stack_limit : sp;
+	snapshot.stack_size = numRead;
+}
+
+// Deferred sampling: the copy is handed to the unwinder thread to walk,
+// so that the sampler is free for its next thread straight away.
+bool Profiler::captureSnapshot(UnwindThread *unwinder)
+{
+	// Taken before suspending, so that we never allocate with the target stopped.
+	StackSnapshot *snapshot = unwinder->acquire();
+	if (!snapshot)
+		return true; // the unwinder is behind; skip this sample, the thread is still alive,
+		             // and its next sample will cover the time this one would have
+
+	LONGLONG suspendStart = SampleTimings::now();
+	if (!suspendTarget(snapshot->context))
+	{
+		unwinder->discard(snapshot);
+		return false;
+	}
+	SAMPLE_TYPE timeSpent = takeInterval(suspendStart);
+
+	copyStack(*snapshot);
+
+	if (ResumeThread(target_thread) == 0xffffffff)
+	{
+		unwinder->discard(snapshot);
+		throw ProfilerExcep(L"ResumeThread failed.");
+	}
+	timings.suspend.add(SampleTimings::toNanoseconds(SampleTimings::now() - suspendStart));
+
+	snapshot->timeSpent = timeSpent;
+	snapshot->timestamp = suspendStart;
+	snapshot->thread_id = thread_id;
+
+	unwinder->submit(snapshot);
+	return true;
+}
+
+void Profiler::unwindSnapshot(StackSnapshot &snapshot, SymbolInfo *syminfo, UnwindCache *unwind_cache, SampleTimings &timings, CallStack &stack)
+{
+	walkStack(snapshot, syminfo, unwind_cache, timings, stack);
+}
+
+// returns true if the target thread has finished
+bool Profiler::targetExited() const
+{
+	DWORD code = WaitForSingleObject(target_thread, 0);
+	return (code == WAIT_OBJECT_0);
+}
+
+
+//void Profiler::saveIPs(std::ostream& stream)
+//{
+//	for (auto i = counts.begin(); i != counts.end(); ++i)
+//	{
+//		const Sample &sample = i->first;
+//		int count = i->second;
+//		stream << ::toHexString(sample.addr) << " " << count << "\n";
+//	}
+//
+//	stream.flush();
+//}
+//
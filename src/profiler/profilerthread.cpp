@@ -1,374 +1,532 @@
-/*=====================================================================
-profilerthread.cpp
-------------------
-File created by ClassTemplate on Thu Feb 24 19:29:41 2005
-
-Copyright (C) Nicholas Chapman
-Copyright (C) 2015 Ashod Nakashian
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html..
-=====================================================================*/
-
-#include "../wxprofilergui/profilergui.h"
-#include "profilerthread.h"
-#include <wx/wfstream.h>
-#include <wx/zipstrm.h>
-#include <wx/txtstrm.h>
-
-#include "../utils/stringutils.h"
-#include <fstream>
-#include <assert.h>
-#include <algorithm>
-#include <Psapi.h>
-#include "../appinfo.h"
-
-#pragma comment(lib, "winmm.lib")
-
-// DE: 20090325: Profiler has a list of threads to profile
-// RM: 20130614: Profiler time can now be limited (-1 = until cancelled)
-ProfilerThread::ProfilerThread(HANDLE target_process_, const std::vector<HANDLE>& target_threads, SymbolInfo *sym_info_)
-:	profilers(),
-	target_process(target_process_),
-	sym_info(sym_info_)
-{
-	// DE: 20090325: Profiler has a list of threads to profile, one Profiler instance per thread
-	profilers.reserve(target_threads.size());
-	for (auto it = target_threads.begin(); it != target_threads.end(); ++it)
-		profilers.push_back(Profiler(target_process_, *it, callstacks, flatcounts));
-
-	numsamplessofar = 0;
-	done = false;
-	failed = false;
-	paused = false;
-	cancelled = false;
-	symbolsPermille = 0;
-	numThreadsRunning = (int)target_threads.size();
-	status = L"Initializing";
-
-	filename = wxFileName::CreateTempFileName(wxEmptyString);
-}
-
-
-ProfilerThread::~ProfilerThread()
-{
-}
-
-
-void ProfilerThread::sample(const SAMPLE_TYPE timeSpent)
-{
-	// DE: 20090325: Profiler has a list of threads to profile, one Profiler instance per thread
-	// RJM- We traverse them in random order. The act of profiling causes the Windows scheduler
-	//      to re-schedule, and if we did them in sequence, it'll always schedule the first one.
-	//      This starves the other N-1 threads. For lack of a better option, using a shuffle
-	//      at least re-schedules them evenly.
-
-	const size_t count = profilers.size();
-	if ( count == 0)
-		return;
-
-	size_t *order = (size_t *)alloca( count * sizeof(size_t) );
-	for (size_t n=0;n<count;n++)
-		order[n] = n;
-	for (size_t n=count;n--;)
-	{
-		size_t i = rand() * count / (RAND_MAX+1);
-		assert( i < count );
-		std::swap( order[i], order[n] );
-	}
-
-	int numSuccessful = 0;
-	for (size_t n = 0;n < count; ++n)
-	{
-		Profiler& profiler = profilers[order[n]];
-		try {
-			if (profiler.sampleTarget(timeSpent, sym_info))
-			{
-				++numsamplessofar;
-				++numSuccessful;
-			}
-		}
-		catch (const ProfilerExcep& e)
-		{
-			error(_T("ProfilerExcep: ") + e.what());
-			this->commit_suicide = true;
-		}
-	}
-
-	numThreadsRunning = numSuccessful;
-}
-
-class ProcPred
-{
-public:
-	bool operator () (std::pair<std::wstring, int>& a, std::pair<std::wstring, int>& b)
-	{
-		return a.second > b.second;
-	}
-};
-
-void ProfilerThread::sampleLoop()
-{
-	timeBeginPeriod(1);
-
-	LARGE_INTEGER prev, now, start, freq;
-	QueryPerformanceFrequency(&freq);
-	QueryPerformanceCounter(&start);
-	prev = start;
-
-	bool minidump_saved = false;
-
-	while(!this->commit_suicide)
-	{
-		if (paused)
-		{
-			Sleep(100);
-			continue;
-		}
-
-		QueryPerformanceCounter(&now);
-
-		__int64 diff = now.QuadPart - prev.QuadPart;
-		double t = (double)diff / (double)freq.QuadPart;
-
-		__int64 elapsed = now.QuadPart - start.QuadPart;
-		if (!minidump_saved && prefs.saveMinidump>=0 && elapsed >= prefs.saveMinidump * freq.QuadPart)
-		{
-			minidump_saved = true;
-			status = L"Saving minidump";
-			minidump = sym_info->saveMinidump();
-			status = NULL;
-			continue;
-		}
-
-		sample(t);
-
-		int ms = 100 / prefs.throttle;
-		Sleep(ms);
-
-		prev = now;
-	}
-
-	timeEndPeriod(1);
-}
-
-void ProfilerThread::saveData()
-{
-	//get process id of the process the target thread is running in
-	//const DWORD process_id = GetProcessIdOfThread(profiler.getTarget());
-
-	wxFFileOutputStream out(filename);
-	wxZipOutputStream zip(out);
-	wxTextOutputStream txt(zip, wxEOL_NATIVE, wxConvAuto(wxFONTENCODING_UTF8));
-
-	if (!out.IsOk() || !zip.IsOk())
-	{
-		error(L"Error writing to file");
-		return;
-	}
-
-	//------------------------------------------------------------------------
-
-	if (!minidump.empty())
-	{
-		zip.PutNextEntry(_T("minidump.dmp"));
-		beginProgress(L"Copying minidump", 100);
-		{
-			wxFFileInputStream stream(minidump);
-			zip.Write(stream);
-		}
-		wxRemoveFile(minidump);
-	}
-
-	//------------------------------------------------------------------------
-	beginProgress(L"Saving stats", 100);
-	zip.PutNextEntry(_T("Stats.txt"));
-
-	wchar_t tmp[4096] = L"?";
-	GetModuleFileNameEx(target_process, NULL, tmp, 4096);
-	time_t rawtime;
-	time(&rawtime);
-	txt << "Filename: " << tmp << "\n";
-	txt << "Duration: " << duration << "\n";
-	txt << "Date: " << asctime(localtime(&rawtime));
-	txt << "Samples: " << numsamplessofar << "\n";
-
-	//------------------------------------------------------------------------
-	beginProgress(L"Summarizing results");
-
-	std::map<PROFILER_ADDR, bool> used_addresses;
-	SAMPLE_TYPE totalCounts = 0;
-
-	for (auto i = flatcounts.begin(); i != flatcounts.end(); ++i)
-	{
-		PROFILER_ADDR addr = i->first;
-		used_addresses[addr] = true;
-		totalCounts += i->second;
-	}
-
-	for (auto i = callstacks.begin(); i != callstacks.end(); ++i)
-	{
-		const CallStack &callstack = i->first;
-		for (size_t n=0;n<callstack.depth;n++)
-		{
-			used_addresses[callstack.addr[n]] = true;
-		}
-	}
-
-	//------------------------------------------------------------------------
-	beginProgress(L"Querying and saving symbols", used_addresses.size());
-	zip.PutNextEntry(_T("Symbols.txt"));
-
-	for (auto i = used_addresses.begin(); i != used_addresses.end(); ++i)
-	{
-		int proclinenum;
-		std::wstring procfile;
-		PROFILER_ADDR addr = i->first;
-
-		const std::wstring proc_name = sym_info->getProcForAddr(addr, procfile, proclinenum);
-		txt << ::toHexString(addr);
-		txt << " ";
-		writeQuote(txt, sym_info->getModuleNameForAddr(addr));
-		txt << " ";
-		writeQuote(txt, proc_name);
-		txt << " ";
-		writeQuote(txt, procfile);
-		txt << " ";
-		txt << ::toString(proclinenum);
-		txt << '\n';
-
-		if (updateProgress())
-			return;
-	}
-
-	//------------------------------------------------------------------------
-	beginProgress(L"Saving IP counts", flatcounts.size());
-	zip.PutNextEntry(_T("IPCounts.txt"));
-
-	txt << totalCounts << "\n";
-
-	for (auto i = flatcounts.begin(); i != flatcounts.end(); ++i)
-	{
-		PROFILER_ADDR addr = i->first;
-		SAMPLE_TYPE count = i->second;
-
-		txt << ::toHexString(addr) << " " << count << "\n";
-
-		if (updateProgress())
-			return;
-	}
-
-	//------------------------------------------------------------------------
-	beginProgress(L"Saving callstacks", callstacks.size());
-	zip.PutNextEntry(_T("Callstacks.txt"));
-
-	for (auto i = callstacks.begin(); i != callstacks.end(); ++i)
-	{
-		const CallStack &callstack = i->first;
-		SAMPLE_TYPE count = i->second;
-
-		txt << count;
-		for( size_t d=0;d<callstack.depth;d++ )
-			txt << " " << ::toHexString(callstack.addr[d]);
-		txt << "\n";
-
-		if (updateProgress())
-			return;
-	}
-
-	//------------------------------------------------------------------------
-	// Change FORMAT_VERSION when the file format changes
-	// (and becomes unreadable by older versions of Sleepy).
-	zip.PutNextEntry(L"Version " _T(FORMAT_VERSION) L" required");
-	txt << FORMAT_VERSION << "\n";
-
-
-	if (!out.IsOk() || !zip.IsOk())
-	{
-		error(L"Error writing to file");
-		return;
-	}
-}
-
-void ProfilerThread::run()
-{
-	wxLog::EnableLogging();
-
-	startTick = GetTickCount();
-
-	status = NULL;
-	try
-	{
-		sampleLoop();
-	} catch(ProfilerExcep& e) {
-		// see if it's an actual error, or did the thread just finish naturally
-		for (auto it = profilers.begin(); it != profilers.end(); ++it)
-		{
-			const Profiler& profiler(*it);
-			if (!profiler.targetExited())
-			{
-				error(L"ProfilerExcep: " + e.what());
-				return;
-			}
-		}
-
-		numThreadsRunning = 0;
-	}
-
-	status = L"Exiting";
-
-	if (cancelled)
-		return;
-
-	setPriority(THREAD_PRIORITY_NORMAL);
-
-	DWORD endTick = GetTickCount();
-	int diff = endTick - startTick;
-	duration = diff / 1000.0;
-
-	saveData();
-
-	done = true;
-}
-
-
-void ProfilerThread::error(const std::wstring& what)
-{
-	failed = true;
-	std::cerr << "ProfilerThread Error: " << what << std::endl;
-
-	::MessageBox(NULL, std::wstring(L"Error: " + what).c_str(), L"Profiler Error", MB_OK);
-}
-
-void ProfilerThread::beginProgress(std::wstring stage, int total)
-{
-	symbolsStage = stage;
-	symbolsDone = 0;
-	symbolsTotal = total;
-	symbolsPermille = 0;
-}
-
-bool ProfilerThread::updateProgress()
-{
-	symbolsDone++;
-	symbolsPermille = MulDiv(symbolsDone, 1000, symbolsTotal);
-	if (cancelled)
-	{
-		failed = true;
-		return true;
-	}
-	return false;
-}
+/*=====================================================================
+profilerthread.cpp
+------------------
+File created by ClassTemplate on Thu Feb 24 19:29:41 2005
+
+Copyright (C) Nicholas Chapman
+Copyright (C) 2015 Ashod Nakashian
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "../wxprofilergui/profilergui.h"
+#include "profilerthread.h"
+#include <wx/wfstream.h>
+#include <wx/zipstrm.h>
+#include <wx/txtstrm.h>
+
+#include "../utils/stringutils.h"
+#include "processinfo.h"
+#include "captureformat.h"
+#include <fstream>
+#include <assert.h>
+#include <algorithm>
+#include <Psapi.h>
+#include "../appinfo.h"
+
+#pragma comment(lib, "winmm.lib")
+
+// Threads per sampler worker when choosing the number of workers automatically.
+static const size_t kThreadsPerWorker = 64;
+
+// Never look for new threads more often than this, however cheap it is.
+static const int kMinRescanIntervalMs = 100;
+
+static size_t chooseNumWorkers(size_t numThreads)
+{
+	// A worker with no threads to sample would only spin.
+	size_t most = numThreads > 1 ? numThreads : 1;
+	if (prefs.samplerThreads > 0)
+		return (size_t)prefs.samplerThreads < most ? (size_t)prefs.samplerThreads : most;
+
+	// Leave a core for the target.
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	size_t cores = info.dwNumberOfProcessors > 1 ? info.dwNumberOfProcessors - 1 : 1;
+
+	size_t wanted = (numThreads + kThreadsPerWorker - 1) / kThreadsPerWorker;
+	if (wanted < 1)
+		wanted = 1;
+	return wanted < cores ? wanted : cores;
+}
+
+// DE: 20090325: Profiler has a list of threads to profile
+// RM: 20130614: Profiler time can now be limited (-1 = until cancelled)
+ProfilerThread::ProfilerThread(HANDLE target_process_, const std::vector<HANDLE>& target_threads, SymbolInfo *sym_info_, bool discover_threads_)
+:	workers(),
+	deferredUnwind(prefs.deferredUnwind),
+	deferSymbols(prefs.deferSymbols),
+	keepSampleLog(prefs.sampleLog),
+	discover_threads(discover_threads_ && prefs.threadRescanBudget > 0),
+	target_process(target_process_),
+	sym_info(sym_info_)
+{
+	// The target's threads are dealt out between the workers, one Profiler instance per thread.
+	size_t numWorkers = chooseNumWorkers(target_threads.size());
+	for (size_t n=0;n<numWorkers;n++)
+		workers.push_back(new SamplerWorker(target_process_, sym_info_, &unwindCache, prefs.sampleRate, prefs.sampleJitter / 100.0, deferredUnwind, keepSampleLog));
+	for (size_t n=0;n<target_threads.size();n++)
+		workers[n % numWorkers]->addThread(target_threads[n]);
+
+	// Threads running now were either chosen to be profiled or not;
+	// only the ones started from here on count as new.
+	if (discover_threads)
+	{
+		std::vector<DWORD> ids;
+		ProcessInfo::enumThreadIds(GetProcessId(target_process), ids);
+		known_threads.insert(ids.begin(), ids.end());
+		for (size_t n=0;n<target_threads.size();n++)
+			known_threads.insert(GetThreadId(target_threads[n]));
+	}
+
+	done = false;
+	failed = false;
+	paused = false;
+	cancelled = false;
+	symbolsPermille = 0;
+	status = L"Initializing";
+
+	filename = wxFileName::CreateTempFileName(wxEmptyString);
+}
+
+
+ProfilerThread::~ProfilerThread()
+{
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		delete *it;
+	for (auto it = opened_threads.begin(); it != opened_threads.end(); ++it)
+		CloseHandle(*it);
+}
+
+int ProfilerThread::getNumThreadsRunning() const
+{
+	int total = 0;
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		total += (*it)->getNumThreadsRunning();
+	return total;
+}
+
+int ProfilerThread::getSampleProgress() const
+{
+	int total = 0;
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		total += (*it)->getNumSamples();
+	return total;
+}
+
+void ProfilerThread::setPaused(bool paused_)
+{
+	paused = paused_;
+	setWorkersPaused(paused_);
+}
+
+// Give threads started since the last scan to the workers with the fewest threads,
+// and forget the ones that have gone, in case their IDs get reused.
+// Workers retire the Profilers of exited threads themselves.
+void ProfilerThread::discoverThreads()
+{
+	std::vector<DWORD> ids;
+	ProcessInfo::enumThreadIds(GetProcessId(target_process), ids);
+	if (ids.empty())
+		return; // the process has gone, or the snapshot failed
+
+	// A thread that can't be opened yet is left out, to be tried again next time.
+	std::set<DWORD> current;
+	for (auto it = ids.begin(); it != ids.end(); ++it)
+	{
+		if (known_threads.find(*it) != known_threads.end())
+		{
+			current.insert(*it);
+			continue;
+		}
+
+		HANDLE thread = OpenThread(THREAD_ALL_ACCESS, FALSE, *it);
+		if (!thread)
+			continue;
+		opened_threads.push_back(thread);
+		current.insert(*it);
+
+		SamplerWorker *target = workers.front();
+		for (auto w = workers.begin(); w != workers.end(); ++w)
+			if ((*w)->getNumThreads() < target->getNumThreads())
+				target = *w;
+		target->addThread(thread);
+	}
+
+	known_threads.swap(current);
+}
+
+void ProfilerThread::setWorkersPaused(bool paused_)
+{
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		(*it)->setPaused(paused_);
+}
+
+class ProcPred
+{
+public:
+	bool operator () (std::pair<std::wstring, int>& a, std::pair<std::wstring, int>& b)
+	{
+		return a.second > b.second;
+	}
+};
+
+// The workers do the sampling; this just watches over them
+// until we are told to stop or one of them fails.
+void ProfilerThread::sampleLoop()
+{
+	LONGLONG start = SampleTimings::now();
+	LONGLONG freq = SampleTimings::frequency();
+
+	bool minidump_saved = false;
+	LONGLONG next_rescan = start;
+
+	while(!this->commit_suicide)
+	{
+		for (auto it = workers.begin(); it != workers.end(); ++it)
+			if ((*it)->getFailed())
+				return;
+
+		// Rescan no more often than keeps the time spent scanning
+		// within prefs.threadRescanBudget percent of this thread's time.
+		if (discover_threads && !paused && SampleTimings::now() >= next_rescan)
+		{
+			LONGLONG scanStart = SampleTimings::now();
+			discoverThreads();
+			LONGLONG scanEnd = SampleTimings::now();
+
+			LONGLONG interval = (scanEnd - scanStart) * 100 / prefs.threadRescanBudget;
+			LONGLONG minInterval = freq * kMinRescanIntervalMs / 1000;
+			next_rescan = scanEnd + (interval > minInterval ? interval : minInterval);
+		}
+
+		LONGLONG elapsed = SampleTimings::now() - start;
+		if (!paused && !minidump_saved && prefs.saveMinidump>=0 && elapsed >= prefs.saveMinidump * freq)
+		{
+			minidump_saved = true;
+			status = L"Saving minidump";
+			setWorkersPaused(true);
+			{
+				Lock lock(sym_info->dbghelp_mutex);
+				minidump = sym_info->saveMinidump();
+			}
+			setWorkersPaused(paused);
+			status = NULL;
+		}
+
+		Sleep(50);
+	}
+}
+
+void ProfilerThread::saveData()
+{
+	//get process id of the process the target thread is running in
+	//const DWORD process_id = GetProcessIdOfThread(profiler.getTarget());
+
+	wxFFileOutputStream out(filename);
+	wxZipOutputStream zip(out);
+	wxTextOutputStream txt(zip, wxEOL_NATIVE, wxConvAuto(wxFONTENCODING_UTF8));
+
+	if (!out.IsOk() || !zip.IsOk())
+	{
+		error(L"Error writing to file");
+		return;
+	}
+
+	//------------------------------------------------------------------------
+
+	if (!minidump.empty())
+	{
+		zip.PutNextEntry(_T("minidump.dmp"));
+		beginProgress(L"Copying minidump", 100);
+		{
+			wxFFileInputStream stream(minidump);
+			zip.Write(stream);
+		}
+		wxRemoveFile(minidump);
+	}
+
+	//------------------------------------------------------------------------
+	beginProgress(L"Saving stats", 100);
+	zip.PutNextEntry(_T("Stats.txt"));
+
+	wchar_t tmp[4096] = L"?";
+	GetModuleFileNameEx(target_process, NULL, tmp, 4096);
+	time_t rawtime;
+	time(&rawtime);
+	txt << "Filename: " << tmp << "\n";
+	txt << "Duration: " << duration << "\n";
+	txt << "Date: " << asctime(localtime(&rawtime));
+	txt << "Samples: " << getSampleProgress() << "\n";
+
+	// Each worker paces its own shard; average their rates over all threads.
+	double requestedRate = 0, achievedRate = 0;
+	unsigned long long numMissed = 0;
+	int numThreads = 0, numDropped = 0, numRetired = 0;
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+	{
+		const SamplerWorker *worker = *it;
+		requestedRate = worker->getScheduler().getRequestedRate();
+		achievedRate += worker->getScheduler().getAchievedRate() * worker->getNumThreads();
+		numMissed += worker->getScheduler().getNumMissed();
+		numThreads += worker->getNumThreads();
+		numDropped += worker->getNumDropped();
+		numRetired += worker->getNumRetired();
+	}
+	if (numThreads)
+		achievedRate /= numThreads;
+
+	txt << "Sampler threads: " << (int)workers.size() << "\n";
+	txt << "Sample rate: " << requestedRate << " Hz requested, "
+		<< ::floatToString((float)achievedRate, 1) << " Hz achieved\n";
+	txt << "Missed deadlines: " << numMissed << "\n";
+	if (discover_threads)
+	{
+		txt << "Threads started during capture: " << (int)opened_threads.size() << "\n";
+		txt << "Threads exited during capture: " << numRetired << "\n";
+	}
+	if (deferredUnwind)
+		txt << "Dropped samples (unwinder behind): " << numDropped << "\n";
+	txt << "Unwind cache: " << timings.unwind_cache_hits << " hits, " << timings.unwind_cache_misses << " misses\n";
+
+	//------------------------------------------------------------------------
+	// Per-sample timings in nanoseconds, one histogram per line.
+	zip.PutNextEntry(_T("Latency.txt"));
+	txt << "Suspend "   << timings.suspend  .toString() << "\n";
+	txt << "Walk "      << timings.walk     .toString() << "\n";
+	txt << "Aggregate " << timings.aggregate.toString() << "\n";
+
+	//------------------------------------------------------------------------
+	beginProgress(L"Summarizing results");
+
+	// Every trie node lies on the path of at least one sample,
+	// so its address needs a symbol.
+	std::map<PROFILER_ADDR, bool> used_addresses;
+	for (CallStackTrie::NodeID id = 1; id < callstacks.getNodeCount(); id++)
+		used_addresses[callstacks.getNode(id).addr] = true;
+
+	std::vector<PROFILER_ADDR> addrs;
+	addrs.reserve(used_addresses.size());
+	for (auto i = used_addresses.begin(); i != used_addresses.end(); ++i)
+		addrs.push_back(i->first);
+
+	//------------------------------------------------------------------------
+	// Where each module was, and which build it was; with deferred symbols,
+	// that's what they're looked up from when the capture is opened.
+	beginProgress(L"Saving modules");
+	zip.PutNextEntry(_T("Modules.txt"));
+
+	std::vector<SymbolInfo::ModuleRecord> records;
+	sym_info->getModuleRecords(records);
+	txt << (sym_info->getIs64BitProcess() ? "64" : "32") << (deferSymbols ? " deferred" : " resolved") << "\n";
+	for (size_t i = 0; i < records.size(); i++)
+		txt << SymbolInfo::formatModuleRecord(records[i]) << "\n";
+
+	CaptureEncoder encoder;
+	if (deferSymbols)
+	{
+		// Placeholders, until the capture is opened.
+		beginProgress(L"Saving addresses", addrs.size());
+
+		std::vector<SymbolInfo::AddrSymbol> symbols(addrs.size());
+		for (size_t i = 0; i < addrs.size(); i++)
+		{
+			Module *mod = sym_info->getModuleForAddr(addrs[i]);
+			symbols[i].module = mod ? mod->name : L"?";
+			symbols[i].proc = sym_info->getUnknownProcName(addrs[i]);
+			symbols[i].line = 0;
+			if (updateProgress())
+				return;
+		}
+		if (!addrs.empty())
+			sym_info->encodeSymbols(encoder, &addrs[0], &symbols[0], addrs.size());
+	}
+	else
+	{
+		//------------------------------------------------------------------------
+		beginProgress(L"Querying symbols", used_addresses.size());
+
+		// Each module's run of addresses is looked up as a batch, a few
+		// thousand at a time so that progress keeps moving. DbgHelp is
+		// single threaded, so there's nothing to gain from more threads.
+		std::vector<SymbolInfo::AddrSymbol> symbols(addrs.size());
+		LONG numResolved = 0;
+
+		for (size_t begin = 0, end; begin < addrs.size() && !cancelled; begin = end)
+		{
+			Module *mod = sym_info->getModuleForAddr(addrs[begin]);
+			for (end = begin + 1; end < addrs.size() && end - begin < 4096; end++)
+				if (sym_info->getModuleForAddr(addrs[end]) != mod)
+					break;
+
+			sym_info->resolveAddrs(&addrs[begin], end - begin, &symbols[begin], &numResolved, &cancelled);
+
+			symbolsDone = numResolved;
+			if (symbolsTotal)
+				symbolsPermille = MulDiv(symbolsDone, 1000, symbolsTotal);
+		}
+
+		if (cancelled)
+		{
+			failed = true;
+			return;
+		}
+
+		sym_info->saveSymbolCache();
+		if (!addrs.empty())
+			sym_info->encodeSymbols(encoder, &addrs[0], &symbols[0], addrs.size());
+	}
+
+	//------------------------------------------------------------------------
+	// Before the entries that refer to its addresses.
+	beginProgress(L"Saving symbols and callstacks");
+	std::vector<unsigned char> encoded;
+	encoder.encodeSymbols(encoded);
+	zip.PutNextEntry(_T("Symbols.bin"));
+	if (!encoded.empty())
+		zip.Write(&encoded[0], encoded.size());
+
+	encoded.clear();
+	encoder.encodeIpCounts(callstacks, encoded);
+	zip.PutNextEntry(_T("IPCounts.bin"));
+	if (!encoded.empty())
+		zip.Write(&encoded[0], encoded.size());
+
+	encoded.clear();
+	encoder.encodeCallstacks(callstacks, encoded);
+	zip.PutNextEntry(_T("Callstacks.bin"));
+	if (!encoded.empty())
+		zip.Write(&encoded[0], encoded.size());
+
+	//------------------------------------------------------------------------
+	if (keepSampleLog)
+	{
+		beginProgress(L"Saving sample log");
+		zip.PutNextEntry(_T("Samples.bin"));
+
+		// Stacks are the nodes with a count, numbered in order.
+		std::vector<unsigned> stack_ids(callstacks.getNodeCount(), unsigned(SampleLog::NO_STACK_ID));
+		unsigned numStacks = 0;
+		for (CallStackTrie::NodeID id = 1; id < callstacks.getNodeCount(); id++)
+			if (callstacks.getNode(id).count > 0)
+				stack_ids[id] = numStacks++;
+
+		encoded.clear();
+		samplelog.encode(encoded, startTime, stack_ids);
+		if (!encoded.empty())
+			zip.Write(&encoded[0], encoded.size());
+	}
+
+	//------------------------------------------------------------------------
+	// Change FORMAT_VERSION when the file format changes
+	// (and becomes unreadable by older versions of Sleepy).
+	zip.PutNextEntry(L"Version " _T(FORMAT_VERSION) L" required");
+	txt << FORMAT_VERSION << "\n";
+
+
+	if (!out.IsOk() || !zip.IsOk())
+	{
+		error(L"Error writing to file");
+		return;
+	}
+}
+
+void ProfilerThread::run()
+{
+	wxLog::EnableLogging();
+
+	startTick = GetTickCount();
+	startTime = SampleTimings::now();
+
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		(*it)->launch(false, THREAD_PRIORITY_TIME_CRITICAL);
+
+	status = NULL;
+	sampleLoop();
+
+	DWORD endTick = GetTickCount();
+	int diff = endTick - startTick;
+	duration = diff / 1000.0;
+
+	// Stop the workers. Each lets its unwinder catch up first,
+	// so their tries hold every sample they took.
+	if (deferredUnwind)
+		status = L"Unwinding stacks";
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		(*it)->commit_suicide = true;
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		(*it)->waitFor();
+
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+	{
+		if ((*it)->getFailed())
+		{
+			error((*it)->getError());
+			return;
+		}
+	}
+
+	status = L"Exiting";
+
+	if (cancelled)
+		return;
+
+	setPriority(THREAD_PRIORITY_NORMAL);
+
+	std::vector<CallStackTrie::NodeID> mapping;
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+	{
+		callstacks.merge((*it)->getCallstacks(), &mapping);
+		timings.merge((*it)->getTimings());
+		if (const SampleLog *log = (*it)->getSampleLog())
+			samplelog.append(*log, mapping);
+	}
+	samplelog.sortByTime();
+
+	saveData();
+
+	done = true;
+}
+
+
+void ProfilerThread::error(const std::wstring& what)
+{
+	failed = true;
+	std::cerr << "ProfilerThread Error: " << what << std::endl;
+
+	::MessageBox(NULL, std::wstring(L"Error: " + what).c_str(), L"Profiler Error", MB_OK);
+}
+
+void ProfilerThread::beginProgress(std::wstring stage, int total)
+{
+	symbolsStage = stage;
+	symbolsDone = 0;
+	symbolsTotal = total;
+	symbolsPermille = 0;
+}
+
+bool ProfilerThread::updateProgress()
+{
+	symbolsDone++;
+	symbolsPermille = MulDiv(symbolsDone, 1000, symbolsTotal);
+	if (cancelled)
+	{
+		failed = true;
+		return true;
+	}
+	return false;
+}
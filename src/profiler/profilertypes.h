@@ -0,0 +1,79 @@
+/*=====================================================================
+profilertypes.h
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __PROFILERTYPES_H_666_
+#define __PROFILERTYPES_H_666_
+
+// Types shared by every sampler backend. Nothing here may depend on
+// windows.h, so that the aggregation code builds on other platforms too.
+
+#include <stddef.h>
+#include <string>
+
+//64 bit mode:
+#if defined(_WIN64) || defined(__LP64__)
+typedef unsigned long long PROFILER_ADDR;
+#else
+//32 bit mode:
+typedef unsigned int PROFILER_ADDR;
+#endif
+
+typedef double SAMPLE_TYPE;
+
+#define MAX_CALLSTACK_LEVELS 256
+
+// Upper bound on how much of the target's stack is copied per sample.
+// Frames above this are lost, which only affects very deep stacks.
+#define MAX_STACK_COPY (64*1024)
+
+// Scratch buffer for the stack of a single sample.
+// Samples are aggregated in a CallStackTrie, not stored as-is.
+class CallStack
+{
+public:
+	size_t depth;
+	PROFILER_ADDR addr[MAX_CALLSTACK_LEVELS];
+};
+
+// In capture files, each function inlined at an address is given an
+// address of its own, for Symbols.bin to name and the loader to expand:
+// the real address with the depth of the inlining, from 1 for the
+// innermost, in its top byte, where no user-mode code address has bits.
+#define MAX_INLINE_DEPTH 255
+
+inline unsigned long long inlineFrameAddress(unsigned long long addr, unsigned depth)
+{
+	return addr | ((unsigned long long)depth << 56);
+}
+
+class ProfilerExcep
+{
+public:
+	ProfilerExcep(const std::wstring& s_) : s(s_) {}
+	~ProfilerExcep(){}
+
+	const std::wstring& what() const { return s; }
+private:
+	std::wstring s;
+};
+
+#endif //__PROFILERTYPES_H_666_
@@ -0,0 +1,105 @@
+/*=====================================================================
+samplelog.cpp
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "samplelog.h"
+#include "sampletimings.h"
+#include "../utils/varint.h"
+#include <algorithm>
+#include <map>
+
+void SampleLog::append(const SampleLog &other, const std::vector<CallStackTrie::NodeID> &mapping)
+{
+	records.reserve(records.size() + other.records.size());
+	for (auto it = other.records.begin(); it != other.records.end(); ++it)
+	{
+		Record record = *it;
+		record.node = mapping[record.node];
+		records.push_back(record);
+	}
+}
+
+struct RecordTimePred
+{
+	bool operator () (const SampleLog::Record &a, const SampleLog::Record &b) const
+	{
+		return a.time < b.time;
+	}
+};
+
+void SampleLog::sortByTime()
+{
+	std::stable_sort(records.begin(), records.end(), RecordTimePred());
+}
+
+static unsigned long long toMicroseconds(LONGLONG ticks)
+{
+	return SampleTimings::toNanoseconds(ticks) / 1000;
+}
+
+void SampleLog::encode(std::vector<unsigned char> &out, LONGLONG start, const std::vector<unsigned> &stack_ids) const
+{
+	// Thread IDs are large and repeat a lot, so records refer to them by index.
+	std::map<DWORD, unsigned> thread_index;
+	std::vector<DWORD> threads;
+	for (auto it = records.begin(); it != records.end(); ++it)
+	{
+		if (thread_index.find(it->thread_id) == thread_index.end())
+		{
+			thread_index[it->thread_id] = (unsigned)threads.size();
+			threads.push_back(it->thread_id);
+		}
+	}
+
+	writeVarint(out, threads.size());
+	for (auto it = threads.begin(); it != threads.end(); ++it)
+		writeVarint(out, *it);
+
+	size_t count = 0;
+	for (auto it = records.begin(); it != records.end(); ++it)
+		if (stack_ids[it->node] != NO_STACK_ID)
+			count++;
+	writeVarint(out, count);
+
+	// A thread tends to be sampled in the same place over and over,
+	// so its stack IDs are stored relative to its previous one.
+	std::vector<long long> prev_stack(threads.size(), 0);
+	unsigned long long prev_time = 0;
+
+	for (auto it = records.begin(); it != records.end(); ++it)
+	{
+		unsigned stack = stack_ids[it->node];
+		if (stack == NO_STACK_ID)
+			continue;
+
+		unsigned long long time = toMicroseconds(it->time - start);
+		if (time < prev_time)
+			time = prev_time;
+		unsigned index = thread_index[it->thread_id];
+
+		writeVarint(out, time - prev_time);
+		writeVarint(out, index);
+		writeVarint(out, zigzagEncode((long long)stack - prev_stack[index]));
+		writeVarint(out, (unsigned long long)(it->weight * 1e6 + 0.5));
+
+		prev_time = time;
+		prev_stack[index] = stack;
+	}
+}
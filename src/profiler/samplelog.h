@@ -0,0 +1,86 @@
+/*=====================================================================
+samplelog.h
+-----------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __SAMPLELOG_H_666_
+#define __SAMPLELOG_H_666_
+
+#include "profiler.h"
+#include "callstacktrie.h"
+#include <vector>
+
+/*=====================================================================
+SampleLog
+---------
+When and on which thread each sample was taken, and which callstack
+it hit, so that a capture can be narrowed down to part of its run.
+
+Like the trie it refers to, a log is only written by one thread.
+It is saved as Samples.bin:
+
+	varint   number of threads, then each thread ID
+	varint   number of records, then for each record:
+	varint     microseconds since the previous record (the first: since the capture started)
+	varint     index of the thread in the list above
+	varint     zigzag delta from the same thread's previous stack ID
+	varint     weight of the sample, in microseconds
+
+A stack ID numbers the stacks of Callstacks.bin from 0, in the order
+they appear there.
+=====================================================================*/
+class SampleLog
+{
+public:
+	struct Record
+	{
+		LONGLONG              time; // QueryPerformanceCounter ticks
+		DWORD                 thread_id;
+		CallStackTrie::NodeID node;
+		SAMPLE_TYPE           weight;
+	};
+
+	void add(LONGLONG time, DWORD thread_id, CallStackTrie::NodeID node, SAMPLE_TYPE weight)
+	{
+		// Empty stacks aren't saved, so neither are their samples.
+		if (node == CallStackTrie::ROOT)
+			return;
+		Record record = { time, thread_id, node, weight };
+		records.push_back(record);
+	}
+
+	/// Append another log, whose nodes mapping translates into this log's trie.
+	void append(const SampleLog &other, const std::vector<CallStackTrie::NodeID> &mapping);
+
+	void sortByTime();
+
+	/// Encode as Samples.bin. stack_ids maps each node to its stack ID, or to
+	/// NO_STACK_ID if the node isn't saved as a stack.
+	void encode(std::vector<unsigned char> &out, LONGLONG start, const std::vector<unsigned> &stack_ids) const;
+
+	static const unsigned NO_STACK_ID = ~0u;
+
+	size_t size() const { return records.size(); }
+
+private:
+	std::vector<Record> records;
+};
+
+#endif //__SAMPLELOG_H_666_
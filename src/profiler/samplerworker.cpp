@@ -0,0 +1,224 @@
+/*=====================================================================
+samplerworker.cpp
+-----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "samplerworker.h"
+#include "unwindthread.h"
+#include <assert.h>
+#include <algorithm>
+
+#pragma comment(lib, "winmm.lib")
+
+SamplerWorker::SamplerWorker(HANDLE target_process_, SymbolInfo *sym_info_, UnwindCache *unwind_cache_, double rate, double jitter, bool deferredUnwind, bool keepSampleLog)
+:	target_process(target_process_),
+	sym_info(sym_info_),
+	unwind_cache(unwind_cache_),
+	samplelog(keepSampleLog ? &log : NULL),
+	unwinder(NULL),
+	scheduler(rate, jitter),
+	paused(false),
+	numSamples(0),
+	numThreadsRunning(0),
+	numThreads(0),
+	numRetired(0),
+	failed(false)
+{
+	if (deferredUnwind)
+		unwinder = new UnwindThread(callstacks, timings, samplelog, sym_info, unwind_cache);
+}
+
+SamplerWorker::~SamplerWorker()
+{
+	delete unwinder;
+}
+
+void SamplerWorker::addThread(HANDLE target_thread)
+{
+	// Counted as running until proven otherwise, so that the capture
+	// isn't considered over while the new thread waits to be sampled.
+	Lock lock(inbox_mutex);
+	inbox.push_back(target_thread);
+	numThreads++;
+	numThreadsRunning++;
+}
+
+void SamplerWorker::takeNewThreads()
+{
+	Lock lock(inbox_mutex);
+	if (inbox.empty())
+		return;
+
+	// Sampled from now on, so their first sample only covers the time since now.
+	LONGLONG now = SampleTimings::now();
+	for (auto it = inbox.begin(); it != inbox.end(); ++it)
+	{
+		profilers.push_back(Profiler(target_process, *it, callstacks, timings, samplelog, unwind_cache));
+		profilers.back().resetClock(now);
+	}
+	inbox.clear();
+}
+
+int SamplerWorker::getNumDropped() const
+{
+	return unwinder ? unwinder->getNumDropped() : 0;
+}
+
+void SamplerWorker::sample()
+{
+	// DE: 20090325: Profiler has a list of threads to profile, one Profiler instance per thread
+	// RJM- We traverse them in random order. The act of profiling causes the Windows scheduler
+	//      to re-schedule, and if we did them in sequence, it'll always schedule the first one.
+	//      This starves the other N-1 threads. For lack of a better option, using a shuffle
+	//      at least re-schedules them evenly.
+
+	takeNewThreads();
+
+	const size_t count = profilers.size();
+	if ( count == 0)
+		return;
+
+	size_t *order = (size_t *)alloca( count * sizeof(size_t) );
+	for (size_t n=0;n<count;n++)
+		order[n] = n;
+	for (size_t n=count;n--;)
+	{
+		size_t i = rand() * count / (RAND_MAX+1);
+		assert( i < count );
+		std::swap( order[i], order[n] );
+	}
+
+	bool *sampled = (bool *)alloca( count * sizeof(bool) );
+
+	int numSuccessful = 0;
+	for (size_t n = 0;n < count; ++n)
+	{
+		Profiler& profiler = profilers[order[n]];
+		sampled[order[n]] = false;
+		try {
+			if (profiler.sampleTarget(sym_info, scratch, unwinder))
+			{
+				++numSamples;
+				++numSuccessful;
+				sampled[order[n]] = true;
+			}
+		}
+		catch (const ProfilerExcep& e)
+		{
+			errorText = L"ProfilerExcep: " + e.what();
+			failed = true;
+			this->commit_suicide = true;
+		}
+	}
+
+	// Retire the threads that have exited, so that
+	// short-lived threads don't pile up over a long capture.
+	size_t kept = 0;
+	for (size_t n = 0;n < count; ++n)
+	{
+		if (!sampled[n] && profilers[n].targetExited())
+			continue;
+		if (kept != n)
+			profilers[kept] = profilers[n];
+		kept++;
+	}
+	int retired = (int)(count - kept);
+	profilers.erase(profilers.begin() + kept, profilers.end());
+
+	Lock lock(inbox_mutex);
+	numRetired += retired;
+	numThreads -= retired;
+	numThreadsRunning = numSuccessful + (int)inbox.size();
+}
+
+void SamplerWorker::resetClocks()
+{
+	LONGLONG now = SampleTimings::now();
+	for (auto it = profilers.begin(); it != profilers.end(); ++it)
+		it->resetClock(now);
+}
+
+void SamplerWorker::sampleLoop()
+{
+	timeBeginPeriod(1);
+
+	bool was_paused = false;
+
+	resetClocks();
+	scheduler.start();
+
+	while(!this->commit_suicide)
+	{
+		if (paused)
+		{
+			// Time spent paused is neither sampled nor counted towards the achieved rate.
+			if (!was_paused)
+				scheduler.stop();
+			was_paused = true;
+			Sleep(100);
+			continue;
+		}
+
+		if (was_paused)
+		{
+			was_paused = false;
+			resetClocks();
+			scheduler.start();
+		}
+
+		sample();
+
+		scheduler.waitForNext();
+	}
+
+	scheduler.stop();
+
+	timeEndPeriod(1);
+}
+
+void SamplerWorker::run()
+{
+	// The unwinder feeds this worker's trie, so it runs only while the worker does.
+	if (unwinder)
+		unwinder->launch(false, THREAD_PRIORITY_ABOVE_NORMAL);
+
+	try
+	{
+		sampleLoop();
+	} catch(ProfilerExcep& e) {
+		scheduler.stop();
+
+		// see if it's an actual error, or did the threads just finish naturally
+		for (auto it = profilers.begin(); it != profilers.end(); ++it)
+		{
+			if (!it->targetExited())
+			{
+				errorText = L"ProfilerExcep: " + e.what();
+				failed = true;
+				break;
+			}
+		}
+
+		numThreadsRunning = 0;
+	}
+
+	// Let the unwinder catch up, so the trie holds every sample we took.
+	if (unwinder)
+		unwinder->finish();
+}
@@ -0,0 +1,115 @@
+/*=====================================================================
+samplerworker.h
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __SAMPLERWORKER_H_666_
+#define __SAMPLERWORKER_H_666_
+
+#include "../utils/mythread.h"
+#include "../utils/mutex.h"
+#include "profiler.h"
+#include "callstacktrie.h"
+#include "sampletimings.h"
+#include "samplescheduler.h"
+#include "samplelog.h"
+#include "stacksnapshot.h"
+#include <vector>
+
+/*=====================================================================
+SamplerWorker
+-------------
+Samples one shard of the target's threads on its own schedule.
+
+Each worker aggregates into its own trie and timings, so workers never
+contend while sampling; ProfilerThread merges them once they have all
+stopped. Frame-pointer walks need no locks, but the stacks they can't
+finish go through DbgHelp, which is single threaded, so those walks are
+serialized on SymbolInfo::dbghelp_mutex.
+=====================================================================*/
+class SamplerWorker : public MyThread
+{
+public:
+	SamplerWorker(HANDLE target_process, SymbolInfo *sym_info, UnwindCache *unwind_cache, double rate, double jitter, bool deferredUnwind, bool keepSampleLog);
+	virtual ~SamplerWorker();
+
+	/// Add a thread to this worker's shard. May be called while sampling;
+	/// the thread is picked up at the start of the next round.
+	void addThread(HANDLE target_thread);
+
+	virtual void run();
+
+	void setPaused(bool paused_) { paused = paused_; }
+
+	int getNumSamples() const { return numSamples; }
+	int getNumThreads() const { return numThreads; }
+	int getNumThreadsRunning() const { return numThreadsRunning; }
+	int getNumRetired() const { return numRetired; }
+	int getNumDropped() const;
+	bool getFailed() const { return failed; }
+	const std::wstring &getError() const { return errorText; }
+	const SampleScheduler &getScheduler() const { return scheduler; }
+
+	// Only valid once the worker has stopped.
+	const CallStackTrie &getCallstacks() const { return callstacks; }
+	const SampleTimings &getTimings() const { return timings; }
+	/// NULL unless keeping a sample log.
+	const SampleLog *getSampleLog() const { return samplelog; }
+
+private:
+	void sample();
+	void sampleLoop();
+	void resetClocks();
+	void takeNewThreads();
+
+	HANDLE target_process;
+	SymbolInfo *sym_info;
+	UnwindCache *unwind_cache;
+
+	CallStackTrie callstacks;
+	SampleTimings timings;
+	SampleLog log;
+	SampleLog *samplelog; // &log, or NULL if not keeping one
+
+	// DE: 20090325 one Profiler instance per thread to profile
+	// Only touched by the worker's own thread once it is running.
+	std::vector<Profiler> profilers;
+
+	// Threads added by addThread, not yet given a Profiler.
+	Mutex inbox_mutex;
+	std::vector<HANDLE> inbox;
+
+	// Where stacks are copied to and walked, unless unwinding is deferred.
+	StackSnapshot scratch;
+
+	// Walks copied stacks when sampling with deferred unwinding, NULL otherwise.
+	UnwindThread *unwinder;
+	SampleScheduler scheduler;
+
+	volatile bool paused;
+	volatile int numSamples;
+	volatile int numThreadsRunning;
+	volatile int numThreads;
+	volatile int numRetired;
+	volatile bool failed;
+	std::wstring errorText;
+};
+
+#endif //__SAMPLERWORKER_H_666_
@@ -0,0 +1,144 @@
+/*=====================================================================
+samplescheduler.cpp
+-------------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "samplescheduler.h"
+#include "sampletimings.h"
+
+// Only in the Windows 10 SDK; older systems fail the call and we fall back.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+// The last part of a wait is spent yielding instead of on the timer,
+// whose wakeups may be up to a millisecond late.
+#define SPIN_MICROSECONDS 100
+
+SampleScheduler::SampleScheduler(double rate_, double jitter_)
+:	rate(rate_ < 1 ? 1 : rate_),
+	jitter(jitter_ < 0 ? 0 : jitter_ > 0.9 ? 0.9 : jitter_),
+	deadline(0),
+	startTime(0),
+	activeTime(0),
+	running(false),
+	numRounds(0),
+	numMissed(0)
+{
+	freq = SampleTimings::frequency();
+	period = (LONGLONG)((double)freq / rate);
+	if (period < 1)
+		period = 1;
+
+	random = (unsigned long long)SampleTimings::now() | 1;
+
+	timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (!timer)
+		timer = CreateWaitableTimerW(NULL, TRUE, NULL);
+}
+
+SampleScheduler::~SampleScheduler()
+{
+	if (timer)
+		CloseHandle(timer);
+}
+
+void SampleScheduler::start()
+{
+	startTime = SampleTimings::now();
+	deadline = startTime + nextPeriod();
+	running = true;
+}
+
+void SampleScheduler::stop()
+{
+	if (!running)
+		return;
+	activeTime += SampleTimings::now() - startTime;
+	running = false;
+}
+
+void SampleScheduler::waitForNext()
+{
+	numRounds++;
+	waitUntil(deadline);
+
+	// If the last round overran by more than a period, skip the deadlines
+	// it missed instead of sampling back to back to catch up.
+	LONGLONG now = SampleTimings::now();
+	if (now - deadline >= period)
+	{
+		numMissed += (now - deadline) / period;
+		deadline = now;
+	}
+
+	deadline += nextPeriod();
+}
+
+double SampleScheduler::getAchievedRate() const
+{
+	LONGLONG ticks = activeTime;
+	if (running)
+		ticks += SampleTimings::now() - startTime;
+	if (ticks <= 0)
+		return 0;
+	return (double)numRounds * (double)freq / (double)ticks;
+}
+
+// One period, moved by up to +/- jitter of a period.
+// The moves average out, so the mean rate is unaffected.
+LONGLONG SampleScheduler::nextPeriod()
+{
+	if (jitter == 0)
+		return period;
+
+	// xorshift64
+	random ^= random << 13;
+	random ^= random >> 7;
+	random ^= random << 17;
+
+	double u = (double)(random >> 11) / (double)(1ULL << 53); // [0,1)
+	return period + (LONGLONG)((2 * u - 1) * jitter * (double)period);
+}
+
+void SampleScheduler::waitUntil(LONGLONG when)
+{
+	const LONGLONG spin = freq * SPIN_MICROSECONDS / 1000000;
+
+	for (;;)
+	{
+		LONGLONG remaining = when - SampleTimings::now();
+		if (remaining <= 0)
+			return;
+
+		if (timer && remaining > spin)
+		{
+			// Relative due time, in 100ns units.
+			LARGE_INTEGER due;
+			due.QuadPart = -(LONGLONG)((double)(remaining - spin) * 1e7 / (double)freq);
+			if (due.QuadPart < 0 && SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE))
+			{
+				WaitForSingleObject(timer, INFINITE);
+				continue;
+			}
+		}
+
+		SwitchToThread();
+	}
+}
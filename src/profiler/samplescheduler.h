@@ -0,0 +1,71 @@
+/*=====================================================================
+samplescheduler.h
+-----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __SAMPLESCHEDULER_H_666_
+#define __SAMPLESCHEDULER_H_666_
+
+#include <windows.h>
+
+/*=====================================================================
+SampleScheduler
+---------------
+Paces sampling rounds against absolute deadlines, so that the rate
+does not drift with the number of threads or the cost of a round.
+
+Each deadline is one period after the previous one, optionally moved
+by a random amount (jitter) to avoid aliasing with periodic work in
+the target. If a round overruns by more than a period, the missed
+deadlines are skipped rather than sampled back to back.
+=====================================================================*/
+class SampleScheduler
+{
+public:
+	/// rate is in Hz; jitter is the largest deviation, as a fraction of the period.
+	SampleScheduler(double rate, double jitter);
+	~SampleScheduler();
+
+	/// Start (or restart, e.g. after a pause) the deadline sequence from now.
+	void start();
+	/// Block until the next deadline, and schedule the one after it.
+	void waitForNext();
+	/// Stop counting elapsed time, e.g. while paused.
+	void stop();
+
+	double getRequestedRate() const { return rate; }
+	double getAchievedRate() const;
+	unsigned long long getNumMissed() const { return numMissed; }
+
+private:
+	double rate, jitter;
+	LONGLONG freq, period;
+	LONGLONG deadline;
+	LONGLONG startTime, activeTime;
+	bool running;
+	unsigned long long numRounds, numMissed;
+	unsigned long long random;
+	HANDLE timer;
+
+	LONGLONG nextPeriod();
+	void waitUntil(LONGLONG when);
+};
+
+#endif //__SAMPLESCHEDULER_H_666_
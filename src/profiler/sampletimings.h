@@ -0,0 +1,92 @@
+/*=====================================================================
+sampletimings.h
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __SAMPLETIMINGS_H_666_
+#define __SAMPLETIMINGS_H_666_
+
+#include <windows.h>
+#include "../utils/histogram.h"
+
+/*=====================================================================
+SampleTimings
+-------------
+How long each part of taking a sample took, in nanoseconds.
+This is how much the profiler perturbed the target, and is saved in
+the capture so it can be checked afterwards.
+=====================================================================*/
+struct SampleTimings
+{
+	/// Time the target thread was kept suspended.
+	LogHistogram suspend;
+	/// Time spent walking the stack, whether suspended or not.
+	LogHistogram walk;
+	/// Time spent adding the stack to the trie.
+	LogHistogram aggregate;
+
+	/// Unwind rules found in the UnwindCache, and worked out afresh.
+	/// Counted here, by each worker, rather than in the shared cache.
+	unsigned long long unwind_cache_hits, unwind_cache_misses;
+
+	SampleTimings() : unwind_cache_hits(0), unwind_cache_misses(0) {}
+
+	void merge(const SampleTimings &other)
+	{
+		suspend.merge(other.suspend);
+		walk.merge(other.walk);
+		aggregate.merge(other.aggregate);
+		unwind_cache_hits += other.unwind_cache_hits;
+		unwind_cache_misses += other.unwind_cache_misses;
+	}
+
+	static LONGLONG now()
+	{
+		LARGE_INTEGER t;
+		QueryPerformanceCounter(&t);
+		return t.QuadPart;
+	}
+
+	static LONGLONG frequency()
+	{
+		static LONGLONG freq = 0;
+		if (!freq)
+		{
+			LARGE_INTEGER f;
+			QueryPerformanceFrequency(&f);
+			freq = f.QuadPart;
+		}
+		return freq;
+	}
+
+	static unsigned long long toNanoseconds(LONGLONG ticks)
+	{
+		if (ticks <= 0)
+			return 0;
+		return (unsigned long long)((double)ticks * 1e9 / (double)frequency());
+	}
+
+	static double toSeconds(LONGLONG ticks)
+	{
+		return (double)ticks / (double)frequency();
+	}
+};
+
+#endif //__SAMPLETIMINGS_H_666_
@@ -0,0 +1,79 @@
+/*=====================================================================
+stacksnapshot.h
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __STACKSNAPSHOT_H_666_
+#define __STACKSNAPSHOT_H_666_
+
+#include "profiler.h"
+#include <vector>
+
+#ifdef _WIN64
+#define CONTEXT64_FLAGS		(CONTEXT_AMD64 | CONTEXT_FULL)
+#define CONTEXT32_FLAGS		(WOW64_CONTEXT_i386 | WOW64_CONTEXT_FULL)
+typedef CONTEXT CONTEXT64;
+typedef WOW64_CONTEXT CONTEXT32;
+#else
+#define CONTEXT32_FLAGS		(CONTEXT_i386 | CONTEXT_FULL)
+typedef CONTEXT CONTEXT32;
+#endif
+
+/// Register state of a 64-bit or 32-bit (possibly WoW64) thread.
+union ThreadContext
+{
+#ifdef _WIN64
+	CONTEXT64 context64;
+#endif
+	CONTEXT32 context32;
+};
+
+/*=====================================================================
+StackSnapshot
+-------------
+The registers and a raw copy of the top of the stack of a suspended
+thread, taken so that it can be resumed before the stack is walked.
+=====================================================================*/
+struct StackSnapshot
+{
+	StackSnapshot() : stack(MAX_STACK_COPY), stack_size(0) {}
+
+	HANDLE target_process, target_thread;
+	bool is64BitProcess;
+
+	ThreadContext context;
+
+	/// The copy covers [stack_addr, stack_addr + stack_size).
+	PROFILER_ADDR stack_addr;
+	/// The top of the thread's stack. Memory between the end of the
+	/// copy and this may have changed since, so it must not be read.
+	PROFILER_ADDR stack_limit;
+	std::vector<BYTE> stack;
+	size_t stack_size;
+
+	SAMPLE_TYPE timeSpent;
+	/// When the thread was suspended, and which thread it was, for the sample log.
+	LONGLONG timestamp;
+	DWORD thread_id;
+
+	bool contains(PROFILER_ADDR addr) const { return addr >= stack_addr && addr < stack_limit; }
+};
+
+#endif //__STACKSNAPSHOT_H_666_
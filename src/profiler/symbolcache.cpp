@@ -0,0 +1,540 @@
+/*=====================================================================
+symbolcache.cpp
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "symbolcache.h"
+#include <algorithm>
+#include <set>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Anything bigger isn't a cache this wrote.
+static const unsigned long long MAX_CACHE_SIZE = 0x40000000;
+
+// What the files in a cache directory may add up to, unless told otherwise.
+static const unsigned long long DEFAULT_MAX_TOTAL_SIZE = 256 << 20;
+
+static const char CACHE_EXTENSION[] = ".symcache";
+
+struct CacheFile
+{
+	std::string name;
+	unsigned long long size, time;
+
+	bool operator<(const CacheFile &other) const { return time < other.time; }
+};
+
+#if defined(_WIN32)
+#include <windows.h>
+#include "../utils/osutils.h"
+
+static std::wstring widen(const std::string &utf8)
+{
+	int len = MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, NULL, 0);
+	std::vector<wchar_t> buf(len > 0 ? len : 1);
+	MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, &buf[0], (int)buf.size());
+	return &buf[0];
+}
+
+static void *mapFile(const std::string &path, size_t &size) { return MapWholeFile(widen(path), size, MAX_CACHE_SIZE); }
+static void unmapFile(void *data, size_t) { UnmapWholeFile(data); }
+static FILE *createFile(const std::string &path) { return _wfopen(widen(path).c_str(), L"wb"); }
+static bool replaceFile(const std::string &from, const std::string &to) { return MoveFileOver(widen(from), widen(to)); }
+static void removeFile(const std::string &path) { DeleteFileW(widen(path).c_str()); }
+static void makeDirectory(const std::string &path) { CreateDirectoryW(widen(path).c_str(), NULL); }
+static unsigned getProcessId() { return GetCurrentProcessId(); }
+
+static std::string narrow(const wchar_t *wide)
+{
+	int len = WideCharToMultiByte(CP_UTF8, 0, wide, -1, NULL, 0, NULL, NULL);
+	std::vector<char> buf(len > 0 ? len : 1);
+	WideCharToMultiByte(CP_UTF8, 0, wide, -1, &buf[0], (int)buf.size(), NULL, NULL);
+	return &buf[0];
+}
+
+static void listFiles(const std::string &dir, std::vector<CacheFile> &files)
+{
+	WIN32_FIND_DATAW found;
+	HANDLE find = FindFirstFileW(widen(dir + "\\*" + CACHE_EXTENSION).c_str(), &found);
+	if (find == INVALID_HANDLE_VALUE)
+		return;
+	do
+	{
+		if (found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			continue;
+		CacheFile file;
+		file.name = narrow(found.cFileName);
+		file.size = ((unsigned long long)found.nFileSizeHigh << 32) | found.nFileSizeLow;
+		file.time = ((unsigned long long)found.ftLastWriteTime.dwHighDateTime << 32) | found.ftLastWriteTime.dwLowDateTime;
+		files.push_back(file);
+	} while (FindNextFileW(find, &found));
+	FindClose(find);
+}
+
+static void touchFile(const std::string &path)
+{
+	HANDLE file = CreateFileW(widen(path).c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+							  NULL, OPEN_EXISTING, 0, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+	FILETIME now;
+	GetSystemTimeAsFileTime(&now);
+	SetFileTime(file, NULL, NULL, &now);
+	CloseHandle(file);
+}
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+static void *mapFile(const std::string &path, size_t &size)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	void *data = NULL;
+	struct stat st;
+	if (fstat(fd, &st) == 0 && st.st_size > 0 && (unsigned long long)st.st_size <= MAX_CACHE_SIZE)
+	{
+		data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+			data = NULL;
+		size = st.st_size;
+	}
+	close(fd);
+	return data;
+}
+
+static void unmapFile(void *data, size_t size) { munmap(data, size); }
+static FILE *createFile(const std::string &path) { return fopen(path.c_str(), "wb"); }
+static bool replaceFile(const std::string &from, const std::string &to) { return rename(from.c_str(), to.c_str()) == 0; }
+static void removeFile(const std::string &path) { unlink(path.c_str()); }
+static void makeDirectory(const std::string &path) { mkdir(path.c_str(), 0755); }
+static unsigned getProcessId() { return (unsigned)getpid(); }
+static void touchFile(const std::string &path) { utime(path.c_str(), NULL); }
+
+static void listFiles(const std::string &dir, std::vector<CacheFile> &files)
+{
+	DIR *d = opendir(dir.c_str());
+	if (!d)
+		return;
+	const size_t ext_len = sizeof(CACHE_EXTENSION) - 1;
+	while (struct dirent *entry = readdir(d))
+	{
+		std::string name = entry->d_name;
+		struct stat st;
+		if (name.size() <= ext_len || name.compare(name.size() - ext_len, ext_len, CACHE_EXTENSION) != 0 ||
+			stat((dir + "/" + name).c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+			continue;
+		CacheFile file;
+		file.name = name;
+		file.size = st.st_size;
+		file.time = st.st_mtime;
+		files.push_back(file);
+	}
+	closedir(d);
+}
+#endif
+
+// Bump when the layout changes; files of other versions are ignored, and
+// replaced when next saved.
+static const unsigned CACHE_VERSION = 2;
+static const char CACHE_MAGIC[4] = { 'S', 'S', 'Y', 'M' };
+
+CachedSymbols::CachedSymbols(const std::string &path_)
+:	path(path_),
+	mapping(NULL),
+	mapping_size(0),
+	addrs(NULL),
+	procs(NULL),
+	inlines(NULL),
+	header(NULL),
+	strings(NULL)
+{
+	map();
+}
+
+CachedSymbols::~CachedSymbols()
+{
+	unmap();
+}
+
+void CachedSymbols::map()
+{
+	mapping = mapFile(path, mapping_size);
+	if (!mapping)
+		return;
+
+	// Anything that doesn't add up is treated as no file at all.
+	const Header *h = (const Header *)mapping;
+	if (mapping_size < sizeof(Header) ||
+		memcmp(h->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+		h->version != CACHE_VERSION ||
+		h->num_addrs > mapping_size / sizeof(AddrRecord) ||
+		h->num_procs > mapping_size / sizeof(ProcRecord) ||
+		h->num_inlines > mapping_size / sizeof(InlineRecord) ||
+		mapping_size != sizeof(Header) + h->num_addrs * sizeof(AddrRecord) +
+			h->num_procs * sizeof(ProcRecord) + h->num_inlines * sizeof(InlineRecord) + h->strings_size ||
+		h->strings_size == 0 ||
+		((const char *)mapping)[mapping_size - 1] != 0)
+	{
+		unmap();
+		return;
+	}
+
+	header = h;
+	addrs = (const AddrRecord *)(header + 1);
+	procs = (const ProcRecord *)(addrs + header->num_addrs);
+	inlines = (const InlineRecord *)(procs + header->num_procs);
+	strings = (const char *)(inlines + header->num_inlines);
+}
+
+void CachedSymbols::unmap()
+{
+	if (mapping)
+		unmapFile(mapping, mapping_size);
+	mapping = NULL;
+	mapping_size = 0;
+	header = NULL;
+	addrs = NULL;
+	procs = NULL;
+	inlines = NULL;
+	strings = NULL;
+}
+
+const char *CachedSymbols::getString(unsigned offset) const
+{
+	// The last byte of the strings is a NUL, so any offset in range is terminated.
+	return offset < header->strings_size ? strings + offset : "";
+}
+
+bool CachedSymbols::findAddr(unsigned rva, std::string &proc, std::string &file, unsigned &line,
+							 std::vector<Inlined> *inlined) const
+{
+	std::map<unsigned, Addr>::const_iterator it = new_addrs.find(rva);
+	if (it != new_addrs.end())
+	{
+		proc = it->second.proc;
+		file = it->second.file;
+		line = it->second.line;
+		if (inlined)
+			*inlined = it->second.inlined;
+		return true;
+	}
+
+	if (!header)
+		return false;
+
+	const AddrRecord *end = addrs + header->num_addrs;
+	const AddrRecord *record = std::upper_bound(addrs, end, rva, rvaBefore);
+	if (record == addrs || (--record)->rva != rva)
+		return false;
+
+	proc = getString(record->proc);
+	file = getString(record->file);
+	line = record->line;
+	if (inlined)
+		readInlined(*record, *inlined);
+	return true;
+}
+
+void CachedSymbols::readInlined(const AddrRecord &record, std::vector<Inlined> &inlined) const
+{
+	inlined.clear();
+	if (record.first_inline > header->num_inlines || record.num_inlines > header->num_inlines - record.first_inline)
+		return;
+
+	inlined.resize(record.num_inlines);
+	for (unsigned i = 0; i < record.num_inlines; i++)
+	{
+		const InlineRecord &frame = inlines[record.first_inline + i];
+		inlined[i].proc = getString(frame.proc);
+		inlined[i].file = getString(frame.file);
+		inlined[i].line = frame.line;
+	}
+}
+
+bool CachedSymbols::findProc(unsigned rva, unsigned &start, unsigned &end, std::string &proc) const
+{
+	std::map<unsigned, Proc>::const_iterator it = new_procs.upper_bound(rva);
+	if (it != new_procs.begin() && rva < (--it)->second.end)
+	{
+		start = it->first;
+		end = it->second.end;
+		proc = it->second.proc;
+		return true;
+	}
+
+	if (!header)
+		return false;
+
+	const ProcRecord *last = procs + header->num_procs;
+	const ProcRecord *record = std::upper_bound(procs, last, rva, startBefore);
+	if (record == procs || rva >= (--record)->end)
+		return false;
+
+	start = record->start;
+	end = record->end;
+	proc = getString(record->proc);
+	return true;
+}
+
+void CachedSymbols::addAddr(unsigned rva, const std::string &proc, const std::string &file, unsigned line,
+							const std::vector<Inlined> *inlined)
+{
+	Addr &addr = new_addrs[rva];
+	addr.proc = proc;
+	addr.file = file;
+	addr.line = line;
+	if (inlined)
+		addr.inlined = *inlined;
+	else
+		addr.inlined.clear();
+}
+
+void CachedSymbols::addProc(unsigned start, unsigned end, const std::string &proc)
+{
+	Proc &p = new_procs[start];
+	p.end = end;
+	p.proc = proc;
+}
+
+// Interns strings for the file being written.
+class StringTable
+{
+public:
+	StringTable() { add(""); }
+
+	unsigned add(const std::string &s)
+	{
+		std::map<std::string, unsigned>::iterator it = offsets.find(s);
+		if (it != offsets.end())
+			return it->second;
+
+		unsigned offset = (unsigned)data.size();
+		data.insert(data.end(), s.c_str(), s.c_str() + s.size() + 1);
+		offsets[s] = offset;
+		return offset;
+	}
+
+	std::vector<char> data;
+
+private:
+	std::map<std::string, unsigned> offsets;
+};
+
+bool CachedSymbols::save()
+{
+	if (new_addrs.empty() && new_procs.empty())
+		return true;
+
+	// Merge what the file had with what's been added, which takes precedence.
+	std::map<unsigned, Addr> all_addrs;
+	std::map<unsigned, Proc> all_procs;
+	if (header)
+	{
+		for (unsigned i = 0; i < header->num_addrs; i++)
+		{
+			Addr &addr = all_addrs[addrs[i].rva];
+			addr.proc = getString(addrs[i].proc);
+			addr.file = getString(addrs[i].file);
+			addr.line = addrs[i].line;
+			readInlined(addrs[i], addr.inlined);
+		}
+		for (unsigned i = 0; i < header->num_procs; i++)
+		{
+			Proc &proc = all_procs[procs[i].start];
+			proc.end = procs[i].end;
+			proc.proc = getString(procs[i].proc);
+		}
+	}
+	for (std::map<unsigned, Addr>::const_iterator it = new_addrs.begin(); it != new_addrs.end(); ++it)
+		all_addrs[it->first] = it->second;
+	for (std::map<unsigned, Proc>::const_iterator it = new_procs.begin(); it != new_procs.end(); ++it)
+		all_procs[it->first] = it->second;
+
+	StringTable table;
+	std::vector<AddrRecord> addr_records;
+	std::vector<InlineRecord> inline_records;
+	addr_records.reserve(all_addrs.size());
+	for (std::map<unsigned, Addr>::const_iterator it = all_addrs.begin(); it != all_addrs.end(); ++it)
+	{
+		const std::vector<Inlined> &inlined = it->second.inlined;
+		AddrRecord record = { it->first, table.add(it->second.proc), table.add(it->second.file), it->second.line,
+							  (unsigned)inline_records.size(), (unsigned)inlined.size() };
+		addr_records.push_back(record);
+
+		for (size_t i = 0; i < inlined.size(); i++)
+		{
+			InlineRecord frame = { table.add(inlined[i].proc), table.add(inlined[i].file), inlined[i].line };
+			inline_records.push_back(frame);
+		}
+	}
+
+	std::vector<ProcRecord> proc_records;
+	proc_records.reserve(all_procs.size());
+	for (std::map<unsigned, Proc>::const_iterator it = all_procs.begin(); it != all_procs.end(); ++it)
+	{
+		// Keep ranges from overlapping, so that a search finds the right one.
+		if (!proc_records.empty() && it->first < proc_records.back().end)
+			continue;
+		ProcRecord record = { it->first, it->second.end, table.add(it->second.proc) };
+		proc_records.push_back(record);
+	}
+
+	Header h;
+	memcpy(h.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	h.version = CACHE_VERSION;
+	h.num_addrs = (unsigned)addr_records.size();
+	h.num_procs = (unsigned)proc_records.size();
+	h.num_inlines = (unsigned)inline_records.size();
+	h.strings_size = (unsigned)table.data.size();
+
+	// Written beside the old file, then moved over it.
+	char suffix[32];
+	sprintf(suffix, ".%u.tmp", getProcessId());
+	std::string temp_path = path + suffix;
+
+	FILE *f = createFile(temp_path);
+	if (!f)
+		return false;
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+	if (ok && !addr_records.empty())
+		ok = fwrite(&addr_records[0], sizeof(AddrRecord), addr_records.size(), f) == addr_records.size();
+	if (ok && !proc_records.empty())
+		ok = fwrite(&proc_records[0], sizeof(ProcRecord), proc_records.size(), f) == proc_records.size();
+	if (ok && !inline_records.empty())
+		ok = fwrite(&inline_records[0], sizeof(InlineRecord), inline_records.size(), f) == inline_records.size();
+	if (ok)
+		ok = fwrite(&table.data[0], 1, table.data.size(), f) == table.data.size();
+	if (fclose(f) != 0)
+		ok = false;
+
+	unmap();
+	if (ok)
+		ok = replaceFile(temp_path, path);
+	if (!ok)
+		removeFile(temp_path);
+
+	new_addrs.clear();
+	new_procs.clear();
+	map();
+	return ok;
+}
+
+SymbolCache::SymbolCache()
+:	max_size(DEFAULT_MAX_TOTAL_SIZE)
+{
+}
+
+SymbolCache::~SymbolCache()
+{
+	for (std::map<std::string, CachedSymbols *>::iterator it = modules.begin(); it != modules.end(); ++it)
+		delete it->second;
+}
+
+void SymbolCache::setDirectory(const std::string &dir_)
+{
+	dir = dir_;
+	while (!dir.empty() && (dir[dir.size() - 1] == '/' || dir[dir.size() - 1] == '\\'))
+		dir.erase(dir.size() - 1);
+	if (dir.empty())
+		return;
+
+	// Make each missing directory on the way down.
+	for (size_t i = 1; i <= dir.size(); i++)
+		if (i == dir.size() || dir[i] == '/' || dir[i] == '\\')
+			makeDirectory(dir.substr(0, i));
+}
+
+CachedSymbols *SymbolCache::getModule(const std::string &key)
+{
+	if (dir.empty() || key.empty())
+		return NULL;
+
+	std::map<std::string, CachedSymbols *>::iterator it = modules.find(key);
+	if (it != modules.end())
+		return it->second;
+
+	// Used files are touched, so that trim() goes for the ones that aren't.
+	std::string path = dir + "/" + getFileName(key);
+	touchFile(path);
+
+	CachedSymbols *module = new CachedSymbols(path);
+	modules[key] = module;
+	return module;
+}
+
+std::string SymbolCache::getFileName(const std::string &key)
+{
+	// Keys are made of module names and numbers, but keep them to
+	// characters that are safe in a file name anywhere.
+	std::string name;
+	for (size_t i = 0; i < key.size(); i++)
+	{
+		char c = key[i];
+		bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+			c == '.' || c == '-' || c == '_';
+		name += safe ? c : '_';
+	}
+	return name + CACHE_EXTENSION;
+}
+
+void SymbolCache::save()
+{
+	for (std::map<std::string, CachedSymbols *>::iterator it = modules.begin(); it != modules.end(); ++it)
+		it->second->save();
+	trim();
+}
+
+void SymbolCache::trim()
+{
+	if (dir.empty())
+		return;
+
+	std::vector<CacheFile> files;
+	listFiles(dir, files);
+
+	unsigned long long total = 0;
+	for (size_t i = 0; i < files.size(); i++)
+		total += files[i].size;
+	if (total <= max_size)
+		return;
+
+	std::set<std::string> in_use;
+	for (std::map<std::string, CachedSymbols *>::const_iterator it = modules.begin(); it != modules.end(); ++it)
+		in_use.insert(getFileName(it->first));
+
+	// Least recently used first. A file another process has open may
+	// refuse to go; it's counted as gone all the same.
+	std::sort(files.begin(), files.end());
+	for (size_t i = 0; i < files.size() && total > max_size; i++)
+	{
+		if (in_use.count(files[i].name))
+			continue;
+		removeFile(dir + "/" + files[i].name);
+		total -= files[i].size;
+	}
+}
@@ -0,0 +1,183 @@
+/*=====================================================================
+symbolcache.h
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __SYMBOLCACHE_H_666_
+#define __SYMBOLCACHE_H_666_
+
+#include <map>
+#include <string>
+#include <vector>
+
+/*=====================================================================
+CachedSymbols
+-------------
+What the symbol lookups for one build of one module came back with,
+kept in a file so later captures needn't ask again.
+
+Addresses are relative to the module's base. Each looked-up address
+keeps its procedure, source file and line exactly as they were found
+(an empty procedure means there was none). The functions inlined at
+an address are InlineRecords, innermost first, in a run its AddrRecord
+points to. Function ranges are kept too, so that new addresses in a
+known function at least get its name.
+
+The file is memory mapped and searched in place: sorted arrays of
+fixed-size records, then the strings they refer to, in UTF-8. New
+entries are held in memory until save(), which writes the file afresh.
+Not thread safe; a module's lookups must all happen on one thread.
+=====================================================================*/
+class CachedSymbols
+{
+public:
+	explicit CachedSymbols(const std::string &path);
+	~CachedSymbols();
+
+	/// A function inlined at an address.
+	struct Inlined
+	{
+		std::string proc, file;
+		unsigned line;
+	};
+
+	bool findAddr(unsigned rva, std::string &proc, std::string &file, unsigned &line,
+				  std::vector<Inlined> *inlined = NULL) const;
+	/// The function whose range holds rva, as [start, end).
+	bool findProc(unsigned rva, unsigned &start, unsigned &end, std::string &proc) const;
+
+	void addAddr(unsigned rva, const std::string &proc, const std::string &file, unsigned line,
+				 const std::vector<Inlined> *inlined = NULL);
+	void addProc(unsigned start, unsigned end, const std::string &proc);
+
+	/// Rewrite the file, if anything was added. Returns false on failure.
+	bool save();
+
+private:
+	struct Header
+	{
+		char magic[4];
+		unsigned version;
+		unsigned num_addrs;
+		unsigned num_procs;
+		unsigned num_inlines;
+		unsigned strings_size;
+	};
+	struct AddrRecord
+	{
+		unsigned rva;
+		unsigned proc, file; ///< offsets into the strings
+		unsigned line;
+		unsigned first_inline, num_inlines; ///< a run of the InlineRecords
+	};
+	struct InlineRecord
+	{
+		unsigned proc, file;
+		unsigned line;
+	};
+	struct ProcRecord
+	{
+		unsigned start, end;
+		unsigned proc;
+	};
+
+	struct Addr
+	{
+		std::string proc, file;
+		unsigned line;
+		std::vector<Inlined> inlined;
+	};
+	struct Proc
+	{
+		unsigned end;
+		std::string proc;
+	};
+
+	std::string path;
+
+	// The mapped file, if there is a valid one.
+	void *mapping;
+	size_t mapping_size;
+	const AddrRecord *addrs;
+	const ProcRecord *procs;
+	const InlineRecord *inlines;
+	const Header *header;
+	const char *strings;
+
+	// Added since the file was mapped, by rva and by start.
+	std::map<unsigned, Addr> new_addrs;
+	std::map<unsigned, Proc> new_procs;
+
+	void map();
+	void unmap();
+	const char *getString(unsigned offset) const;
+	void readInlined(const AddrRecord &record, std::vector<Inlined> &inlined) const;
+
+	static bool rvaBefore(unsigned rva, const AddrRecord &record) { return rva < record.rva; }
+	static bool startBefore(unsigned rva, const ProcRecord &record) { return rva < record.start; }
+
+	CachedSymbols(const CachedSymbols &);
+	CachedSymbols &operator=(const CachedSymbols &);
+};
+
+/*=====================================================================
+SymbolCache
+-----------
+A directory of CachedSymbols, one file per module build. Keys are made
+by the caller from whatever identifies a build, and what was used to
+look it up: e.g. a PE's name, timestamp and image size, and which
+DbgHelp read which kind of symbols for it; or an ELF's build-id.
+
+The directory is kept to a total size: after saving, the files that
+have gone longest without being used are deleted until it fits.
+=====================================================================*/
+class SymbolCache
+{
+public:
+	SymbolCache();
+	~SymbolCache();
+
+	/// Where the files go (as UTF-8); created if need be. Nothing is
+	/// cached until this is set.
+	void setDirectory(const std::string &dir);
+
+	/// The cache for the module identified by key, or NULL if caching is off.
+	CachedSymbols *getModule(const std::string &key);
+
+	/// How big the directory's files may get, in bytes, before save()
+	/// starts deleting old ones.
+	void setMaxSize(unsigned long long size) { max_size = size; }
+
+	/// Save every module's additions, then trim the directory.
+	void save();
+
+private:
+	std::string dir;
+	std::map<std::string, CachedSymbols *> modules;
+	unsigned long long max_size;
+
+	static std::string getFileName(const std::string &key);
+	void trim();
+
+	SymbolCache(const SymbolCache &);
+	SymbolCache &operator=(const SymbolCache &);
+};
+
+#endif //__SYMBOLCACHE_H_666_
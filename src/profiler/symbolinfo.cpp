@@ -1,420 +1,898 @@
-/*=====================================================================
-symbolinfo.cpp
---------------
-File created by ClassTemplate on Sat Mar 05 19:10:20 2005
-
-Copyright (C) Nicholas Chapman
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html..
-=====================================================================*/
-#include "symbolinfo.h"
-#include "../wxProfilerGUI/profilergui.h"
-
-#include "../utils/stringutils.h"
-#include "../utils/osutils.h"
-#include <windows.h>
-#include <psapi.h>
-#include "../utils/dbginterface.h"
-#include <iostream>
-#include <algorithm>
-#include <shlwapi.h>
-#include "../utils/except.h"
-#include "../appinfo.h"
-
-SymLogFn *g_symLog = NULL;
-
-struct SymbolInfoContext
-{
-	SymbolInfo* syminfo;
-	DbgHelp* dbgHelp;
-};
-
-BOOL CALLBACK EnumModules(
-	PCWSTR   ModuleName,
-	DWORD64 BaseOfDll,
-	PVOID   UserContext )
-{
-	SymbolInfoContext* context = static_cast<SymbolInfoContext*>(UserContext);
-
-	HMODULE hMod;
-	GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, ModuleName, &hMod);
-
-	Module mod((PROFILER_ADDR)BaseOfDll, ModuleName, context->dbgHelp);
-	context->syminfo->addModule(mod);
-
-	return TRUE;
-}
-
-
-SymbolInfo::SymbolInfo()
-:	process_handle(NULL)
-{
-}
-
-BOOL CALLBACK symCallback(HANDLE WXUNUSED(hProcess), ULONG ActionCode, ULONG64 CallbackData, ULONG64 WXUNUSED(UserContext))
-{
-	switch(ActionCode)
-	{
-	case CBA_DEBUG_INFO:
-		if (g_symLog)
-		{
-			g_symLog((const wchar_t*)CallbackData);
-		}
-		return TRUE;
-	default:
-		return FALSE;
-	}
-}
-
-void symWineCallback(const char *msg)
-{
-#ifdef _DEBUG
-	OutputDebugStringA(msg);
-#endif
-
-	if (!msg || !*msg)
-		return;
-
-	static bool newline = true;
-	if (g_symLog)
-	{
-		if (newline)
-			g_symLog(L"WINE: ");
-		newline = msg[strlen(msg) - 1] == '\n';
-
-		wchar_t tmp[2048];
-		MultiByteToWideChar(CP_ACP, 0, msg, -1, tmp, sizeof(tmp));
-		g_symLog(tmp);
-	}
-}
-
-void SymbolInfo::loadSymbolsUsing(DbgHelp* dbgHelp, const std::wstring& sympath)
-{
-	if (!dbgHelp->Loaded)
-	{
-		if (g_symLog)
-		{
-			g_symLog(dbgHelp->Name); g_symLog(L" is not loaded, skipping.\n");
-		}
-		return;
-	}
-
-	DWORD options = dbgHelp->SymGetOptions();
-
-#ifdef _WIN64
-	if(!is64BitProcess) {
-		options |= SYMOPT_INCLUDE_32BIT_MODULES;
-	}
-#endif
-
-	options |= SYMOPT_LOAD_LINES | SYMOPT_DEBUG;
-
-	dbgHelp->SymSetOptions(options);
-
-	if (dbgHelp->SymSetDbgPrint)
-		dbgHelp->SymSetDbgPrint(&symWineCallback);
-
-	for( int n=0;n<4;n++ )
-	{
-		wenforce(dbgHelp->SymInitializeW(process_handle, L"", FALSE), "SymInitialize");
-
-		// Hook the debug output, so we actually can provide a clue as to
-		// what's happening.
-		dbgHelp->SymRegisterCallbackW64(process_handle, symCallback, NULL);
-
-		// Add our PDB search paths.
-		if (dbgHelp == &dbgHelpMs)
-			wenforce(dbgHelp->SymSetSearchPathW(process_handle, sympath.c_str()), "SymSetSearchPathW");
-
-		if (modules.empty())
-		{
-			// Load symbol information for all modules.
-			// Normally SymInitialize would do this, but we instead do it ourselves afterwards
-			// so that we can hook the debug output for it.
-			wenforce(dbgHelp->SymRefreshModuleList(process_handle), "SymRefreshModuleList");
-
-			SymbolInfoContext context;
-			context.syminfo = this;
-			context.dbgHelp = dbgHelp;
-
-			wenforce(dbgHelp->SymEnumerateModulesW64(process_handle, EnumModules, &context), "SymEnumerateModules64");
-		}
-		else
-		{
-			// This is a secondary dbgHelp, so just complement debug
-			// information for modules that have none.
-			
-			for (size_t n=0;n<modules.size();n++)
-			{
-				Module &mod = modules[n];
-
-				IMAGEHLP_MODULEW64 info;
-				info.SizeOfStruct = sizeof(info);
-				if (!mod.dbghelp->SymGetModuleInfoW64(process_handle, mod.base_addr, &info))
-					continue;
-
-				// If we have a module with no symbol information from the previous (MS) dbghelp,
-				// let the current one handle it instead.
-				if (info.SymType == SymNone)
-				{
-					DWORD64 ret = dbgHelp->SymLoadModuleExW(process_handle, NULL,
-						info.ImageName, info.ModuleName, info.BaseOfImage, info.ImageSize,
-						NULL, 0);
-					if (ret)
-						mod.dbghelp = dbgHelp;
-				}
-			}
-		}
-
-		if (!modules.empty())
-			break;
-
-		// Sometimes the module enumeration will fail (no error code, but no modules
-		// will be returned). If we try again a little later it seems to work.
-		// I suspect this may be if we try and enum modules too early on, before the process
-		// has really had a chance to 'get going'.
-		// Perhaps a better solution generally would be to manually load module symbols on demand,
-		// as each sample comes in? That'd also solve the problem of modules getting loaded/unloaded
-		// mid-profile. Yes, I'll probably do that some day.
-		Sleep(100);
-		dbgHelp->SymCleanup(process_handle);
-	}
-}
-
-void SymbolInfo::loadSymbols(HANDLE process_handle_, bool download)
-{
-	process_handle = process_handle_;
-
-	wxBusyCursor busy;
-
-	is64BitProcess = Is64BitProcess(process_handle);
-
-	std::wstring sympath;
-	{
-		// Add the program's own directory to the search path.
-		// Useful if someone's copied the EXE and PDB to a different machine or location.
-		wchar_t szExePath[MAX_PATH] = L"";
-		DWORD pathsize = MAX_PATH;
-		BOOL gotImageName = FALSE;
-#ifdef _WIN64
-		// GetModuleFileNameEx doesn't always work across 64->32 bit boundaries.
-		// Use QueryFullProcessImageName if we have it.
-		{
-			typedef BOOL WINAPI QueryFullProcessImageNameFn(HANDLE hProcess, DWORD dwFlags, LPTSTR lpExeName, PDWORD lpdwSize);
-
-			QueryFullProcessImageNameFn *fn = (QueryFullProcessImageNameFn *)GetProcAddress(GetModuleHandle(L"kernel32"), "QueryFullProcessImageNameW");
-			if (fn)
-				gotImageName = fn(process_handle, 0, szExePath, &pathsize);
-		}
-#endif
-
-		if (!gotImageName)
-			gotImageName = GetModuleFileNameEx(process_handle, NULL, szExePath, pathsize);
-
-		if (gotImageName)
-		{
-			// Convert the EXE path to its containing folder and append the
-			// resulting folder to the symbol search path.
-			wchar_t *p = wcsrchr(szExePath, '\\');
-
-			if (p != NULL)
-			{
-				*p = '\0';
-				sympath += std::wstring(L";") + szExePath;
-			}
-		}
-
-		prefs.AdjustSymbolPath(sympath, download);
-	}
-
-	loadSymbolsUsing(&dbgHelpMs, sympath);
-	loadSymbolsUsing(getGccDbgHelp(), sympath);
-
-	if (g_symLog)
-		g_symLog(L"\nFinished.\n");
-	sortModules();
-}
-
-DbgHelp* SymbolInfo::getGccDbgHelp()
-{
-	if (prefs.UseWine())
-	{
-#ifdef _WIN64
-		// We can't use the regular dbghelpw to profile 32-bit applications,
-		// as it's got compiled-in things that assume 64-bit. So we instead have
-		// a special Wow64 build, which is compiled as 64-bit code but using 32-bit
-		// definitions. We load that instead.
-		if (!is64BitProcess)
-			return &dbgHelpWineWow64;
-		else
-#endif
-			return &dbgHelpWine;
-	}
-	else
-		return &dbgHelpDrMingw;
-}
-
-SymbolInfo::~SymbolInfo()
-{
-	//------------------------------------------------------------------------
-	//clean up
-	//------------------------------------------------------------------------
-	if ( process_handle )
-	{
-		DbgHelp *gcc = getGccDbgHelp();
-		if (gcc->Loaded && !gcc->SymCleanup(process_handle))
-		{
-			//error
-		}
-
-		if (dbgHelpMs.Loaded && !dbgHelpMs.SymCleanup(process_handle))
-		{
-			//error
-		}
-
-		process_handle = NULL;
-	}
-}
-
-Module *SymbolInfo::getModuleForAddr(PROFILER_ADDR addr)
-{
-	if(modules.empty())
-		return NULL;
-
-	if(addr < modules[0].base_addr)
-		return NULL;
-
-	for(unsigned int i=1; i<modules.size(); ++i)
-		if(addr < modules[i].base_addr)
-			return &modules[i-1];
-
-	//assign any addresses past the base of the last module to the last module.
-	//NOTE: this is not strictly correct, but without the sizes of the modules, a decent way of doing things.
-	return &modules[modules.size() - 1];
-}
-
-const std::wstring SymbolInfo::getModuleNameForAddr(PROFILER_ADDR addr)
-{
-	Module *mod = getModuleForAddr(addr);
-	if (mod)
-		return mod->name;
-	else
-		return L"";
-}
-
-void SymbolInfo::addModule(const Module& module)
-{
-	modules.push_back(module);
-}
-
-void SymbolInfo::sortModules()
-{
-	struct Sorter {
-		bool operator() (const Module& a, const Module& b) const {
-			return a.base_addr < b.base_addr;
-		}
-	};
-	std::sort(modules.begin(), modules.end(), Sorter());
-}
-
-const std::wstring SymbolInfo::getProcForAddr(PROFILER_ADDR addr,
-											  std::wstring& procfilepath_out, int& proclinenum_out)
-{
-	procfilepath_out = L"";
-	proclinenum_out = 0;
-
-	Module *mod = getModuleForAddr(addr);
-	DbgHelp *dbgHelp = mod ? mod->dbghelp : &dbgHelpMs;
-
-	unsigned char buffer[1024];
-
-	//blame MS for this abomination of a coding technique
-	SYMBOL_INFOW* symbol_info = (SYMBOL_INFOW*)buffer;
-	symbol_info->SizeOfStruct = sizeof(SYMBOL_INFOW);
-	symbol_info->MaxNameLen = ((sizeof(buffer) - sizeof(SYMBOL_INFOW)) / sizeof(WCHAR)) - 1;
-
-	DWORD64 displacement = 0;
-	BOOL result = dbgHelp->SymFromAddrW(process_handle, (DWORD64)addr, &displacement, symbol_info);
-
-	if(!result)
-	{
-		wchar_t buf[256];
-#if defined(_WIN64)
-		if(is64BitProcess)
-			swprintf(buf, 256, L"[%016llX]", addr);
-		else
-			swprintf(buf, 256, L"[%08X]", unsigned __int32(addr));
-#else
-		swprintf(buf, 256, L"[%08X]", addr);
-#endif
-		return buf;
-	}
-
-	//------------------------------------------------------------------------
-	//lookup proc file and line num
-	//------------------------------------------------------------------------
-	getLineForAddr(addr, procfilepath_out, proclinenum_out);
-
-	return symbol_info->Name;
-}
-
-void SymbolInfo::getLineForAddr(PROFILER_ADDR addr, std::wstring& filepath_out, int& linenum_out)
-{
-	Module *mod = getModuleForAddr(addr);
-	DbgHelp *dbgHelp = mod ? mod->dbghelp : &dbgHelpMs;
-
-	DWORD displacement;
-	IMAGEHLP_LINEW64 lineinfo;
-	ZeroMemory(&lineinfo, sizeof(lineinfo));
-	lineinfo.SizeOfStruct = sizeof(IMAGEHLP_LINEW64);
-	BOOL result = dbgHelp->SymGetLineFromAddrW64(process_handle, (DWORD64)addr, &displacement, &lineinfo);
-
-	if(result)
-	{
-		filepath_out = lineinfo.FileName;
-		linenum_out = lineinfo.LineNumber;
-	}
-	else
-	{
-		filepath_out = L"[unknown]";
-		linenum_out = 0;
-	}
-}
-
-std::wstring SymbolInfo::saveMinidump()
-{
-#ifdef _WIN64
-	if (!Is64BitProcess(process_handle))
-	{
-		wxLogWarning(
-			L"Warning: minidumps of 32-bit processes saved by 64-bit processes will most likely not be saved correctly.\n"
-			L"Use the 32-bit version of " _T(APPNAME) L" to profile 32-bit processes if a minidump needs to be included."
-		);
-	}
-#endif
-
-	wxFile f;
-	std::wstring dumppath = wxFileName::CreateTempFileName(wxEmptyString, &f);
-	wenforce(dbgHelpMs.MiniDumpWriteDump(
-		process_handle,
-		GetProcessId(process_handle),
-		(HANDLE)_get_osfhandle(f.fd()),
-		MiniDumpNormal,
-		NULL, NULL, NULL), "MiniDumpWriteDump");
-	f.Close();
-	return dumppath;
-}
+/*=====================================================================
+symbolinfo.cpp
+--------------
+File created by ClassTemplate on Sat Mar 05 19:10:20 2005
+
+Copyright (C) Nicholas Chapman
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+#include "symbolinfo.h"
+#include "../wxProfilerGUI/profilergui.h"
+
+#include "../utils/stringutils.h"
+#include "../utils/osutils.h"
+#include <windows.h>
+#include <psapi.h>
+#include "../utils/dbginterface.h"
+#include <iostream>
+#include <algorithm>
+#include <shlwapi.h>
+#include "../utils/except.h"
+#include "../appinfo.h"
+#include "captureformat.h"
+#include <sstream>
+
+SymLogFn *g_symLog = NULL;
+
+struct SymbolInfoContext
+{
+	SymbolInfo* syminfo;
+	DbgHelp* dbgHelp;
+};
+
+// The image size from the module's PE header, for when DbgHelp doesn't say.
+static PROFILER_ADDR readImageSize(HANDLE process, DWORD64 base)
+{
+	IMAGE_DOS_HEADER dos;
+	if (!ReadProcessMemory(process, (LPCVOID)(ULONG_PTR)base, &dos, sizeof(dos), NULL) || dos.e_magic != IMAGE_DOS_SIGNATURE)
+		return 0;
+
+	// SizeOfImage is at the same offset in the 32-bit and 64-bit headers,
+	// and the 32-bit ones are the smaller.
+	IMAGE_NT_HEADERS32 nt;
+	if (!ReadProcessMemory(process, (LPCVOID)(ULONG_PTR)(base + dos.e_lfanew), &nt, sizeof(nt), NULL) || nt.Signature != IMAGE_NT_SIGNATURE)
+		return 0;
+	return nt.OptionalHeader.SizeOfImage;
+}
+
+// The module's executable sections, from the section table after its PE header.
+static void readCodeRanges(HANDLE process, DWORD64 base, std::vector<Module::CodeRange> &ranges)
+{
+	IMAGE_DOS_HEADER dos;
+	if (!ReadProcessMemory(process, (LPCVOID)(ULONG_PTR)base, &dos, sizeof(dos), NULL) || dos.e_magic != IMAGE_DOS_SIGNATURE)
+		return;
+
+	// The file header is the same in 32-bit and 64-bit images; the
+	// section table follows the optional header, whatever its size.
+	IMAGE_NT_HEADERS32 nt;
+	if (!ReadProcessMemory(process, (LPCVOID)(ULONG_PTR)(base + dos.e_lfanew), &nt, sizeof(nt), NULL) || nt.Signature != IMAGE_NT_SIGNATURE)
+		return;
+
+	std::vector<IMAGE_SECTION_HEADER> sections(nt.FileHeader.NumberOfSections);
+	DWORD64 table = base + dos.e_lfanew + FIELD_OFFSET(IMAGE_NT_HEADERS32, OptionalHeader) + nt.FileHeader.SizeOfOptionalHeader;
+	if (sections.empty() ||
+		!ReadProcessMemory(process, (LPCVOID)(ULONG_PTR)table, &sections[0], sections.size() * sizeof(IMAGE_SECTION_HEADER), NULL))
+		return;
+
+	for (size_t i = 0; i < sections.size(); i++)
+	{
+		if (!(sections[i].Characteristics & (IMAGE_SCN_MEM_EXECUTE | IMAGE_SCN_CNT_CODE)))
+			continue;
+		Module::CodeRange range;
+		range.start = (PROFILER_ADDR)(base + sections[i].VirtualAddress);
+		range.end = range.start + max(sections[i].Misc.VirtualSize, sections[i].SizeOfRawData);
+		ranges.push_back(range);
+	}
+}
+
+// The PDB the module was built with, from the CodeView record in its
+// debug directory, which is mapped along with the rest of the image.
+static bool readCodeView(HANDLE process, DWORD64 base, GUID &guid, DWORD &age, std::wstring &pdb_path)
+{
+	IMAGE_DOS_HEADER dos;
+	if (!ReadProcessMemory(process, (LPCVOID)(ULONG_PTR)base, &dos, sizeof(dos), NULL) || dos.e_magic != IMAGE_DOS_SIGNATURE)
+		return false;
+
+	// The data directories are further in in 64-bit headers.
+	IMAGE_NT_HEADERS64 nt;
+	if (!ReadProcessMemory(process, (LPCVOID)(ULONG_PTR)(base + dos.e_lfanew), &nt, sizeof(nt), NULL) || nt.Signature != IMAGE_NT_SIGNATURE)
+		return false;
+	const IMAGE_DATA_DIRECTORY &debug = nt.OptionalHeader.Magic == IMAGE_NT_OPTIONAL_HDR64_MAGIC
+		? nt.OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG]
+		: ((const IMAGE_NT_HEADERS32 &)nt).OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG];
+
+	for (DWORD offset = 0; offset + sizeof(IMAGE_DEBUG_DIRECTORY) <= debug.Size; offset += sizeof(IMAGE_DEBUG_DIRECTORY))
+	{
+		IMAGE_DEBUG_DIRECTORY entry;
+		if (!ReadProcessMemory(process, (LPCVOID)(ULONG_PTR)(base + debug.VirtualAddress + offset), &entry, sizeof(entry), NULL))
+			return false;
+		if (entry.Type != IMAGE_DEBUG_TYPE_CODEVIEW || !entry.AddressOfRawData)
+			continue;
+
+		struct
+		{
+			DWORD signature; // "RSDS"
+			GUID guid;
+			DWORD age;
+			char path[MAX_PATH];
+		} cv;
+		ZeroMemory(&cv, sizeof(cv));
+		SIZE_T size = min((SIZE_T)entry.SizeOfData, sizeof(cv) - 1);
+		if (!ReadProcessMemory(process, (LPCVOID)(ULONG_PTR)(base + entry.AddressOfRawData), &cv, size, NULL) ||
+			cv.signature != 'SDSR')
+			continue;
+
+		guid = cv.guid;
+		age = cv.age;
+		pdb_path = fromUtf8(cv.path);
+		return true;
+	}
+	return false;
+}
+
+// The link timestamp in the header of an image file, or 0.
+static DWORD readFileTimestamp(const std::wstring &path)
+{
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+							  NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return 0;
+
+	DWORD timestamp = 0, got;
+	IMAGE_DOS_HEADER dos;
+	IMAGE_NT_HEADERS32 nt; // the file header is the same in both
+	if (ReadFile(file, &dos, sizeof(dos), &got, NULL) && got == sizeof(dos) && dos.e_magic == IMAGE_DOS_SIGNATURE &&
+		SetFilePointer(file, dos.e_lfanew, NULL, FILE_BEGIN) != INVALID_SET_FILE_POINTER &&
+		ReadFile(file, &nt, sizeof(nt), &got, NULL) && got == sizeof(nt) && nt.Signature == IMAGE_NT_SIGNATURE)
+		timestamp = nt.FileHeader.TimeDateStamp;
+
+	CloseHandle(file);
+	return timestamp;
+}
+
+BOOL CALLBACK EnumModules(
+	PCWSTR   ModuleName,
+	DWORD64 BaseOfDll,
+	PVOID   UserContext )
+{
+	SymbolInfoContext* context = static_cast<SymbolInfoContext*>(UserContext);
+
+	HMODULE hMod;
+	GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, ModuleName, &hMod);
+
+	// The size lets us tell addresses past the end of the module from code within it.
+	IMAGEHLP_MODULEW64 info;
+	info.SizeOfStruct = sizeof(info);
+	PROFILER_ADDR size = 0;
+	if (context->dbgHelp->SymGetModuleInfoW64(context->syminfo->process_handle, BaseOfDll, &info))
+		size = info.ImageSize;
+	if (!size)
+		size = readImageSize(context->syminfo->process_handle, BaseOfDll);
+
+	Module mod((PROFILER_ADDR)BaseOfDll, size, ModuleName, context->dbgHelp);
+	readCodeRanges(context->syminfo->process_handle, BaseOfDll, mod.code_ranges);
+	context->syminfo->addModule(mod);
+
+	return TRUE;
+}
+
+
+SymbolInfo::SymbolInfo()
+:	process_handle(NULL),
+	module_index(NULL)
+{
+}
+
+BOOL CALLBACK symCallback(HANDLE WXUNUSED(hProcess), ULONG ActionCode, ULONG64 CallbackData, ULONG64 WXUNUSED(UserContext))
+{
+	switch(ActionCode)
+	{
+	case CBA_DEBUG_INFO:
+		if (g_symLog)
+		{
+			g_symLog((const wchar_t*)CallbackData);
+		}
+		return TRUE;
+	default:
+		return FALSE;
+	}
+}
+
+void symWineCallback(const char *msg)
+{
+#ifdef _DEBUG
+	OutputDebugStringA(msg);
+#endif
+
+	if (!msg || !*msg)
+		return;
+
+	static bool newline = true;
+	if (g_symLog)
+	{
+		if (newline)
+			g_symLog(L"WINE: ");
+		newline = msg[strlen(msg) - 1] == '\n';
+
+		wchar_t tmp[2048];
+		MultiByteToWideChar(CP_ACP, 0, msg, -1, tmp, sizeof(tmp));
+		g_symLog(tmp);
+	}
+}
+
+void SymbolInfo::loadSymbolsUsing(DbgHelp* dbgHelp, const std::wstring& sympath, const std::vector<ModuleRecord> *records)
+{
+	if (!dbgHelp->Loaded)
+	{
+		if (g_symLog)
+		{
+			g_symLog(dbgHelp->Name); g_symLog(L" is not loaded, skipping.\n");
+		}
+		return;
+	}
+
+	DWORD options = dbgHelp->SymGetOptions();
+
+#ifdef _WIN64
+	if(!is64BitProcess) {
+		options |= SYMOPT_INCLUDE_32BIT_MODULES;
+	}
+#endif
+
+	options |= SYMOPT_LOAD_LINES | SYMOPT_DEBUG;
+
+	dbgHelp->SymSetOptions(options);
+
+	if (dbgHelp->SymSetDbgPrint)
+		dbgHelp->SymSetDbgPrint(&symWineCallback);
+
+	for( int n=0;n<4;n++ )
+	{
+		wenforce(dbgHelp->SymInitializeW(process_handle, L"", FALSE), "SymInitialize");
+
+		// Hook the debug output, so we actually can provide a clue as to
+		// what's happening.
+		dbgHelp->SymRegisterCallbackW64(process_handle, symCallback, NULL);
+
+		// Add our PDB search paths.
+		if (dbgHelp == &dbgHelpMs)
+			wenforce(dbgHelp->SymSetSearchPathW(process_handle, sympath.c_str()), "SymSetSearchPathW");
+
+		if (modules.empty() && records)
+		{
+			// There's no process to ask; we're told what was loaded where.
+			for (size_t n = 0; n < records->size(); n++)
+				loadModuleRecord(dbgHelp, (*records)[n]);
+		}
+		else if (modules.empty())
+		{
+			// Load symbol information for all modules.
+			// Normally SymInitialize would do this, but we instead do it ourselves afterwards
+			// so that we can hook the debug output for it.
+			wenforce(dbgHelp->SymRefreshModuleList(process_handle), "SymRefreshModuleList");
+
+			SymbolInfoContext context;
+			context.syminfo = this;
+			context.dbgHelp = dbgHelp;
+
+			wenforce(dbgHelp->SymEnumerateModulesW64(process_handle, EnumModules, &context), "SymEnumerateModules64");
+		}
+		else
+		{
+			// This is a secondary dbgHelp, so just complement debug
+			// information for modules that have none.
+			
+			for (size_t n=0;n<modules.size();n++)
+			{
+				Module &mod = modules[n];
+
+				IMAGEHLP_MODULEW64 info;
+				info.SizeOfStruct = sizeof(info);
+				if (!mod.dbghelp->SymGetModuleInfoW64(process_handle, mod.base_addr, &info))
+					continue;
+
+				// If we have a module with no symbol information from the previous (MS) dbghelp,
+				// let the current one handle it instead.
+				if (info.SymType == SymNone)
+				{
+					DWORD64 ret = dbgHelp->SymLoadModuleExW(process_handle, NULL,
+						info.ImageName, info.ModuleName, info.BaseOfImage, info.ImageSize,
+						NULL, 0);
+					if (ret)
+						mod.dbghelp = dbgHelp;
+				}
+			}
+		}
+
+		if (!modules.empty() || records)
+			break;
+
+		// Sometimes the module enumeration will fail (no error code, but no modules
+		// will be returned). If we try again a little later it seems to work.
+		// I suspect this may be if we try and enum modules too early on, before the process
+		// has really had a chance to 'get going'.
+		// Perhaps a better solution generally would be to manually load module symbols on demand,
+		// as each sample comes in? That'd also solve the problem of modules getting loaded/unloaded
+		// mid-profile. Yes, I'll probably do that some day.
+		Sleep(100);
+		dbgHelp->SymCleanup(process_handle);
+	}
+}
+
+void SymbolInfo::loadSymbols(HANDLE process_handle_, bool download)
+{
+	process_handle = process_handle_;
+
+	wxBusyCursor busy;
+
+	is64BitProcess = Is64BitProcess(process_handle);
+
+	std::wstring sympath;
+	{
+		// Add the program's own directory to the search path.
+		// Useful if someone's copied the EXE and PDB to a different machine or location.
+		wchar_t szExePath[MAX_PATH] = L"";
+		DWORD pathsize = MAX_PATH;
+		BOOL gotImageName = FALSE;
+#ifdef _WIN64
+		// GetModuleFileNameEx doesn't always work across 64->32 bit boundaries.
+		// Use QueryFullProcessImageName if we have it.
+		{
+			typedef BOOL WINAPI QueryFullProcessImageNameFn(HANDLE hProcess, DWORD dwFlags, LPTSTR lpExeName, PDWORD lpdwSize);
+
+			QueryFullProcessImageNameFn *fn = (QueryFullProcessImageNameFn *)GetProcAddress(GetModuleHandle(L"kernel32"), "QueryFullProcessImageNameW");
+			if (fn)
+				gotImageName = fn(process_handle, 0, szExePath, &pathsize);
+		}
+#endif
+
+		if (!gotImageName)
+			gotImageName = GetModuleFileNameEx(process_handle, NULL, szExePath, pathsize);
+
+		if (gotImageName)
+		{
+			// Convert the EXE path to its containing folder and append the
+			// resulting folder to the symbol search path.
+			wchar_t *p = wcsrchr(szExePath, '\\');
+
+			if (p != NULL)
+			{
+				*p = '\0';
+				sympath += std::wstring(L";") + szExePath;
+			}
+		}
+
+		prefs.AdjustSymbolPath(sympath, download);
+	}
+
+	loadSymbolsUsing(&dbgHelpMs, sympath, NULL);
+	loadSymbolsUsing(getGccDbgHelp(), sympath, NULL);
+
+	if (g_symLog)
+		g_symLog(L"\nFinished.\n");
+	rebuildModuleIndex();
+	openSymbolCache();
+}
+
+void SymbolInfo::loadModuleRecords(const std::vector<ModuleRecord> &records, bool is64Bit, bool download)
+{
+	// Without a process to look into, DbgHelp only needs a value that
+	// tells our session apart from any others.
+	process_handle = (HANDLE)this;
+	is64BitProcess = is64Bit;
+
+	wxBusyCursor busy;
+
+	std::wstring sympath;
+	prefs.AdjustSymbolPath(sympath, download);
+
+	loadSymbolsUsing(&dbgHelpMs, sympath, &records);
+	loadSymbolsUsing(getGccDbgHelp(), sympath, &records);
+
+	if (g_symLog)
+		g_symLog(L"\nFinished.\n");
+	rebuildModuleIndex();
+	openSymbolCache();
+}
+
+void SymbolInfo::loadModuleRecord(DbgHelp* dbgHelp, const ModuleRecord& record)
+{
+	// A file at the same path may well be another build (system DLLs
+	// usually are); then DbgHelp has to go by the PDB's GUID and age,
+	// on the search path or the symbol server.
+	bool have_image = record.timestamp && readFileTimestamp(record.image_path) == record.timestamp;
+
+	MODLOAD_PDBGUID_PDBAGE pdb;
+	MODLOAD_DATA data;
+	PMODLOAD_DATA pdata = NULL;
+	if (!have_image && !record.pdb_path.empty())
+	{
+		pdb.PdbGuid = record.pdb_guid;
+		pdb.PdbAge = record.pdb_age;
+		data.ssize = sizeof(data);
+		data.ssig = DBHHEADER_PDBGUID;
+		data.data = &pdb;
+		data.size = sizeof(pdb);
+		data.flags = 0;
+		pdata = &data;
+	}
+
+	const std::wstring &image = have_image || record.pdb_path.empty() ? record.image_path : record.pdb_path;
+	if (!dbgHelp->SymLoadModuleExW(process_handle, NULL, image.c_str(), record.name.c_str(),
+								   (DWORD64)record.base_addr, (DWORD)record.size, pdata, 0) && g_symLog)
+	{
+		g_symLog(L"Could not load symbols for ");
+		g_symLog(record.name.c_str());
+		g_symLog(L"\n");
+	}
+
+	// Addresses in it are at least named by module even without symbols.
+	addModule(Module(record.base_addr, record.size, record.name, dbgHelp));
+}
+
+void SymbolInfo::openSymbolCache()
+{
+	// Symbols looked up in earlier captures of the same builds are
+	// kept next to the symbol server's cache.
+	if (!prefs.symCacheDir.empty())
+	{
+		std::wstring dir = prefs.symCacheDir.wc_str();
+		symbol_cache.setDirectory(toUtf8(dir + L"\\SleepySymbols"));
+		for (size_t n = 0; n < modules.size(); n++)
+			modules[n].cached = symbol_cache.getModule(getCacheKey(modules[n]));
+	}
+}
+
+std::string SymbolInfo::getCacheKey(const Module& mod)
+{
+	IMAGEHLP_MODULEW64 info;
+	info.SizeOfStruct = sizeof(info);
+	if (!mod.dbghelp->SymGetModuleInfoW64(process_handle, mod.base_addr, &info) || !info.TimeDateStamp)
+		return "";
+
+	// What the symbols say depends on which DbgHelp read what kind of
+	// debug information, as well as on the build of the module; if a
+	// PDB turns up later, it gets a cache of its own.
+	const wchar_t *reader =
+		mod.dbghelp == &dbgHelpMs ? L"ms" :
+		mod.dbghelp == &dbgHelpDrMingw ? L"dr" : L"wine";
+
+	wchar_t key[64];
+	swprintf(key, 64, L"-%08X%X-%s%d%s", info.TimeDateStamp, info.ImageSize,
+			 reader, info.SymType, info.LineNumbers ? L"L" : L"");
+	return toUtf8(info.ModuleName + std::wstring(key));
+}
+
+void SymbolInfo::saveSymbolCache()
+{
+	symbol_cache.save();
+}
+
+DbgHelp* SymbolInfo::getGccDbgHelp()
+{
+	if (prefs.UseWine())
+	{
+#ifdef _WIN64
+		// We can't use the regular dbghelpw to profile 32-bit applications,
+		// as it's got compiled-in things that assume 64-bit. So we instead have
+		// a special Wow64 build, which is compiled as 64-bit code but using 32-bit
+		// definitions. We load that instead.
+		if (!is64BitProcess)
+			return &dbgHelpWineWow64;
+		else
+#endif
+			return &dbgHelpWine;
+	}
+	else
+		return &dbgHelpDrMingw;
+}
+
+SymbolInfo::~SymbolInfo()
+{
+	//------------------------------------------------------------------------
+	//clean up
+	//------------------------------------------------------------------------
+	if ( process_handle )
+	{
+		DbgHelp *gcc = getGccDbgHelp();
+		if (gcc->Loaded && !gcc->SymCleanup(process_handle))
+		{
+			//error
+		}
+
+		if (dbgHelpMs.Loaded && !dbgHelpMs.SymCleanup(process_handle))
+		{
+			//error
+		}
+
+		process_handle = NULL;
+	}
+
+	delete module_index;
+	for (size_t n = 0; n < old_module_indexes.size(); n++)
+		delete old_module_indexes[n];
+}
+
+Module *SymbolInfo::getModuleForAddr(PROFILER_ADDR addr)
+{
+	const ModuleIndex *index = module_index;
+	return index ? index->find(addr) : NULL;
+}
+
+const std::wstring SymbolInfo::getModuleNameForAddr(PROFILER_ADDR addr)
+{
+	Module *mod = getModuleForAddr(addr);
+	if (mod)
+		return mod->name;
+	else
+		return L"";
+}
+
+void SymbolInfo::addModule(const Module& module)
+{
+	modules.push_back(module);
+}
+
+void SymbolInfo::rebuildModuleIndex()
+{
+	std::vector<Module *> sorted;
+	for (size_t n = 0; n < modules.size(); n++)
+		sorted.push_back(&modules[n]);
+
+	struct Sorter {
+		bool operator() (const Module *a, const Module *b) const {
+			return a->base_addr < b->base_addr;
+		}
+	};
+	std::sort(sorted.begin(), sorted.end(), Sorter());
+
+	std::vector<ModuleIndex::Range> ranges;
+	for (size_t n = 0; n < sorted.size(); n++)
+	{
+		ModuleIndex::Range range;
+		range.module = sorted[n];
+		range.start = sorted[n]->base_addr;
+		range.end = range.start + sorted[n]->size;
+
+		// Don't let a module whose size we don't know, or that claims
+		// too much, swallow the next one.
+		PROFILER_ADDR limit = n + 1 < sorted.size() ? sorted[n + 1]->base_addr : ~(PROFILER_ADDR)0;
+		if (!sorted[n]->size || range.end > limit || range.end < range.start)
+			range.end = limit;
+
+		ranges.push_back(range);
+	}
+
+	ModuleIndex *index = new ModuleIndex(ranges);
+	ModuleIndex *old = (ModuleIndex *)InterlockedExchangePointer((PVOID volatile *)&module_index, index);
+	if (old)
+		old_module_indexes.push_back(old);
+}
+
+const std::wstring SymbolInfo::getProcForAddr(PROFILER_ADDR addr,
+											  std::wstring& procfilepath_out, int& proclinenum_out)
+{
+	AddrSymbol symbol;
+	volatile LONG num_done = 0;
+	bool stop = false;
+	resolveAddrs(&addr, 1, &symbol, &num_done, &stop);
+
+	procfilepath_out = symbol.file;
+	proclinenum_out = symbol.line;
+	return symbol.proc;
+}
+
+void SymbolInfo::getLineForAddr(PROFILER_ADDR addr, std::wstring& filepath_out, int& linenum_out)
+{
+	Module *mod = getModuleForAddr(addr);
+	DbgHelp *dbgHelp = mod ? mod->dbghelp : &dbgHelpMs;
+
+	DWORD displacement;
+	IMAGEHLP_LINEW64 lineinfo;
+	ZeroMemory(&lineinfo, sizeof(lineinfo));
+	lineinfo.SizeOfStruct = sizeof(IMAGEHLP_LINEW64);
+	BOOL result = dbgHelp->SymGetLineFromAddrW64(process_handle, (DWORD64)addr, &displacement, &lineinfo);
+
+	if(result)
+	{
+		filepath_out = lineinfo.FileName;
+		linenum_out = lineinfo.LineNumber;
+	}
+	else
+	{
+		filepath_out = L"[unknown]";
+		linenum_out = 0;
+	}
+}
+
+void SymbolInfo::resolveAddrs(const PROFILER_ADDR *addrs, size_t count, AddrSymbol *results,
+							  volatile LONG *num_done, const volatile bool *stop)
+{
+	if (count == 0)
+		return;
+
+	Module *mod = getModuleForAddr(addrs[0]);
+	DbgHelp *dbgHelp = mod ? mod->dbghelp : &dbgHelpMs;
+	const std::wstring module_name = mod ? mod->name : L"";
+	CachedSymbols *cached = mod ? mod->cached : NULL;
+
+	unsigned char buffer[1024];
+	SYMBOL_INFOW* symbol_info = (SYMBOL_INFOW*)buffer;
+	symbol_info->SizeOfStruct = sizeof(SYMBOL_INFOW);
+	symbol_info->MaxNameLen = ((sizeof(buffer) - sizeof(SYMBOL_INFOW)) / sizeof(WCHAR)) - 1;
+
+	// The function the last lookup found, covering [proc_start, proc_end).
+	DWORD64 proc_start = 0, proc_end = 0;
+	std::wstring proc_name;
+	std::vector<CachedSymbols::Inlined> cached_inlined;
+
+	for (size_t i = 0; i < count && !*stop; i++)
+	{
+		DWORD64 addr = (DWORD64)addrs[i];
+		AddrSymbol &result = results[i];
+		result.module = module_name;
+
+		unsigned rva = cached ? (unsigned)(addr - mod->base_addr) : 0;
+		std::string cached_proc, cached_file;
+		unsigned cached_line;
+		if (cached && cached->findAddr(rva, cached_proc, cached_file, cached_line, &cached_inlined))
+		{
+			result.proc = cached_proc.empty() ? getUnknownProcName(addrs[i]) : fromUtf8(cached_proc);
+			result.file = fromUtf8(cached_file);
+			result.line = (int)cached_line;
+			result.inlined.resize(cached_inlined.size());
+			for (size_t j = 0; j < cached_inlined.size(); j++)
+			{
+				result.inlined[j].proc = fromUtf8(cached_inlined[j].proc);
+				result.inlined[j].file = fromUtf8(cached_inlined[j].file);
+				result.inlined[j].line = (int)cached_inlined[j].line;
+			}
+			InterlockedIncrement(num_done);
+			continue;
+		}
+
+		unsigned start, end;
+		if (addr >= proc_start && addr < proc_end)
+		{
+			// Same function as last time.
+		}
+		else if (cached && cached->findProc(rva, start, end, cached_proc))
+		{
+			proc_name = fromUtf8(cached_proc);
+			proc_start = mod->base_addr + start;
+			proc_end = mod->base_addr + end;
+		}
+		else
+		{
+			DWORD64 displacement = 0;
+			if (dbgHelp->SymFromAddrW(process_handle, addr, &displacement, symbol_info))
+			{
+				proc_name = symbol_info->Name;
+				proc_start = symbol_info->Address;
+				proc_end = proc_start + symbol_info->Size;
+
+				// Exports have no size, and the nearest symbol below an
+				// address needn't reach it; either way, all we know is
+				// what this one address resolves to.
+				if (addr < proc_start || addr >= proc_end)
+				{
+					proc_start = addr;
+					proc_end = addr + 1;
+				}
+				else if (cached && proc_start >= mod->base_addr)
+				{
+					cached->addProc((unsigned)(proc_start - mod->base_addr),
+									(unsigned)(proc_end - mod->base_addr), toUtf8(proc_name));
+				}
+			}
+			else
+			{
+				proc_start = proc_end = 0;
+				result.proc = getUnknownProcName(addrs[i]);
+				result.file = L"";
+				result.line = 0;
+				result.inlined.clear();
+				if (cached)
+					cached->addAddr(rva, "", "", 0);
+				InterlockedIncrement(num_done);
+				continue;
+			}
+		}
+
+		result.proc = proc_name;
+		getLineForAddr(addrs[i], result.file, result.line);
+		getInlineFrames(dbgHelp, addrs[i], symbol_info, result.inlined);
+		if (cached)
+		{
+			cached_inlined.resize(result.inlined.size());
+			for (size_t j = 0; j < result.inlined.size(); j++)
+			{
+				cached_inlined[j].proc = toUtf8(result.inlined[j].proc);
+				cached_inlined[j].file = toUtf8(result.inlined[j].file);
+				cached_inlined[j].line = (unsigned)result.inlined[j].line;
+			}
+			cached->addAddr(rva, toUtf8(result.proc), toUtf8(result.file), (unsigned)result.line, &cached_inlined);
+		}
+		InterlockedIncrement(num_done);
+	}
+}
+
+void SymbolInfo::getInlineFrames(DbgHelp *dbgHelp, PROFILER_ADDR addr, SYMBOL_INFOW *symbol_info, std::vector<InlineFrame> &inlined)
+{
+	inlined.clear();
+
+	// Older DbgHelps, and Wine's, know nothing of inlining.
+	if (!dbgHelp->SymAddrIncludeInlineTrace || !dbgHelp->SymQueryInlineTrace ||
+		!dbgHelp->SymFromInlineContextW || !dbgHelp->SymGetLineFromInlineContextW)
+		return;
+
+	DWORD count = dbgHelp->SymAddrIncludeInlineTrace(process_handle, (DWORD64)addr);
+	DWORD context, frame_index;
+	if (count == 0 || !dbgHelp->SymQueryInlineTrace(process_handle, (DWORD64)addr, 0, (DWORD64)addr, (DWORD64)addr, &context, &frame_index))
+		return;
+
+	// The contexts from the one the query gave us on are the inlined
+	// calls, innermost first, as StackWalkEx would report them.
+	for (DWORD i = 0; i < count && i < MAX_INLINE_DEPTH; i++)
+	{
+		InlineFrame frame;
+
+		DWORD64 displacement = 0;
+		if (dbgHelp->SymFromInlineContextW(process_handle, (DWORD64)addr, context + i, &displacement, symbol_info))
+			frame.proc = symbol_info->Name;
+		else
+			frame.proc = getUnknownProcName(addr);
+
+		DWORD line_displacement;
+		IMAGEHLP_LINEW64 lineinfo;
+		ZeroMemory(&lineinfo, sizeof(lineinfo));
+		lineinfo.SizeOfStruct = sizeof(IMAGEHLP_LINEW64);
+		if (dbgHelp->SymGetLineFromInlineContextW(process_handle, (DWORD64)addr, context + i, 0, &line_displacement, &lineinfo))
+		{
+			frame.file = lineinfo.FileName;
+			frame.line = lineinfo.LineNumber;
+		}
+		else
+		{
+			frame.file = L"[unknown]";
+			frame.line = 0;
+		}
+		inlined.push_back(frame);
+	}
+}
+
+void SymbolInfo::getModuleRecords(std::vector<ModuleRecord> &records)
+{
+	records.clear();
+	for (size_t n = 0; n < modules.size(); n++)
+	{
+		const Module &mod = modules[n];
+
+		ModuleRecord record;
+		record.base_addr = mod.base_addr;
+		record.size = mod.size;
+		record.name = mod.name;
+		record.timestamp = 0;
+		record.pdb_age = 0;
+		ZeroMemory(&record.pdb_guid, sizeof(record.pdb_guid));
+
+		IMAGEHLP_MODULEW64 info;
+		info.SizeOfStruct = sizeof(info);
+		if (mod.dbghelp->SymGetModuleInfoW64(process_handle, mod.base_addr, &info))
+		{
+			record.image_path = info.ImageName;
+			record.timestamp = info.TimeDateStamp;
+		}
+		readCodeView(process_handle, mod.base_addr, record.pdb_guid, record.pdb_age, record.pdb_path);
+
+		records.push_back(record);
+	}
+}
+
+std::wstring SymbolInfo::formatModuleRecord(const ModuleRecord &record)
+{
+	const GUID &g = record.pdb_guid;
+	wchar_t guid[64];
+	swprintf(guid, 64, L"%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X",
+			 g.Data1, g.Data2, g.Data3, g.Data4[0], g.Data4[1],
+			 g.Data4[2], g.Data4[3], g.Data4[4], g.Data4[5], g.Data4[6], g.Data4[7]);
+
+	std::wostringstream line;
+	line << ::toHexString(record.base_addr) << " " << ::toHexString(record.size) << " ";
+	writeQuote(line, record.name);
+	line << " ";
+	writeQuote(line, record.image_path);
+	line << " " << ::toHexString(record.timestamp) << " ";
+	writeQuote(line, record.pdb_path);
+	line << " " << guid << " " << record.pdb_age;
+	return line.str();
+}
+
+bool SymbolInfo::parseModuleRecord(const std::wstring &line, ModuleRecord &record)
+{
+	std::wistringstream stream(line);
+	std::wstring base, size, timestamp, guid;
+	stream >> base >> size;
+	::readQuote(stream, record.name);
+	::readQuote(stream, record.image_path);
+	stream >> timestamp;
+	::readQuote(stream, record.pdb_path);
+	stream >> guid >> record.pdb_age;
+	if (stream.fail())
+		return false;
+
+	record.base_addr = (PROFILER_ADDR)hexStringTo64UInt(base);
+	record.size = (PROFILER_ADDR)hexStringTo64UInt(size);
+	record.timestamp = (DWORD)hexStringTo64UInt(timestamp);
+
+	unsigned int d1, d2, d3, d4[8];
+	if (swscanf(guid.c_str(), L"%8X-%4X-%4X-%2X%2X-%2X%2X%2X%2X%2X%2X",
+				&d1, &d2, &d3, &d4[0], &d4[1], &d4[2], &d4[3], &d4[4], &d4[5], &d4[6], &d4[7]) != 11)
+		return false;
+	record.pdb_guid.Data1 = d1;
+	record.pdb_guid.Data2 = (unsigned short)d2;
+	record.pdb_guid.Data3 = (unsigned short)d3;
+	for (int i = 0; i < 8; i++)
+		record.pdb_guid.Data4[i] = (unsigned char)d4[i];
+	return true;
+}
+
+void SymbolInfo::encodeSymbols(CaptureEncoder &encoder, const PROFILER_ADDR *addrs, const AddrSymbol *symbols, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const AddrSymbol &symbol = symbols[i];
+		const Module *mod = getModuleForAddr(addrs[i]);
+		encoder.addSymbol(addrs[i], mod ? mod->base_addr : 0, toUtf8(symbol.module),
+						  toUtf8(symbol.proc), toUtf8(symbol.file), symbol.line);
+
+		for (size_t depth = 0; depth < symbol.inlined.size(); depth++)
+		{
+			const InlineFrame &frame = symbol.inlined[depth];
+			encoder.addInlined(toUtf8(frame.proc), toUtf8(frame.file), frame.line);
+		}
+	}
+}
+
+std::wstring SymbolInfo::getUnknownProcName(PROFILER_ADDR addr)
+{
+	wchar_t buf[256];
+#if defined(_WIN64)
+	if(is64BitProcess)
+		swprintf(buf, 256, L"[%016llX]", addr);
+	else
+		swprintf(buf, 256, L"[%08X]", unsigned __int32(addr));
+#else
+	swprintf(buf, 256, L"[%08X]", addr);
+#endif
+	return buf;
+}
+
+std::wstring SymbolInfo::saveMinidump()
+{
+#ifdef _WIN64
+	if (!Is64BitProcess(process_handle))
+	{
+		wxLogWarning(
+			L"Warning: minidumps of 32-bit processes saved by 64-bit processes will most likely not be saved correctly.\n"
+			L"Use the 32-bit version of " _T(APPNAME) L" to profile 32-bit processes if a minidump needs to be included."
+		);
+	}
+#endif
+
+	wxFile f;
+	std::wstring dumppath = wxFileName::CreateTempFileName(wxEmptyString, &f);
+	wenforce(dbgHelpMs.MiniDumpWriteDump(
+		process_handle,
+		GetProcessId(process_handle),
+		(HANDLE)_get_osfhandle(f.fd()),
+		MiniDumpNormal,
+		NULL, NULL, NULL), "MiniDumpWriteDump");
+	f.Close();
+	return dumppath;
+}
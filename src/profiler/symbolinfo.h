@@ -1,87 +1,210 @@
-/*=====================================================================
-symbolinfo.h
-------------
-File created by ClassTemplate on Sat Mar 05 19:10:20 2005
-
-Copyright (C) Nicholas Chapman
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html..
-=====================================================================*/
-#ifndef __SYMBOLINFO_H_666_
-#define __SYMBOLINFO_H_666_
-
-
-#include <string>
-#include <windows.h>
-#include <vector>
-#include "profiler.h"
-
-typedef void SymLogFn(const wchar_t *text);
-
-struct DbgHelp;
-
-class Module
-{
-public:
-	Module(PROFILER_ADDR base_addr_, const std::wstring& name_, DbgHelp *dbghelp_)
-	{
-		base_addr = base_addr_;
-		name = name_;
-		dbghelp = dbghelp_;
-	}
-	PROFILER_ADDR base_addr;
-	std::wstring name;
-	DbgHelp *dbghelp;
-};
-
-/*=====================================================================
-SymbolInfo
-----------
-Wrapper around some DbgHelp API stuff.
-=====================================================================*/
-class SymbolInfo
-{
-public:
-	SymbolInfo();
-	~SymbolInfo();
-
-	void loadSymbols(HANDLE process_handle, bool download);//throws SymbolInfoExcep
-	std::wstring saveMinidump();
-
-	Module *getModuleForAddr(PROFILER_ADDR addr);
-	const std::wstring getModuleNameForAddr(PROFILER_ADDR addr);
-	const std::wstring getProcForAddr(PROFILER_ADDR addr, std::wstring& procfilepath_out, int& proclinenum_out);
-
-	void getLineForAddr(PROFILER_ADDR addr, std::wstring& filepath_out, int& linenum_out);
-
-	HANDLE process_handle;
-
-private:
-	std::vector<Module> modules;
-	bool is64BitProcess;
-
-	void addModule(const Module& module);
-	void sortModules();
-
-	friend BOOL CALLBACK EnumModules(PCWSTR ModuleName, DWORD64 BaseOfDll, PVOID UserContext);
-	void loadSymbolsUsing(DbgHelp* dbgHelp, const std::wstring& sympath);//throws SymbolInfoExcep
-	DbgHelp* getGccDbgHelp();
-};
-
-extern SymLogFn *g_symLog;
-
-#endif //__SYMBOLINFO_H_666_
+/*=====================================================================
+symbolinfo.h
+------------
+File created by ClassTemplate on Sat Mar 05 19:10:20 2005
+
+Copyright (C) Nicholas Chapman
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+#ifndef __SYMBOLINFO_H_666_
+#define __SYMBOLINFO_H_666_
+
+
+#include <deque>
+#include <string>
+#include <windows.h>
+#include <vector>
+#include "profiler.h"
+#include "moduleindex.h"
+#include "symbolcache.h"
+#include "../utils/mutex.h"
+
+typedef void SymLogFn(const wchar_t *text);
+
+struct DbgHelp;
+class CaptureEncoder;
+
+class Module
+{
+public:
+	Module(PROFILER_ADDR base_addr_, PROFILER_ADDR size_, const std::wstring& name_, DbgHelp *dbghelp_)
+	{
+		base_addr = base_addr_;
+		size = size_;
+		name = name_;
+		dbghelp = dbghelp_;
+		cached = NULL;
+		frame_pointer_breaks = 0;
+	}
+	PROFILER_ADDR base_addr;
+	PROFILER_ADDR size; // 0 if unknown; then it reaches up to the next module
+	std::wstring name;
+	DbgHelp *dbghelp;
+
+	// Its executable sections, from the PE header in the target's memory;
+	// empty if they couldn't be read.
+	struct CodeRange
+	{
+		PROFILER_ADDR start, end; // [start, end)
+	};
+	std::vector<CodeRange> code_ranges;
+
+	// Whether addr, which getModuleForAddr found in this module, can be
+	// in its code. Goes by the sections where they're known, else by
+	// the image size; with neither, anything in the module passes.
+	bool isCode(PROFILER_ADDR addr) const
+	{
+		if (!code_ranges.empty())
+		{
+			for (size_t i = 0; i < code_ranges.size(); i++)
+				if (addr >= code_ranges[i].start && addr < code_ranges[i].end)
+					return true;
+			return false;
+		}
+		return !size || addr - base_addr < size;
+	}
+
+	// Symbols found for this build of the module by earlier lookups,
+	// or NULL if there's no telling which build it is.
+	CachedSymbols *cached;
+
+	// How many times a frame-pointer chain has been seen to break in this
+	// module. Bumped by any sampler, with InterlockedIncrement; past a few,
+	// its stacks are always walked by DbgHelp.
+	volatile LONG frame_pointer_breaks;
+};
+
+/*=====================================================================
+SymbolInfo
+----------
+Wrapper around some DbgHelp API stuff.
+=====================================================================*/
+class SymbolInfo
+{
+public:
+	SymbolInfo();
+	~SymbolInfo();
+
+	void loadSymbols(HANDLE process_handle, bool download);//throws SymbolInfoExcep
+	std::wstring saveMinidump();
+
+	Module *getModuleForAddr(PROFILER_ADDR addr);
+	const std::wstring getModuleNameForAddr(PROFILER_ADDR addr);
+	const std::wstring getProcForAddr(PROFILER_ADDR addr, std::wstring& procfilepath_out, int& proclinenum_out);
+
+	void getLineForAddr(PROFILER_ADDR addr, std::wstring& filepath_out, int& linenum_out);
+
+	// A function the compiler inlined at an address.
+	struct InlineFrame
+	{
+		std::wstring proc;
+		std::wstring file;
+		int line;
+	};
+
+	// What Symbols.bin records for an address.
+	struct AddrSymbol
+	{
+		std::wstring module;
+		std::wstring proc;
+		std::wstring file;
+		int line;
+		std::vector<InlineFrame> inlined; // innermost first
+	};
+
+	/// Add count addresses, in order, and the functions inlined at them,
+	/// to what will be saved as Symbols.bin.
+	void encodeSymbols(CaptureEncoder &encoder, const PROFILER_ADDR *addrs, const AddrSymbol *symbols, size_t count);
+
+	// What Modules.txt records about a module: enough to find its
+	// symbols later, on another machine, without the process or its files.
+	struct ModuleRecord
+	{
+		PROFILER_ADDR base_addr;
+		PROFILER_ADDR size;
+		std::wstring name;
+		std::wstring image_path;
+		DWORD timestamp; // from the PE header; 0 if unknown
+		std::wstring pdb_path; // from the CodeView record; empty if none
+		GUID pdb_guid;
+		DWORD pdb_age;
+	};
+
+	/// Describe the modules of the process loadSymbols was called for.
+	void getModuleRecords(std::vector<ModuleRecord> &records);
+
+	/// Instead of a process's, load symbols for the modules in records, as
+	/// they were laid out in a process that may be long gone. Images that
+	/// can't be found (or are of other builds) are left out, and their
+	/// PDBs are searched for by GUID and age.
+	void loadModuleRecords(const std::vector<ModuleRecord> &records, bool is64Bit, bool download);
+
+	static std::wstring formatModuleRecord(const ModuleRecord &record);
+	static bool parseModuleRecord(const std::wstring &line, ModuleRecord &record);
+
+	bool getIs64BitProcess() const { return is64BitProcess; }
+
+	/// What addresses without a symbol are called.
+	std::wstring getUnknownProcName(PROFILER_ADDR addr);
+
+	/// Look up count sorted addresses, all in the same module (or in none),
+	/// into results. An address in the same function as an earlier one
+	/// reuses that function's lookup. num_done is bumped for each address;
+	/// gives up early if *stop is set. Doesn't take dbghelp_mutex, so
+	/// only call it while nothing is sampling.
+	void resolveAddrs(const PROFILER_ADDR *addrs, size_t count, AddrSymbol *results,
+					  volatile LONG *num_done, const volatile bool *stop);
+
+	/// Keep what's been looked up for the next capture.
+	void saveSymbolCache();
+
+	HANDLE process_handle;
+
+	// DbgHelp is single threaded. Hold this around calls into it
+	// that may happen while sampler workers are walking stacks.
+	Mutex dbghelp_mutex;
+
+private:
+	// Only ever appended to, so Module pointers stay valid.
+	std::deque<Module> modules;
+	bool is64BitProcess;
+
+	// What getModuleForAddr searches. Replaced whole when modules are
+	// added; indexes it replaced are kept until we're destroyed, as
+	// samplers may still be looking through them.
+	ModuleIndex *volatile module_index;
+	std::vector<ModuleIndex *> old_module_indexes;
+	SymbolCache symbol_cache;
+
+	std::string getCacheKey(const Module& mod);
+
+	void getInlineFrames(DbgHelp *dbgHelp, PROFILER_ADDR addr, SYMBOL_INFOW *symbol_info, std::vector<InlineFrame> &inlined);
+
+	void addModule(const Module& module);
+	void rebuildModuleIndex();
+
+	friend BOOL CALLBACK EnumModules(PCWSTR ModuleName, DWORD64 BaseOfDll, PVOID UserContext);
+	void loadSymbolsUsing(DbgHelp* dbgHelp, const std::wstring& sympath, const std::vector<ModuleRecord> *records);//throws SymbolInfoExcep
+	void loadModuleRecord(DbgHelp* dbgHelp, const ModuleRecord& record);
+	void openSymbolCache();
+	DbgHelp* getGccDbgHelp();
+};
+
+extern SymLogFn *g_symLog;
+
+#endif //__SYMBOLINFO_H_666_
@@ -0,0 +1,98 @@
+/*=====================================================================
+unwindcache.cpp
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "unwindcache.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+// x86 and x64 don't reorder loads with other loads, or stores with
+// other stores; only the compiler has to be kept from doing so.
+static long loadAcquire(volatile long *p) { long value = *p; _ReadWriteBarrier(); return value; }
+static void loadFence() { _ReadWriteBarrier(); }
+static void storeRelease(volatile long *p, long value) { _ReadWriteBarrier(); *p = value; }
+static bool compareExchange(volatile long *p, long expected, long desired)
+{
+	return _InterlockedCompareExchange(p, desired, expected) == expected;
+}
+#else
+static long loadAcquire(volatile long *p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static void loadFence() { __atomic_thread_fence(__ATOMIC_ACQUIRE); }
+static void storeRelease(volatile long *p, long value) { __atomic_store_n(p, value, __ATOMIC_RELEASE); }
+static bool compareExchange(volatile long *p, long expected, long desired)
+{
+	return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+#endif
+
+UnwindCache::UnwindCache(size_t num_slots)
+{
+	size_t size = 1;
+	while (size < num_slots)
+		size *= 2;
+	mask = size - 1;
+
+	Slot empty;
+	memset(&empty, 0, sizeof(empty));
+	slots.assign(size, empty);
+}
+
+UnwindCache::Slot &UnwindCache::slotFor(PROFILER_ADDR pc)
+{
+	// Fibonacci hashing spreads return addresses, which cluster, over the slots.
+	unsigned long long hash = (unsigned long long)pc * 0x9E3779B97F4A7C15ULL;
+	return slots[(size_t)(hash >> 32) & mask];
+}
+
+bool UnwindCache::lookup(PROFILER_ADDR pc, UnwindRule &rule)
+{
+	Slot &slot = slotFor(pc);
+
+	long seq = loadAcquire(&slot.seq);
+	if ((seq & 1) || slot.pc != pc)
+		return false;
+
+	rule = slot.rule;
+	loadFence();
+	return slot.seq == seq;
+}
+
+void UnwindCache::insert(PROFILER_ADDR pc, const UnwindRule &rule)
+{
+	Slot &slot = slotFor(pc);
+
+	long seq = slot.seq;
+	if ((seq & 1) || !compareExchange(&slot.seq, seq, seq + 1))
+		return; // someone else is writing it
+
+	slot.pc = pc;
+	slot.rule = rule;
+	storeRelease(&slot.seq, seq + 2);
+}
+
+void UnwindCache::clear()
+{
+	for (size_t i = 0; i < slots.size(); i++)
+	{
+		slots[i].pc = 0;
+		slots[i].seq += 2;
+	}
+}
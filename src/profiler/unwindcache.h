@@ -0,0 +1,72 @@
+/*=====================================================================
+unwindcache.h
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __UNWINDCACHE_H_666_
+#define __UNWINDCACHE_H_666_
+
+#include "framewalker.h"
+#include <vector>
+
+/*=====================================================================
+UnwindCache
+-----------
+Remembers the UnwindRule worked out for each PC. A long-running target
+keeps returning to the same few thousand addresses, so after a while
+almost every frame is unwound from here, without going back to the
+module's unwind tables (or on Windows, to DbgHelp and its lock).
+
+The cache is bounded and direct-mapped: each PC has one slot, and a new
+rule evicts whatever was there. Lookups and inserts take no locks, so
+walkers on any number of threads can share one. Each slot is versioned
+like a seqlock; a lookup that races an insert into the same slot just
+misses, and an insert that races another is dropped.
+=====================================================================*/
+class UnwindCache
+{
+public:
+	/// num_slots is rounded up to a power of two.
+	explicit UnwindCache(size_t num_slots = 4096);
+
+	/// Returns false if pc has no rule cached.
+	bool lookup(PROFILER_ADDR pc, UnwindRule &rule);
+	void insert(PROFILER_ADDR pc, const UnwindRule &rule);
+
+	/// Forget everything, e.g. when a module is unloaded. Not safe
+	/// while other threads are using the cache.
+	void clear();
+
+private:
+	struct Slot
+	{
+		/// Odd while the slot is being written.
+		volatile long seq;
+		PROFILER_ADDR pc;
+		UnwindRule rule;
+	};
+
+	std::vector<Slot> slots;
+	size_t mask;
+
+	Slot &slotFor(PROFILER_ADDR pc);
+};
+
+#endif //__UNWINDCACHE_H_666_
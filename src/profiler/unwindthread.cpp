@@ -0,0 +1,130 @@
+/*=====================================================================
+unwindthread.cpp
+----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "unwindthread.h"
+#include "callstacktrie.h"
+#include "sampletimings.h"
+#include "samplelog.h"
+
+// Number of snapshots that can be waiting to be unwound at once.
+static const size_t kPoolSize = 128;
+
+UnwindThread::UnwindThread(CallStackTrie& callstacks_, SampleTimings& timings_, SampleLog *samplelog_, SymbolInfo *sym_info_, UnwindCache *unwind_cache_)
+:	callstacks(callstacks_),
+	timings(timings_),
+	samplelog(samplelog_),
+	sym_info(sym_info_),
+	unwind_cache(unwind_cache_),
+	pool(kPoolSize),
+	finishing(false),
+	numDropped(0)
+{
+	freelist.reserve(pool.size());
+	for (size_t n=0;n<pool.size();n++)
+		freelist.push_back(&pool[n]);
+
+	work_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+}
+
+UnwindThread::~UnwindThread()
+{
+	CloseHandle(work_event);
+}
+
+StackSnapshot *UnwindThread::acquire()
+{
+	Lock lock(mutex);
+	if (freelist.empty())
+	{
+		numDropped++;
+		return NULL;
+	}
+
+	StackSnapshot *snapshot = freelist.back();
+	freelist.pop_back();
+	return snapshot;
+}
+
+void UnwindThread::submit(StackSnapshot *snapshot)
+{
+	{
+		Lock lock(mutex);
+		queue.push_back(snapshot);
+	}
+	SetEvent(work_event);
+}
+
+void UnwindThread::discard(StackSnapshot *snapshot)
+{
+	Lock lock(mutex);
+	freelist.push_back(snapshot);
+}
+
+void UnwindThread::finish()
+{
+	{
+		Lock lock(mutex);
+		finishing = true;
+	}
+	SetEvent(work_event);
+	waitFor();
+}
+
+void UnwindThread::run()
+{
+	CallStack stack;
+
+	for (;;)
+	{
+		StackSnapshot *snapshot = NULL;
+		{
+			Lock lock(mutex);
+			if (!queue.empty())
+			{
+				snapshot = queue.front();
+				queue.pop_front();
+			}
+			else if (finishing)
+				break;
+		}
+
+		if (!snapshot)
+		{
+			WaitForSingleObject(work_event, INFINITE);
+			continue;
+		}
+
+		LONGLONG walkStart = SampleTimings::now();
+		Profiler::unwindSnapshot(*snapshot, sym_info, unwind_cache, timings, stack);
+		LONGLONG walkEnd = SampleTimings::now();
+
+		// The trie and log are only written from this thread while the unwinder runs.
+		CallStackTrie::NodeID node = callstacks.addSample(stack, snapshot->timeSpent);
+		if (samplelog)
+			samplelog->add(snapshot->timestamp, snapshot->thread_id, node, snapshot->timeSpent);
+		LONGLONG aggregated = SampleTimings::now();
+
+		timings.walk     .add(SampleTimings::toNanoseconds(walkEnd    - walkStart));
+		timings.aggregate.add(SampleTimings::toNanoseconds(aggregated - walkEnd  ));
+
+		discard(snapshot);
+	}
+}
@@ -0,0 +1,84 @@
+/*=====================================================================
+unwindthread.h
+--------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __UNWINDTHREAD_H_666_
+#define __UNWINDTHREAD_H_666_
+
+#include "../utils/mythread.h"
+#include "../utils/mutex.h"
+#include "stacksnapshot.h"
+#include <deque>
+#include <vector>
+
+class CallStackTrie;
+struct SampleTimings;
+class SampleLog;
+class UnwindCache;
+
+/*=====================================================================
+UnwindThread
+------------
+Walks the stack snapshots taken by Profiler::captureSnapshot, and adds
+the resulting callstacks to the trie. This lets the sampler resume the
+target thread as soon as its stack has been copied.
+
+Snapshots come from a fixed pool. If the unwinder falls behind and the
+pool runs dry, samples are dropped rather than stalling the sampler.
+=====================================================================*/
+class UnwindThread : public MyThread
+{
+public:
+	UnwindThread(CallStackTrie& callstacks, SampleTimings& timings, SampleLog *samplelog, SymbolInfo *sym_info, UnwindCache *unwind_cache);
+	virtual ~UnwindThread();
+
+	virtual void run();
+
+	/// Take an unused snapshot from the pool, or NULL if there is none.
+	StackSnapshot *acquire();
+	/// Queue a snapshot filled in by acquire()'s caller for unwinding.
+	void submit(StackSnapshot *snapshot);
+	/// Return an unused snapshot to the pool.
+	void discard(StackSnapshot *snapshot);
+
+	/// Unwind everything still queued, then stop the thread.
+	void finish();
+
+	int getNumDropped() const { return numDropped; }
+
+private:
+	CallStackTrie& callstacks;
+	SampleTimings& timings;
+	SampleLog *samplelog;
+	SymbolInfo *sym_info;
+	UnwindCache *unwind_cache;
+
+	std::vector<StackSnapshot> pool;
+
+	Mutex mutex;
+	std::vector<StackSnapshot *> freelist;
+	std::deque<StackSnapshot *> queue;
+	HANDLE work_event;
+	bool finishing;
+	int numDropped;
+};
+
+#endif //__UNWINDTHREAD_H_666_
@@ -0,0 +1,138 @@
+/*=====================================================================
+callstacktrietests.cpp
+----------------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "testing.h"
+#include "../profiler/callstacktrie.h"
+#include <map>
+#include <vector>
+
+typedef std::vector<PROFILER_ADDR> Frames; // innermost first
+typedef std::map<Frames, SAMPLE_TYPE> StackCounts;
+
+static CallStack makeStack(const Frames &frames)
+{
+	CallStack stack;
+	stack.depth = frames.size();
+	for (size_t n = 0; n < frames.size(); n++)
+		stack.addr[n] = frames[n];
+	return stack;
+}
+
+// The stacks a trie holds, found by walking up from each counted node.
+static StackCounts getStacks(const CallStackTrie &trie)
+{
+	StackCounts stacks;
+	for (CallStackTrie::NodeID id = 1; id < trie.getNodeCount(); id++)
+	{
+		if (trie.getNode(id).count == 0)
+			continue;
+		Frames frames;
+		for (CallStackTrie::NodeID n = id; n != CallStackTrie::ROOT; n = trie.getNode(n).parent)
+			frames.push_back(trie.getNode(n).addr);
+		stacks[frames] += trie.getNode(id).count;
+	}
+	return stacks;
+}
+
+static Frames frames3(PROFILER_ADDR inner, PROFILER_ADDR middle, PROFILER_ADDR outer)
+{
+	Frames frames;
+	frames.push_back(inner);
+	frames.push_back(middle);
+	frames.push_back(outer);
+	return frames;
+}
+
+TEST(trieReturnsTheStacksAdded)
+{
+	CallStackTrie trie;
+	StackCounts expected;
+
+	expected[frames3(0x1010, 0x2020, 0x3030)] = 1;
+	expected[frames3(0x1011, 0x2020, 0x3030)] = 0.5;
+	expected[frames3(0x1010, 0x2021, 0x3030)] = 2;
+	Frames single(1, 0x3030);
+	expected[single] = 4;
+
+	for (StackCounts::const_iterator it = expected.begin(); it != expected.end(); ++it)
+		trie.addSample(makeStack(it->first), it->second);
+	// Adding a stack again adds to its count.
+	trie.addSample(makeStack(frames3(0x1010, 0x2020, 0x3030)), 1);
+	expected[frames3(0x1010, 0x2020, 0x3030)] += 1;
+
+	CHECK(getStacks(trie) == expected);
+
+	// Stacks share their outer frames: 0x3030, 0x2020, 0x2021 and three inner ones.
+	CHECK(trie.getNodeCount() == 1 + 6);
+}
+
+TEST(trieParentsComeBeforeChildren)
+{
+	CallStackTrie trie;
+	trie.addSample(makeStack(frames3(1, 2, 3)), 1);
+	trie.addSample(makeStack(frames3(4, 5, 6)), 1);
+
+	for (CallStackTrie::NodeID id = 1; id < trie.getNodeCount(); id++)
+		CHECK(trie.getNode(id).parent < id);
+}
+
+TEST(trieIgnoresEmptyStacks)
+{
+	CallStackTrie trie;
+	CHECK(trie.addSample(makeStack(Frames()), 1) == CallStackTrie::ROOT);
+	CHECK(trie.getNodeCount() == 1);
+}
+
+TEST(trieKeepsStacksAsItGrows)
+{
+	// Enough distinct frames to make the table grow several times.
+	CallStackTrie trie;
+	StackCounts expected;
+	for (PROFILER_ADDR i = 0; i < 20000; i++)
+	{
+		Frames frames = frames3(0x100000 + i, 0x2000 + i % 97, 0x10);
+		expected[frames] += 1;
+		trie.addSample(makeStack(frames), 1);
+	}
+
+	CHECK(getStacks(trie) == expected);
+}
+
+TEST(trieMergeAddsCounts)
+{
+	CallStackTrie a, b;
+	a.addSample(makeStack(frames3(1, 2, 3)), 1);
+	b.addSample(makeStack(frames3(7, 2, 3)), 2);
+	b.addSample(makeStack(frames3(1, 2, 3)), 3);
+
+	std::vector<CallStackTrie::NodeID> mapping;
+	a.merge(b, &mapping);
+
+	StackCounts expected;
+	expected[frames3(1, 2, 3)] = 4;
+	expected[frames3(7, 2, 3)] = 2;
+	CHECK(getStacks(a) == expected);
+
+	// Each of b's nodes maps to the node of a with the same address.
+	CHECK(mapping.size() == b.getNodeCount());
+	for (CallStackTrie::NodeID id = 1; id < b.getNodeCount(); id++)
+		CHECK(a.getNode(mapping[id]).addr == b.getNode(id).addr);
+}
@@ -0,0 +1,164 @@
+/*=====================================================================
+captureformattests.cpp
+----------------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "testing.h"
+#include "../profiler/captureformat.h"
+#include "../profiler/callstacktrie.h"
+#include <map>
+#include <string>
+#include <vector>
+
+// Symbols.bin for: an address outside any module; two in a.dll, the
+// second with two functions inlined there; one in b.dll.
+static void encodeTestSymbols(CaptureEncoder &encoder)
+{
+	encoder.addSymbol(0x1000, 0, "", "[00001000]", "", 0);
+	encoder.addSymbol(0x10001000, 0x10000000, "a.dll", "main", "a.cpp", 10);
+	encoder.addSymbol(0x10001010, 0x10000000, "a.dll", "main", "a.cpp", 12);
+	encoder.addInlined("inner", "inner.h", 3);
+	encoder.addInlined("outer", "outer.h", 7);
+	encoder.addSymbol(0x20000500, 0x20000000, "b.dll", "helper", "", 0);
+}
+
+static bool decode(CaptureDecoder &decoder, const std::vector<unsigned char> &data)
+{
+	return !data.empty() && decoder.decodeSymbols(&data[0], data.size());
+}
+
+TEST(symbolsRoundTrip)
+{
+	CaptureEncoder encoder;
+	encodeTestSymbols(encoder);
+	std::vector<unsigned char> data;
+	encoder.encodeSymbols(data);
+
+	CaptureDecoder decoder;
+	CHECK(decode(decoder, data));
+
+	CHECK(decoder.addrs.size() == 4);
+	CHECK(decoder.addrs[0] == 0x1000);
+	CHECK(decoder.addrs[1] == 0x10001000);
+	CHECK(decoder.addrs[2] == 0x10001010);
+	CHECK(decoder.addrs[3] == 0x20000500);
+
+	// Each address, then what was inlined there.
+	const std::vector<CaptureDecoder::Symbol> &symbols = decoder.symbols;
+	const std::vector<std::string> &strings = decoder.strings;
+	CHECK(symbols.size() == 6);
+	if (symbols.size() != 6)
+		return;
+
+	CHECK(symbols[0].addr == 0x1000 && symbols[0].depth == 0);
+	CHECK(strings[symbols[0].module] == "" && strings[symbols[0].proc] == "[00001000]");
+
+	CHECK(symbols[1].addr == 0x10001000 && symbols[1].depth == 0);
+	CHECK(strings[symbols[1].module] == "a.dll" && strings[symbols[1].proc] == "main");
+	CHECK(strings[symbols[1].file] == "a.cpp" && symbols[1].line == 10);
+
+	CHECK(symbols[2].addr == 0x10001010 && symbols[2].line == 12);
+	CHECK(symbols[3].addr == inlineFrameAddress(0x10001010, 1) && symbols[3].depth == 1);
+	CHECK(strings[symbols[3].proc] == "inner" && strings[symbols[3].file] == "inner.h" && symbols[3].line == 3);
+	CHECK(symbols[4].addr == inlineFrameAddress(0x10001010, 2) && symbols[4].depth == 2);
+	CHECK(strings[symbols[4].proc] == "outer" && strings[symbols[4].file] == "outer.h" && symbols[4].line == 7);
+	CHECK(strings[symbols[4].module] == "a.dll");
+
+	CHECK(symbols[5].addr == 0x20000500);
+	CHECK(strings[symbols[5].module] == "b.dll" && strings[symbols[5].proc] == "helper");
+	CHECK(strings[symbols[5].file] == "" && symbols[5].line == 0);
+}
+
+TEST(symbolsRejectTruncatedData)
+{
+	CaptureEncoder encoder;
+	encodeTestSymbols(encoder);
+	std::vector<unsigned char> data;
+	encoder.encodeSymbols(data);
+
+	for (size_t size = 0; size < data.size(); size++)
+	{
+		CaptureDecoder decoder;
+		CHECK(!decoder.decodeSymbols(&data[0], size));
+	}
+
+	// Nor may anything follow.
+	data.push_back(0);
+	CaptureDecoder decoder;
+	CHECK(!decode(decoder, data));
+}
+
+static CallStack makeStack(PROFILER_ADDR inner, PROFILER_ADDR outer)
+{
+	CallStack stack;
+	stack.depth = 2;
+	stack.addr[0] = inner;
+	stack.addr[1] = outer;
+	return stack;
+}
+
+TEST(samplesRoundTrip)
+{
+	CaptureEncoder encoder;
+	encodeTestSymbols(encoder);
+
+	CallStackTrie callstacks;
+	callstacks.addSample(makeStack(0x10001010, 0x1000), 0.25);
+	callstacks.addSample(makeStack(0x20000500, 0x10001000), 0.5);
+	callstacks.addSample(makeStack(0x10001010, 0x10001000), 1);
+
+	std::vector<unsigned char> symbols, ipCounts, stacks;
+	encoder.encodeSymbols(symbols);
+	encoder.encodeIpCounts(callstacks, ipCounts);
+	encoder.encodeCallstacks(callstacks, stacks);
+
+	CaptureDecoder decoder;
+	CHECK(decode(decoder, symbols));
+
+	// IP counts are by innermost frame, in microseconds.
+	unsigned long long total;
+	std::vector<std::pair<unsigned, unsigned long long> > counts;
+	CHECK(decoder.decodeIpCounts(&ipCounts[0], ipCounts.size(), total, counts));
+	CHECK(total == 1750000);
+	std::map<unsigned long long, unsigned long long> countsByAddr;
+	for (size_t i = 0; i < counts.size(); i++)
+		countsByAddr[decoder.addrs[counts[i].first]] = counts[i].second;
+	CHECK(countsByAddr.size() == 2);
+	CHECK(countsByAddr[0x10001010] == 1250000);
+	CHECK(countsByAddr[0x20000500] == 500000);
+
+	// The trie comes back node for node.
+	std::vector<CaptureDecoder::Node> nodes;
+	CHECK(decoder.decodeCallstacks(&stacks[0], stacks.size(), nodes));
+	CHECK(nodes.size() == callstacks.getNodeCount());
+	for (CallStackTrie::NodeID id = 1; id < nodes.size() && id < callstacks.getNodeCount(); id++)
+	{
+		const CallStackTrie::Node &node = callstacks.getNode(id);
+		CHECK(nodes[id].parent == node.parent);
+		CHECK(decoder.addrs[nodes[id].addr] == node.addr);
+		CHECK(nodes[id].count == CaptureEncoder::toMicroseconds(node.count));
+	}
+}
+
+TEST(tinyCountsAreKept)
+{
+	CHECK(CaptureEncoder::toMicroseconds(0) == 0);
+	CHECK(CaptureEncoder::toMicroseconds(1e-9) == 1);
+	CHECK(CaptureEncoder::toMicroseconds(2.5) == 2500000);
+}
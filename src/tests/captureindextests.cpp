@@ -0,0 +1,136 @@
+/*=====================================================================
+captureindextests.cpp
+---------------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "testing.h"
+#include "../wxProfilerGUI/captureindex.h"
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <string.h>
+
+// A file to stand for a capture; the index only goes by its size and time.
+static std::wstring makeCapture(const char *contents)
+{
+	std::wstring path = wxFileName::CreateTempFileName("sleepytest").wc_str();
+	wxFile file(path, wxFile::write);
+	file.Write(contents, strlen(contents));
+	return path;
+}
+
+static void removeCapture(const std::wstring &path)
+{
+	wxRemoveFile(path);
+	wxRemoveFile(path + L".index");
+}
+
+static CaptureIndex::Tables makeTables()
+{
+	CaptureIndex::Tables tables;
+	tables.files.push_back(tables.addString(L"a.cpp"));
+	tables.modules.push_back(tables.addString(L"a.exe"));
+	tables.modules.push_back(tables.addString(L"b.dll"));
+
+	CaptureIndex::SymbolRecord mainSymbol = { 0x401000, tables.addString(L"main"), 0, 0, 0 };
+	CaptureIndex::SymbolRecord helperSymbol = { 0x10001000, tables.addString(L"helper"), 0, 1, 0 };
+	tables.symbols.push_back(mainSymbol);
+	tables.symbols.push_back(helperSymbol);
+
+	CaptureIndex::AddrRecord addr0 = { 0x401010, 0, 12, 1.5, 60, 0 };
+	CaptureIndex::AddrRecord addr1 = { 0x10001020, 1, 0, 1, 40, 0 };
+	tables.addrs.push_back(addr0);
+	tables.addrs.push_back(addr1);
+
+	CaptureIndex::StackRecord stack = { 2.5, 0, 2 };
+	tables.stacks.push_back(stack);
+	tables.frames.push_back(1);
+	tables.frames.push_back(0);
+
+	tables.threads.push_back(42);
+	CaptureIndex::SampleRecord sample = { 0.125, 2.5, 42, 0 };
+	tables.samples.push_back(sample);
+	return tables;
+}
+
+TEST(indexRoundTrip)
+{
+	std::wstring capture = makeCapture("capture");
+	CaptureIndex::Tables tables = makeTables();
+	CHECK(CaptureIndex::save(capture, CaptureIndex::GROUP_TEMPLATES, tables));
+
+	CaptureIndex index;
+	CHECK(index.map(capture, CaptureIndex::GROUP_TEMPLATES));
+
+	CHECK(index.getNumFiles() == 1 && index.getString(index.getFiles()[0]) == L"a.cpp");
+	CHECK(index.getNumModules() == 2);
+	CHECK(index.getString(index.getModules()[0]) == L"a.exe");
+	CHECK(index.getString(index.getModules()[1]) == L"b.dll");
+
+	CHECK(index.getNumSymbols() == 2);
+	CHECK(index.getSymbols()[1].address == 0x10001000);
+	CHECK(index.getString(index.getSymbols()[1].proc) == L"helper");
+	CHECK(index.getSymbols()[1].module == 1);
+
+	CHECK(index.getNumAddrs() == 2);
+	CHECK(index.getAddrs()[0].addr == 0x401010 && index.getAddrs()[0].line == 12);
+	CHECK(index.getAddrs()[0].count == 1.5 && index.getAddrs()[0].percentage == 60);
+
+	CHECK(index.getNumStacks() == 1 && index.getStacks()[0].samplecount == 2.5);
+	CHECK(index.getStacks()[0].first_frame == 0 && index.getStacks()[0].num_frames == 2);
+	CHECK(index.getFrames()[0] == 1 && index.getFrames()[1] == 0);
+
+	CHECK(index.getNumThreads() == 1 && index.getThreads()[0] == 42);
+	CHECK(index.getNumSamples() == 1);
+	CHECK(index.getSamples()[0].time == 0.125 && index.getSamples()[0].stack == 0);
+
+	index.unmap();
+	removeCapture(capture);
+}
+
+TEST(indexIsOnlyForItsCapture)
+{
+	std::wstring capture = makeCapture("capture");
+	CHECK(CaptureIndex::save(capture, 0, makeTables()));
+
+	// Made with other options, the tables could be different.
+	CaptureIndex index;
+	CHECK(!index.map(capture, CaptureIndex::MINIDUMP_SYMBOLS));
+
+	// A capture that has changed since needs a new index.
+	{
+		wxFile file(capture, wxFile::write_append);
+		file.Write("more", 4);
+	}
+	CHECK(!index.map(capture, 0));
+
+	removeCapture(capture);
+}
+
+TEST(indexRejectsBadReferences)
+{
+	std::wstring capture = makeCapture("capture");
+	CaptureIndex::Tables tables = makeTables();
+	tables.symbols[0].module = 2; // there are two modules
+	CHECK(CaptureIndex::save(capture, 0, tables));
+
+	CaptureIndex index;
+	CHECK(!index.map(capture, 0));
+
+	removeCapture(capture);
+}
@@ -0,0 +1,139 @@
+/*=====================================================================
+databasetests.cpp
+-----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "testing.h"
+#include "../appinfo.h"
+#include "../profiler/callstacktrie.h"
+#include "../profiler/captureformat.h"
+#include "../wxProfilerGUI/database.h"
+#include <wx/filename.h>
+#include <wx/wfstream.h>
+#include <wx/zipstrm.h>
+#include <map>
+
+struct TestFunction
+{
+	const char *module;
+	PROFILER_ADDR base;
+	const char *proc;
+};
+
+static void putEntry(wxZipOutputStream &zip, const wxString &name, const std::vector<unsigned char> &data)
+{
+	zip.PutNextEntry(name);
+	if (!data.empty())
+		zip.Write(&data[0], data.size());
+}
+
+// A capture of one stack through the given functions, which are in
+// address order, outermost first; each is 0x1000 into its module.
+static std::wstring writeCapture(const TestFunction *functions, size_t count)
+{
+	CaptureEncoder encoder;
+	CallStack stack;
+	stack.depth = count;
+	for (size_t i = 0; i < count; i++)
+	{
+		PROFILER_ADDR addr = functions[i].base + 0x1000;
+		encoder.addSymbol(addr, functions[i].base, functions[i].module, functions[i].proc, "", 0);
+		stack.addr[count - 1 - i] = addr;
+	}
+	CallStackTrie callstacks;
+	callstacks.addSample(stack, 1);
+
+	std::vector<unsigned char> symbols, ipCounts, stacks;
+	encoder.encodeSymbols(symbols);
+	encoder.encodeIpCounts(callstacks, ipCounts);
+	encoder.encodeCallstacks(callstacks, stacks);
+
+	std::wstring path = wxFileName::CreateTempFileName("sleepytest").wc_str();
+	{
+		wxFFileOutputStream out(path);
+		wxZipOutputStream zip(out);
+
+		static const char modules[] = "32 resolved\n";
+		putEntry(zip, "Modules.txt", std::vector<unsigned char>(modules, modules + sizeof(modules) - 1));
+		putEntry(zip, "Symbols.bin", symbols);
+		putEntry(zip, "IPCounts.bin", ipCounts);
+		putEntry(zip, "Callstacks.bin", stacks);
+		putEntry(zip, "Version " FORMAT_VERSION " required", std::vector<unsigned char>());
+	}
+	return path;
+}
+
+static void removeCapture(const std::wstring &path)
+{
+	wxRemoveFile(path);
+	wxRemoveFile(path + L".index");
+}
+
+// Whether the database holds just these functions, each in its module,
+// and no other modules.
+static bool holds(const Database &database, const TestFunction *functions, size_t count)
+{
+	std::map<std::wstring, std::wstring> expected;
+	for (size_t i = 0; i < count; i++)
+		expected[wxString(functions[i].proc).wc_str()] = wxString(functions[i].module).wc_str();
+
+	std::map<std::wstring, std::wstring> found;
+	for (Database::Symbol::ID id = 0; id < database.getSymbolCount(); id++)
+	{
+		const Database::Symbol *symbol = database.getSymbol(id);
+		found[symbol->procname] = database.getModuleName(symbol->module);
+	}
+	return found == expected && database.getModuleCount() == count;
+}
+
+// Opening one capture after another, each from its index the second
+// time, leaves only that capture's modules, and its symbols in them.
+TEST(databaseReopensCapturesInTurn)
+{
+	static const TestFunction functionsA[] = {
+		{ "a.exe", 0x400000, "mainA" },
+		{ "shared.dll", 0x10000000, "sharedA" },
+	};
+	static const TestFunction functionsB[] = {
+		{ "b.exe", 0x400000, "mainB" },
+		{ "other.dll", 0x20000000, "otherB" },
+		{ "third.dll", 0x30000000, "thirdB" },
+	};
+	const size_t countA = sizeof(functionsA) / sizeof(functionsA[0]);
+	const size_t countB = sizeof(functionsB) / sizeof(functionsB[0]);
+
+	std::wstring captureA = writeCapture(functionsA, countA);
+	std::wstring captureB = writeCapture(functionsB, countB);
+
+	Database database;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		database.loadFromPath(captureA, false, false, false);
+		CHECK(holds(database, functionsA, countA));
+		CHECK(wxFileExists(captureA + L".index"));
+
+		database.loadFromPath(captureB, false, false, false);
+		CHECK(holds(database, functionsB, countB));
+		CHECK(wxFileExists(captureB + L".index"));
+	}
+
+	database.clear();
+	removeCapture(captureA);
+	removeCapture(captureB);
+}
@@ -0,0 +1,60 @@
+/*=====================================================================
+testing.h
+---------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __TESTING_H_666_
+#define __TESTING_H_666_
+
+/*=====================================================================
+TestCase
+--------
+A unit test, defined with TEST and run by testmain.cpp in the order
+they were linked in. CHECK reports a failed condition and carries on;
+a test fails if any of its checks did, or if it throws.
+
+	TEST(trieKeepsCounts)
+	{
+		CHECK(trie.getNodeCount() == 3);
+	}
+=====================================================================*/
+struct TestCase
+{
+	TestCase(const char *name, void (*run)());
+
+	const char *name;
+	void (*run)();
+	TestCase *next;
+
+	/// Every test, in the order they were registered.
+	static TestCase *first;
+	static TestCase *last;
+};
+
+void checkFailed(const char *file, int line, const char *expression);
+
+#define TEST(name) \
+	static void name(); \
+	static TestCase name##Case(#name, name); \
+	static void name()
+
+#define CHECK(condition) ((condition) ? (void)0 : checkFailed(__FILE__, __LINE__, #condition))
+
+#endif //__TESTING_H_666_
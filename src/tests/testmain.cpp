@@ -0,0 +1,104 @@
+/*=====================================================================
+testmain.cpp
+------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+// Runs the unit tests: all of them, or those named on the command line.
+// Exits with 1 if any failed.
+
+#include "testing.h"
+#include <stdio.h>
+#include <string.h>
+#include <exception>
+#ifdef _WIN32
+#include <wx/app.h>
+#include <wx/init.h>
+#endif
+
+TestCase *TestCase::first = NULL;
+TestCase *TestCase::last = NULL;
+
+TestCase::TestCase(const char *name_, void (*run_)())
+:	name(name_),
+	run(run_),
+	next(NULL)
+{
+	(last ? last->next : first) = this;
+	last = this;
+}
+
+static bool currentFailed;
+
+void checkFailed(const char *file, int line, const char *expression)
+{
+	fprintf(stderr, "%s(%d): CHECK(%s) failed\n", file, line, expression);
+	currentFailed = true;
+}
+
+static bool isSelected(const TestCase *test, int argc, char *argv[])
+{
+	if (argc < 2)
+		return true;
+	for (int i = 1; i < argc; i++)
+		if (strcmp(argv[i], test->name) == 0)
+			return true;
+	return false;
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef _WIN32
+	// What's tested on Windows uses wxWidgets, down to progress dialogs.
+	wxApp::SetInstance(new wxApp());
+	wxInitializer initializer(argc, argv);
+	if (!initializer.IsOk())
+	{
+		fprintf(stderr, "Could not initialize wxWidgets\n");
+		return 1;
+	}
+#endif
+
+	int numRun = 0, numFailed = 0;
+	for (TestCase *test = TestCase::first; test; test = test->next)
+	{
+		if (!isSelected(test, argc, argv))
+			continue;
+
+		currentFailed = false;
+		try {
+			test->run();
+		} catch (const std::exception &e) {
+			fprintf(stderr, "%s threw: %s\n", test->name, e.what());
+			currentFailed = true;
+		} catch (...) {
+			fprintf(stderr, "%s threw\n", test->name);
+			currentFailed = true;
+		}
+
+		numRun++;
+		if (currentFailed)
+		{
+			numFailed++;
+			printf("FAILED: %s\n", test->name);
+		}
+	}
+
+	printf("%d of %d tests passed\n", numRun - numFailed, numRun);
+	return numFailed ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+/*=====================================================================
+demangler.cpp
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+#include "demangler.h"
+#include "dbginterface.h"
+#include "stringutils.h"
+#include "container.h"
+
+std::wstring Demangler::undecorate(const std::wstring &name)
+{
+	// MSVC's names are understood by Microsoft's DbgHelp, GCC's by Dr. MinGW's.
+	DbgHelp *dbgHelp = NULL;
+	size_t start = 0;
+	if (name.length() > 1 && name[0] == '?')
+		dbgHelp = &dbgHelpMs;
+	else if (name.compare(0, 2, L"_Z") == 0)
+		dbgHelp = &dbgHelpDrMingw;
+	else if (name.compare(0, 3, L"__Z") == 0)
+	{
+		// 32-bit MinGW puts its own underscore in front.
+		dbgHelp = &dbgHelpDrMingw;
+		start = 1;
+	}
+
+	if (!dbgHelp || !dbgHelp->Loaded || !dbgHelp->UnDecorateSymbolName)
+		return name;
+
+	std::string decorated = toUtf8(name.substr(start));
+	char buffer[4096];
+	if (!dbgHelp->UnDecorateSymbolName(decorated.c_str(), buffer, sizeof(buffer), UNDNAME_NAME_ONLY) ||
+		decorated == buffer)
+		return name;
+	return fromUtf8(buffer);
+}
+
+const std::wstring &Demangler::demangle(const std::wstring &name)
+{
+	bool inserted;
+	std::wstring &result = map_emplace(demangled, name, &inserted);
+	if (inserted)
+		result = undecorate(name);
+	return result;
+}
+
+const std::wstring &Demangler::groupName(const std::wstring &name)
+{
+	bool inserted;
+	std::wstring &result = map_emplace(grouped, name, &inserted);
+	if (inserted)
+		result = stripTemplateArgs(demangle(name));
+	return result;
+}
+
+std::wstring Demangler::stripTemplateArgs(const std::wstring &name)
+{
+	std::wstring result;
+	result.reserve(name.length());
+
+	static const wchar_t op[] = L"operator";
+	const size_t oplen = wcslen(op);
+
+	// Brackets inside parentheses in template arguments, as in
+	// "f<(a>b)>", are comparisons.
+	int depth = 0, parens = 0;
+	for (size_t i = 0; i < name.length(); i++)
+	{
+		wchar_t c = name[i];
+
+		// The brackets in operator<, operator<<=, operator-> and so on
+		// aren't template brackets.
+		if (depth == 0 && name.compare(i, oplen, op) == 0 &&
+			(i == 0 || !(iswalnum(name[i-1]) || name[i-1] == '_')))
+		{
+			result.append(op);
+			i += oplen;
+			while (i < name.length() && wcschr(L"<>=-", name[i]))
+				result += name[i++];
+			i--;
+			continue;
+		}
+
+		if (depth > 0 && (c == '(' || c == ')'))
+			parens += c == '(' ? 1 : -1;
+		else if (parens > 0)
+			continue;
+		else if (c == '<')
+		{
+			if (depth++ == 0)
+				result += c;
+		}
+		else if (c == '>' && depth > 0)
+		{
+			if (--depth == 0)
+				result += c;
+		}
+		else if (depth == 0)
+			result += c;
+	}
+	return result;
+}
@@ -0,0 +1,62 @@
+/*=====================================================================
+demangler.h
+-----------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+
+#pragma once
+#ifndef __DEMANGLER_H_666_
+#define __DEMANGLER_H_666_
+
+#include <string>
+#include <unordered_map>
+
+/*=====================================================================
+Demangler
+---------
+Turns the decorated names some symbolizers hand back (MSVC's "?..."
+names from exports, GCC's "_Z..." names from MinGW modules) into the
+names people wrote, and optionally into a group name with template
+arguments taken out, so that every instantiation of a template
+shares one.
+
+Each distinct name is worked out once; a capture names the same
+functions over and over, and reloads name them all again.
+=====================================================================*/
+class Demangler
+{
+public:
+	/// name itself if it isn't decorated, or can't be undecorated.
+	const std::wstring &demangle(const std::wstring &name);
+
+	/// demangle(name) with whatever is between template brackets removed:
+	/// "std::vector<int>::push_back" becomes "std::vector<>::push_back".
+	const std::wstring &groupName(const std::wstring &name);
+
+	static std::wstring stripTemplateArgs(const std::wstring &name);
+
+	size_t getNumNames() const { return demangled.size(); }
+
+private:
+	std::unordered_map<std::wstring, std::wstring> demangled;
+	std::unordered_map<std::wstring, std::wstring> grouped;
+
+	static std::wstring undecorate(const std::wstring &name);
+};
+
+#endif //__DEMANGLER_H_666_
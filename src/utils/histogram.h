@@ -0,0 +1,162 @@
+/*=====================================================================
+histogram.h
+-----------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+
+#pragma once
+#ifndef __HISTOGRAM_H_666_
+#define __HISTOGRAM_H_666_
+
+#include <string>
+#include <sstream>
+#include <string.h>
+
+/*=====================================================================
+LogHistogram
+------------
+Histogram of unsigned values with logarithmically sized buckets:
+each power of two is split into 4 buckets, so a bucket's bounds are
+within 25% of each other, and any 64-bit value fits in 256 buckets.
+Recording a value is a few instructions and never allocates.
+=====================================================================*/
+class LogHistogram
+{
+public:
+	enum { SUB_BITS = 2, SUB_BUCKETS = 1 << SUB_BITS, NUM_BUCKETS = 64 * SUB_BUCKETS };
+
+	LogHistogram() { clear(); }
+
+	void clear()
+	{
+		memset(buckets, 0, sizeof(buckets));
+		count = 0;
+		max = 0;
+	}
+
+	void add(unsigned long long value)
+	{
+		buckets[bucketFor(value)]++;
+		count++;
+		if (value > max)
+			max = value;
+	}
+
+	void merge(const LogHistogram &other)
+	{
+		for (int n=0;n<NUM_BUCKETS;n++)
+			buckets[n] += other.buckets[n];
+		count += other.count;
+		if (other.max > max)
+			max = other.max;
+	}
+
+	unsigned long long getCount() const { return count; }
+	unsigned long long getMax() const { return max; }
+
+	/// Upper bound of the bucket holding the given fraction (0..1) of the values.
+	unsigned long long percentile(double fraction) const
+	{
+		if (count == 0)
+			return 0;
+
+		unsigned long long rank = (unsigned long long)(fraction * count);
+		if (rank >= count)
+			rank = count - 1;
+
+		unsigned long long seen = 0;
+		for (int n=0;n<NUM_BUCKETS;n++)
+		{
+			seen += buckets[n];
+			if (seen > rank)
+			{
+				unsigned long long upper = bucketUpperBound(n);
+				return upper < max ? upper : max;
+			}
+		}
+		return max;
+	}
+
+	/// Writes "count max index:n index:n ...", listing only non-empty buckets.
+	std::wstring toString() const
+	{
+		std::wostringstream stream;
+		stream << count << ' ' << max;
+		for (int n=0;n<NUM_BUCKETS;n++)
+			if (buckets[n])
+				stream << ' ' << n << ':' << buckets[n];
+		return stream.str();
+	}
+
+	/// Reads what toString wrote. Returns false on malformed input.
+	bool fromString(const std::wstring &s)
+	{
+		clear();
+
+		std::wistringstream stream(s);
+		if (!(stream >> count >> max))
+			return false;
+
+		int index;
+		wchar_t colon;
+		unsigned long long n;
+		while (stream >> index >> colon >> n)
+		{
+			if (index < 0 || index >= NUM_BUCKETS || colon != ':')
+				return false;
+			buckets[index] = n;
+		}
+		return stream.eof();
+	}
+
+private:
+	unsigned long long buckets[NUM_BUCKETS];
+	unsigned long long count;
+	unsigned long long max;
+
+	static int highestBit(unsigned long long value)
+	{
+		int bit = 0;
+		while (value >>= 1)
+			bit++;
+		return bit;
+	}
+
+	static int bucketFor(unsigned long long value)
+	{
+		if (value < SUB_BUCKETS)
+			return (int)value;
+
+		int bit = highestBit(value);
+		int sub = (int)(value >> (bit - SUB_BITS)) & (SUB_BUCKETS - 1);
+		return (bit - SUB_BITS + 1) * SUB_BUCKETS + sub;
+	}
+
+	static unsigned long long bucketUpperBound(int index)
+	{
+		if (index < SUB_BUCKETS)
+			return index;
+
+		int bit = index / SUB_BUCKETS + SUB_BITS - 1;
+		int sub = index % SUB_BUCKETS;
+		unsigned long long lower = (unsigned long long)(SUB_BUCKETS + sub) << (bit - SUB_BITS);
+		return lower + ((1ULL << (bit - SUB_BITS)) - 1);
+	}
+};
+
+#endif //__HISTOGRAM_H_666_
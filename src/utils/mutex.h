@@ -0,0 +1,65 @@
+/*=====================================================================
+mutex.h
+-------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+#ifndef __MUTEX_H_666_
+#define __MUTEX_H_666_
+
+#include <windows.h>
+
+/*=====================================================================
+Mutex
+-----
+Thin wrapper around a critical section.
+=====================================================================*/
+class Mutex
+{
+public:
+	Mutex() { InitializeCriticalSection(&cs); }
+	~Mutex() { DeleteCriticalSection(&cs); }
+
+	void acquire() { EnterCriticalSection(&cs); }
+	void release() { LeaveCriticalSection(&cs); }
+
+private:
+	Mutex(const Mutex&);
+	Mutex& operator=(const Mutex&);
+
+	CRITICAL_SECTION cs;
+};
+
+/*=====================================================================
+Lock
+----
+Holds a Mutex for the lifetime of the Lock.
+=====================================================================*/
+class Lock
+{
+public:
+	Lock(Mutex& mutex_) : mutex(mutex_) { mutex.acquire(); }
+	~Lock() { mutex.release(); }
+
+private:
+	Lock(const Lock&);
+	Lock& operator=(const Lock&);
+
+	Mutex& mutex;
+};
+
+#endif //__MUTEX_H_666_
@@ -0,0 +1,288 @@
+/*=====================================================================
+textscanner.cpp
+---------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+
+#include "textscanner.h"
+#include "stringutils.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define TEXTSCANNER_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TEXTSCANNER_BSWAP64 _byteswap_uint64
+#else
+#define TEXTSCANNER_BSWAP64 __builtin_bswap64
+#endif
+#endif
+
+static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+static int hexDigit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	c |= 0x20;
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+// The value of the hex digits at p, and how many there are (0 to 16).
+static unsigned long long parseHexDigits(const char *p, const char *end, size_t &numDigits)
+{
+#if defined(TEXTSCANNER_SSE2)
+	if (end - p >= 16)
+	{
+		// Sixteen characters at once: a nibble for each, and a mask of
+		// which were digits at all.
+		__m128i c = _mm_loadu_si128((const __m128i *)p);
+		__m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+		__m128i dec = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+		__m128i alpha = _mm_sub_epi8(lower, _mm_set1_epi8('a'));
+		// Unsigned compares, by way of flipping the sign bit.
+		__m128i bias = _mm_set1_epi8((char)0x80);
+		__m128i isDec = _mm_cmplt_epi8(_mm_xor_si128(dec, bias), _mm_set1_epi8((char)(0x80 + 10)));
+		__m128i isAlpha = _mm_cmplt_epi8(_mm_xor_si128(alpha, bias), _mm_set1_epi8((char)(0x80 + 6)));
+
+		unsigned valid = (unsigned)_mm_movemask_epi8(_mm_or_si128(isDec, isAlpha));
+		numDigits = 0;
+		while (numDigits < 16 && (valid & (1u << numDigits)))
+			numDigits++;
+		if (numDigits == 0)
+			return 0;
+
+		__m128i nibbles = _mm_or_si128(_mm_and_si128(isDec, dec),
+			_mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+
+		// Pairs of nibbles into bytes, most significant digit first.
+		__m128i pairs = _mm_or_si128(_mm_slli_epi16(nibbles, 4), _mm_srli_epi16(nibbles, 8));
+		pairs = _mm_and_si128(pairs, _mm_set1_epi16(0xFF));
+		__m128i bytes = _mm_packus_epi16(pairs, pairs);
+
+		unsigned long long value;
+		_mm_storel_epi64((__m128i *)&value, bytes);
+		value = TEXTSCANNER_BSWAP64(value);
+		// Whatever followed the digits is in the low nibbles.
+		return numDigits == 16 ? value : value >> (4 * (16 - numDigits));
+	}
+#endif
+
+	unsigned long long value = 0;
+	numDigits = 0;
+	for (int digit; numDigits < 16 && p + numDigits != end && (digit = hexDigit(p[numDigits])) >= 0; numDigits++)
+		value = (value << 4) | (unsigned)digit;
+	return value;
+}
+
+TextScanner::TextScanner(const unsigned char *data, size_t size)
+:	start((const char *)data),
+	end((const char *)data + size)
+{
+	// wxConvAuto skipped a byte order mark; so do we.
+	if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+		start += 3;
+	line_begin = line_end = pos = next = start;
+}
+
+bool TextScanner::nextLine()
+{
+	if (next == end)
+		return false;
+
+	line_begin = pos = next;
+	const char *newline = (const char *)memchr(pos, '\n', end - pos);
+	next = newline ? newline + 1 : end;
+	line_end = newline ? newline : end;
+	if (line_end != pos && line_end[-1] == '\r')
+		line_end--;
+	return line_end != pos;
+}
+
+void TextScanner::skipSpaces()
+{
+	while (pos != line_end && isSpace(*pos))
+		pos++;
+}
+
+bool TextScanner::atLineEnd()
+{
+	skipSpaces();
+	return pos == line_end;
+}
+
+void TextScanner::token(const char *&begin, const char *&tokenEnd)
+{
+	skipSpaces();
+	begin = pos;
+	while (pos != line_end && !isSpace(*pos))
+		pos++;
+	tokenEnd = pos;
+}
+
+bool TextScanner::readHex(unsigned long long &value)
+{
+	skipSpaces();
+	if (line_end - pos < 3 || pos[0] != '0' || pos[1] != 'x')
+		return false;
+
+	size_t numDigits;
+	// The line ends in a character that isn't a digit, so the digits can be
+	// looked for up to the end of the buffer.
+	value = parseHexDigits(pos + 2, end, numDigits);
+	const char *after = pos + 2 + numDigits;
+	if (numDigits == 0 || (after != line_end && !isSpace(*after)))
+		return false;
+	pos = after;
+	return true;
+}
+
+bool TextScanner::readUnsigned(unsigned &value)
+{
+	const char *begin, *tokenEnd;
+	token(begin, tokenEnd);
+	if (begin == tokenEnd)
+		return false;
+
+	value = 0;
+	for (const char *p = begin; p != tokenEnd; p++)
+	{
+		if (*p < '0' || *p > '9')
+			return false;
+		value = value * 10 + (*p - '0');
+	}
+	return true;
+}
+
+bool TextScanner::readDouble(double &value)
+{
+	const char *begin, *tokenEnd;
+	token(begin, tokenEnd);
+
+	// strtod wants a terminator, which the buffer doesn't have.
+	char buf[64];
+	size_t size = tokenEnd - begin;
+	if (size == 0 || size >= sizeof(buf))
+		return false;
+	memcpy(buf, begin, size);
+	buf[size] = 0;
+
+	char *parsed;
+	value = strtod(buf, &parsed);
+	return parsed == buf + size;
+}
+
+bool TextScanner::readQuoted(const char *&begin, const char *&quotedEnd)
+{
+	skipSpaces();
+	if (pos == line_end || *pos != '"')
+		return false;
+
+	begin = ++pos;
+	for (; pos != line_end; pos++)
+	{
+		if (*pos == '\\')
+		{
+			if (++pos == line_end)
+				break;
+		}
+		else if (*pos == '"')
+		{
+			quotedEnd = pos++;
+			return true;
+		}
+	}
+	return false;
+}
+
+// FNV-1a
+static size_t hashName(const char *name, size_t size)
+{
+	size_t hash = 2166136261u;
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+	return hash;
+}
+
+NameTable::NameTable()
+{
+	Slot empty = { NULL, 0, 0 };
+	slots.assign(1024, empty);
+}
+
+const std::wstring &NameTable::get(const char *begin, const char *end)
+{
+	size_t size = end - begin;
+	size_t hash = hashName(begin, size);
+
+	size_t mask = slots.size() - 1;
+	for (size_t i = hash & mask; ; i = (i + 1) & mask)
+	{
+		Slot &slot = slots[i];
+		if (!slot.begin)
+			break;
+		if (slot.size == size && memcmp(slot.begin, begin, size) == 0)
+			return names[slot.name];
+	}
+
+	scratch.clear();
+	for (const char *p = begin; p != end; p++)
+	{
+		if (*p == '\\' && p + 1 != end)
+			p++;
+		scratch.push_back(*p);
+	}
+	names.push_back(fromUtf8(scratch));
+
+	if ((names.size() + 1) * 2 > slots.size())
+		grow();
+	for (size_t i = hash & (slots.size() - 1); ; i = (i + 1) & (slots.size() - 1))
+	{
+		if (!slots[i].begin)
+		{
+			Slot slot = { begin, size, names.size() - 1 };
+			slots[i] = slot;
+			break;
+		}
+	}
+	return names.back();
+}
+
+void NameTable::grow()
+{
+	std::vector<Slot> old;
+	old.swap(slots);
+	Slot empty = { NULL, 0, 0 };
+	slots.assign(old.size() * 2, empty);
+
+	size_t mask = slots.size() - 1;
+	for (size_t n = 0; n < old.size(); n++)
+	{
+		if (!old[n].begin)
+			continue;
+
+		size_t i = hashName(old[n].begin, old[n].size) & mask;
+		while (slots[i].begin)
+			i = (i + 1) & mask;
+		slots[i] = old[n];
+	}
+}
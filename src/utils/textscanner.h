@@ -0,0 +1,108 @@
+/*=====================================================================
+textscanner.h
+-------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+
+#pragma once
+#ifndef __TEXTSCANNER_H_666_
+#define __TEXTSCANNER_H_666_
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/*=====================================================================
+TextScanner
+-----------
+Reads the text entries of capture files (Symbols.txt, Callstacks.txt
+and so on) in place, from the UTF-8 buffer they were inflated into:
+a line at a time, and within a line, a space-separated token at a
+time. Nothing is copied or allocated; quoted strings come back as the
+span between the quotes, escapes and all, for a NameTable to convert.
+
+Like the streams it replaces, it stops at the first empty line.
+=====================================================================*/
+class TextScanner
+{
+public:
+	TextScanner(const unsigned char *data, size_t size);
+
+	/// Move to the next line. Returns false at the end, or an empty line.
+	bool nextLine();
+
+	/// Whether the rest of the current line is blank.
+	bool atLineEnd();
+
+	/// A "0x" hexadecimal number, of up to 16 digits.
+	bool readHex(unsigned long long &value);
+	bool readUnsigned(unsigned &value);
+	bool readDouble(double &value);
+
+	/// A string between double quotes, with any backslash escapes left in.
+	bool readQuoted(const char *&begin, const char *&end);
+
+	/// The current line, for error messages.
+	std::string getLine() const { return std::string(line_begin, line_end); }
+
+	/// How far through the buffer the next line starts.
+	size_t getOffset() const { return (size_t)(next - start); }
+
+private:
+	const char *start, *end;
+	const char *line_begin, *line_end; ///< the current line, without its "\r\n"
+	const char *pos;
+	const char *next;
+
+	void skipSpaces();
+	/// The token at pos; empty at the end of the line.
+	void token(const char *&begin, const char *&end);
+};
+
+/*=====================================================================
+NameTable
+---------
+Wide copies of the quoted names in a TextScanner's buffer, made once
+per distinct name, however many lines repeat it. The spans given must
+stay valid for as long as the table is used.
+=====================================================================*/
+class NameTable
+{
+public:
+	NameTable();
+
+	/// The name between begin and end, unescaped and converted from UTF-8.
+	/// Valid until the next call.
+	const std::wstring &get(const char *begin, const char *end);
+
+private:
+	struct Slot
+	{
+		const char *begin;
+		size_t size;
+		size_t name; ///< into names
+	};
+
+	std::vector<Slot> slots;
+	std::vector<std::wstring> names;
+	std::string scratch;
+
+	void grow();
+};
+
+#endif //__TEXTSCANNER_H_666_
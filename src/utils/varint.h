@@ -0,0 +1,69 @@
+/*=====================================================================
+varint.h
+--------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+
+#pragma once
+#ifndef __VARINT_H_666_
+#define __VARINT_H_666_
+
+#include <vector>
+
+// Variable-length integers for the binary parts of capture files:
+// 7 bits per byte, least significant first, high bit set on all but the last byte.
+// Signed values are zigzag-encoded first, so that small negatives stay short.
+
+inline void writeVarint(std::vector<unsigned char> &out, unsigned long long value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back((unsigned char)(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((unsigned char)value);
+}
+
+/// Reads a value written by writeVarint, advancing pos.
+/// Returns false if the data ends early or the value is too long.
+inline bool readVarint(const unsigned char *&pos, const unsigned char *end, unsigned long long &value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		if (pos == end)
+			return false;
+		unsigned char byte = *pos++;
+		value |= (unsigned long long)(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+inline unsigned long long zigzagEncode(long long value)
+{
+	return ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63);
+}
+
+inline long long zigzagDecode(unsigned long long value)
+{
+	return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+#endif //__VARINT_H_666_
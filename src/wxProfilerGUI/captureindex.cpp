@@ -0,0 +1,260 @@
+/*=====================================================================
+captureindex.cpp
+----------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "captureindex.h"
+#include "profilergui.h"
+#include "../utils/osutils.h"
+#include <wx/filename.h>
+#include <wx/file.h>
+#include <string.h>
+
+// Bump when the layout changes; files of other versions are ignored, and
+// replaced when the capture is next opened.
+static const unsigned INDEX_VERSION = 1;
+static const char INDEX_MAGIC[4] = { 'S', 'I', 'D', 'X' };
+
+// Columns start on a page, so that each maps as an array of its own.
+static const unsigned long long COLUMN_ALIGNMENT = 4096;
+
+static const size_t recordSizes[] = {
+	sizeof(unsigned),                     // STRING_OFFSETS
+	sizeof(wchar_t),                      // CHARS
+	sizeof(unsigned),                     // FILES
+	sizeof(unsigned),                     // MODULES
+	sizeof(CaptureIndex::SymbolRecord),   // SYMBOLS
+	sizeof(CaptureIndex::AddrRecord),     // ADDRS
+	sizeof(CaptureIndex::StackRecord),    // STACKS
+	sizeof(unsigned),                     // FRAMES
+	sizeof(unsigned),                     // THREADS
+	sizeof(CaptureIndex::SampleRecord),   // SAMPLES
+};
+
+template <class T>
+static void setColumn(const void *&data, size_t &count, const std::vector<T> &records)
+{
+	data = records.empty() ? NULL : &records[0];
+	count = records.size();
+}
+
+unsigned CaptureIndex::Tables::addString(const std::wstring &s)
+{
+	chars.insert(chars.end(), s.begin(), s.end());
+	string_offsets.push_back((unsigned)chars.size());
+	return (unsigned)string_offsets.size() - 2;
+}
+
+CaptureIndex::CaptureIndex()
+:	mapping(NULL),
+	mapping_size(0),
+	header(NULL)
+{
+}
+
+CaptureIndex::~CaptureIndex()
+{
+	unmap();
+}
+
+bool CaptureIndex::getCaptureStamp(const std::wstring &capture_path, unsigned long long &size, unsigned long long &time)
+{
+	wxFileName name(capture_path);
+	wxULongLong file_size = name.GetSize();
+	wxDateTime modified = name.GetModificationTime();
+	if (file_size == wxInvalidSize || !modified.IsValid())
+		return false;
+
+	size = file_size.GetValue();
+	time = (unsigned long long)modified.GetValue().GetValue();
+	return true;
+}
+
+bool CaptureIndex::map(const std::wstring &capture_path, unsigned options)
+{
+	unmap();
+
+	unsigned long long capture_size, capture_time;
+	if (!getCaptureStamp(capture_path, capture_size, capture_time))
+		return false;
+
+	mapping = MapWholeFile(getIndexPath(capture_path), mapping_size, (size_t)-1);
+	if (!mapping)
+		return false;
+
+	const Header *h = (const Header *)mapping;
+	if (mapping_size < sizeof(Header) ||
+		memcmp(h->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+		h->version != INDEX_VERSION ||
+		h->char_size != sizeof(wchar_t) ||
+		h->options != options ||
+		h->capture_size != capture_size ||
+		h->capture_time != capture_time)
+	{
+		unmap();
+		return false;
+	}
+
+	for (int i = 0; i < NUM_SECTIONS; i++)
+	{
+		const SectionRecord &section = h->sections[i];
+		if (section.offset % COLUMN_ALIGNMENT != 0 || section.offset > mapping_size ||
+			section.count > (mapping_size - section.offset) / recordSizes[i])
+		{
+			unmap();
+			return false;
+		}
+	}
+
+	header = h;
+	if (!check())
+	{
+		unmap();
+		return false;
+	}
+	return true;
+}
+
+// Every reference from one column into another is in range, so that
+// the Database can follow them without checking.
+bool CaptureIndex::check() const
+{
+	if (header->sections[STRING_OFFSETS].count == 0)
+		return false;
+
+	const unsigned *offsets = (const unsigned *)column(STRING_OFFSETS);
+	size_t numStrings = getNumStrings();
+	if (offsets[0] != 0)
+		return false;
+	for (size_t i = 0; i < numStrings; i++)
+		if (offsets[i + 1] < offsets[i])
+			return false;
+	if (offsets[numStrings] > header->sections[CHARS].count)
+		return false;
+
+	const unsigned *files = getFiles(), *modules = getModules();
+	for (size_t i = 0; i < getNumFiles(); i++)
+		if (files[i] >= numStrings)
+			return false;
+	for (size_t i = 0; i < getNumModules(); i++)
+		if (modules[i] >= numStrings)
+			return false;
+
+	const SymbolRecord *symbols = getSymbols();
+	for (size_t i = 0; i < getNumSymbols(); i++)
+		if (symbols[i].proc >= numStrings || symbols[i].file >= getNumFiles() || symbols[i].module >= getNumModules())
+			return false;
+
+	const AddrRecord *addrs = getAddrs();
+	for (size_t i = 0; i < getNumAddrs(); i++)
+		if (addrs[i].symbol >= getNumSymbols() || (i > 0 && addrs[i].addr <= addrs[i - 1].addr))
+			return false;
+
+	const StackRecord *stacks = getStacks();
+	unsigned long long numFrames = header->sections[FRAMES].count;
+	for (size_t i = 0; i < getNumStacks(); i++)
+		if (stacks[i].first_frame > numFrames || stacks[i].num_frames > numFrames - stacks[i].first_frame)
+			return false;
+
+	const unsigned *frames = getFrames();
+	for (unsigned long long i = 0; i < numFrames; i++)
+		if (frames[i] >= getNumAddrs())
+			return false;
+
+	return true;
+}
+
+void CaptureIndex::unmap()
+{
+	if (mapping)
+		UnmapWholeFile(mapping);
+	mapping = NULL;
+	mapping_size = 0;
+	header = NULL;
+}
+
+std::wstring CaptureIndex::getString(unsigned id) const
+{
+	const unsigned *offsets = (const unsigned *)column(STRING_OFFSETS);
+	const wchar_t *chars = (const wchar_t *)column(CHARS);
+	return std::wstring(chars + offsets[id], chars + offsets[id + 1]);
+}
+
+bool CaptureIndex::save(const std::wstring &capture_path, unsigned options, const Tables &tables)
+{
+	Header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+	h.version = INDEX_VERSION;
+	h.char_size = sizeof(wchar_t);
+	h.options = options;
+	if (!getCaptureStamp(capture_path, h.capture_size, h.capture_time))
+		return false;
+
+	const void *data[NUM_SECTIONS];
+	size_t counts[NUM_SECTIONS];
+	setColumn(data[STRING_OFFSETS], counts[STRING_OFFSETS], tables.string_offsets);
+	setColumn(data[CHARS],          counts[CHARS],          tables.chars);
+	setColumn(data[FILES],          counts[FILES],          tables.files);
+	setColumn(data[MODULES],        counts[MODULES],        tables.modules);
+	setColumn(data[SYMBOLS],        counts[SYMBOLS],        tables.symbols);
+	setColumn(data[ADDRS],          counts[ADDRS],          tables.addrs);
+	setColumn(data[STACKS],         counts[STACKS],         tables.stacks);
+	setColumn(data[FRAMES],         counts[FRAMES],         tables.frames);
+	setColumn(data[THREADS],        counts[THREADS],        tables.threads);
+	setColumn(data[SAMPLES],        counts[SAMPLES],        tables.samples);
+
+	unsigned long long offset = COLUMN_ALIGNMENT;
+	for (int i = 0; i < NUM_SECTIONS; i++)
+	{
+		h.sections[i].offset = offset;
+		h.sections[i].count = counts[i];
+		offset += (counts[i] * recordSizes[i] + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+	}
+
+	// Another Sleepy may have the old index mapped; see MoveFileOver.
+	std::wstring path = getIndexPath(capture_path);
+	std::wstring tmppath = path + L".tmp";
+	bool ok;
+	{
+		wxFile out;
+		ok = out.Create(tmppath, true);
+		ok = ok && out.Write(&h, sizeof(h)) == sizeof(h);
+		for (int i = 0; ok && i < NUM_SECTIONS; i++)
+		{
+			ok = out.Seek((wxFileOffset)h.sections[i].offset) != wxInvalidOffset;
+			if (ok && counts[i])
+				ok = out.Write(data[i], counts[i] * recordSizes[i]) == counts[i] * recordSizes[i];
+		}
+		// Pad out to the end of the last page, where empty columns start.
+		if (ok && out.Length() < (wxFileOffset)offset)
+		{
+			char zero = 0;
+			ok = out.Seek((wxFileOffset)offset - 1) != wxInvalidOffset && out.Write(&zero, 1) == 1;
+		}
+		ok = out.Close() && ok;
+	}
+
+	if (!ok || !MoveFileOver(tmppath, path))
+	{
+		wxRemoveFile(tmppath);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,183 @@
+/*=====================================================================
+captureindex.h
+--------------
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+#ifndef __CAPTUREINDEX_H_666_
+#define __CAPTUREINDEX_H_666_
+
+#include <string>
+#include <vector>
+
+/*=====================================================================
+CaptureIndex
+------------
+What the Database made of a capture the last time it was opened, kept
+beside it (as "<capture>.index") so that opening it again needn't
+inflate, parse, demangle and group everything afresh.
+
+The file is memory mapped and read in place. After a header come
+columns of fixed-size records, each starting on a page boundary: the
+strings (offsets, then the characters, as wchar_t), the file and
+module names, the symbols, the addresses in order with their symbol,
+line and IP count, the callstacks as saved (inlined functions expanded,
+nothing collapsed) with their frames as indices into the addresses,
+and the sample log.
+
+An index is only used for the capture it was made from: the header
+records the capture's size and modification time, and the options the
+symbols depend on. Anything else is treated as no index at all.
+=====================================================================*/
+class CaptureIndex
+{
+public:
+	/// Options the tables depend on.
+	enum
+	{
+		GROUP_TEMPLATES  = 1,
+		MINIDUMP_SYMBOLS = 2
+	};
+
+	struct SymbolRecord
+	{
+		unsigned long long address;
+		unsigned proc;   ///< a string
+		unsigned file;   ///< into the files
+		unsigned module; ///< into the modules
+		unsigned pad;
+	};
+	struct AddrRecord
+	{
+		unsigned long long addr;
+		unsigned symbol;
+		unsigned line;
+		double count;
+		float percentage;
+		unsigned pad;
+	};
+	struct StackRecord
+	{
+		double samplecount;
+		unsigned first_frame, num_frames; ///< a run of the frames
+	};
+	struct SampleRecord
+	{
+		double time, weight;
+		unsigned thread;
+		unsigned stack;  ///< into the stacks
+	};
+
+	/// What's written, gathered by the Database.
+	struct Tables
+	{
+		Tables() { string_offsets.push_back(0); }
+
+		/// Returns the new string's ID.
+		unsigned addString(const std::wstring &s);
+
+		std::vector<unsigned> string_offsets;
+		std::vector<wchar_t> chars;
+		std::vector<unsigned> files, modules; ///< strings
+		std::vector<SymbolRecord> symbols;
+		std::vector<AddrRecord> addrs;
+		std::vector<StackRecord> stacks;
+		std::vector<unsigned> frames;         ///< into addrs
+		std::vector<unsigned> threads;
+		std::vector<SampleRecord> samples;
+	};
+
+	CaptureIndex();
+	~CaptureIndex();
+
+	/// Map capture_path's index, if it was made from the capture as it is
+	/// now, with the same options. Returns false if there's none to use.
+	bool map(const std::wstring &capture_path, unsigned options);
+	void unmap();
+
+	/// Write capture_path's index afresh. Returns false on failure.
+	static bool save(const std::wstring &capture_path, unsigned options, const Tables &tables);
+
+	// The mapped columns; all checked to refer only to each other.
+	size_t getNumStrings() const { return (size_t)header->sections[STRING_OFFSETS].count - 1; }
+	std::wstring getString(unsigned id) const;
+
+	size_t getNumFiles()   const { return (size_t)header->sections[FILES].count; }
+	size_t getNumModules() const { return (size_t)header->sections[MODULES].count; }
+	size_t getNumSymbols() const { return (size_t)header->sections[SYMBOLS].count; }
+	size_t getNumAddrs()   const { return (size_t)header->sections[ADDRS].count; }
+	size_t getNumStacks()  const { return (size_t)header->sections[STACKS].count; }
+	size_t getNumThreads() const { return (size_t)header->sections[THREADS].count; }
+	size_t getNumSamples() const { return (size_t)header->sections[SAMPLES].count; }
+
+	const unsigned     *getFiles()   const { return (const unsigned *)column(FILES); }
+	const unsigned     *getModules() const { return (const unsigned *)column(MODULES); }
+	const SymbolRecord *getSymbols() const { return (const SymbolRecord *)column(SYMBOLS); }
+	const AddrRecord   *getAddrs()   const { return (const AddrRecord *)column(ADDRS); }
+	const StackRecord  *getStacks()  const { return (const StackRecord *)column(STACKS); }
+	const unsigned     *getFrames()  const { return (const unsigned *)column(FRAMES); }
+	const unsigned     *getThreads() const { return (const unsigned *)column(THREADS); }
+	const SampleRecord *getSamples() const { return (const SampleRecord *)column(SAMPLES); }
+
+private:
+	enum Section
+	{
+		STRING_OFFSETS,
+		CHARS,
+		FILES,
+		MODULES,
+		SYMBOLS,
+		ADDRS,
+		STACKS,
+		FRAMES,
+		THREADS,
+		SAMPLES,
+		NUM_SECTIONS
+	};
+
+	struct SectionRecord
+	{
+		unsigned long long offset, count;
+	};
+	struct Header
+	{
+		char magic[4];
+		unsigned version;
+		unsigned char_size;
+		unsigned options;
+		unsigned long long capture_size;
+		unsigned long long capture_time;
+		SectionRecord sections[NUM_SECTIONS];
+	};
+
+	void *mapping;
+	size_t mapping_size;
+	const Header *header;
+
+	const void *column(Section section) const { return (const char *)mapping + header->sections[section].offset; }
+	bool check() const;
+
+	static std::wstring getIndexPath(const std::wstring &capture_path) { return capture_path + L".index"; }
+	static bool getCaptureStamp(const std::wstring &capture_path, unsigned long long &size, unsigned long long &time);
+
+	CaptureIndex(const CaptureIndex &);
+	CaptureIndex &operator=(const CaptureIndex &);
+};
+
+#endif //__CAPTUREINDEX_H_666_
@@ -1,583 +1,1314 @@
-/*=====================================================================
-Database.cpp
-------------
-
-Copyright (C) Nicholas Chapman
-Copyright (C) Richard Mitton
-Copyright (C) 2015 Ashod Nakashian
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html.
-=====================================================================*/
-#include "database.h"
-
-#include "../utils/stringutils.h"
-#include "sourceview.h"
-#include <wx/mstream.h>
-#include <fstream>
-#include <set>
-#include "mainwin.h"
-#include "../profiler/symbolinfo.h"
-#include <algorithm>
-#include "../appinfo.h"
-#include "../utils/except.h"
-#include "latesymbolinfo.h"
-
-Database *theDatabase;
-
-StringSet osModules(L"osmodules.txt",false);
-StringSet osFunctions(L"osfunctions.txt",true);
-
-bool IsOsFunction(wxString proc)
-{
-	return osFunctions.Contains(proc);
-}
-
-void AddOsFunction(wxString proc)
-{
-	osFunctions.Add(proc);
-	theMainWin->reload();
-}
-
-void RemoveOsFunction(wxString proc)
-{
-	osFunctions.Remove(proc);
-	theMainWin->reload();
-}
-
-bool IsOsModule(wxString mod)
-{
-	return osModules.Contains(mod);
-}
-
-void AddOsModule(wxString mod)
-{
-	osModules.Add(mod);
-	theMainWin->reload();
-}
-
-void RemoveOsModule(wxString mod)
-{
-	osModules.Remove(mod);
-	theMainWin->reload();
-}
-
-Database::Database()
-{
-	assert(!theDatabase);
-	theDatabase = this;
-	late_sym_info = new LateSymbolInfo();
-}
-
-Database::~Database()
-{
-	clear();
-	delete late_sym_info;
-}
-
-void Database::clear()
-{
-	for (auto i = symbols.begin(); i != symbols.end(); ++i)
-		if (*i)
-			delete *i;
-
-	symbols.clear();
-	files.clear();
-	filemap.clear();
-	addrinfo.clear();
-	callstacks.clear();
-	mainList.items.clear();
-	mainList.totalcount = 0;
-	has_minidump = false;
-}
-
-void Database::reload(bool collapseOSCalls, bool loadMinidump)
-{
-	loadFromPath(profilepath, collapseOSCalls, loadMinidump);
-}
-
-void Database::loadFromPath(const std::wstring& _profilepath, bool collapseOSCalls, bool loadMinidump)
-{
-	if(_profilepath != profilepath)
-		profilepath = _profilepath;
-	clear();
-
-	wxFFileInputStream input(profilepath);
-	enforce(input.IsOk(), "Input stream error opening profile data.");
-
-	// Check the version number required.
-	{
-		wxZipInputStream zipver(input);
-		enforce(zipver.IsOk(), "ZIP error opening profile data.");
-
-		bool versionFound = false;
-		while (wxZipEntry *entry = zipver.GetNextEntry())
-		{
-			wxString name = entry->GetInternalName();
-
-			if (name.Left(8) == "Version " && name.Right(9) == " required")
-			{
-				versionFound = true;
-				wxString ver = name.Mid(8, name.Length()-(8+9));
-				enforce(ver == FORMAT_VERSION, wxString::Format("Cannot load capture file: %s", name.c_str()).c_str());
-			}
-		}
-
-		enforce(versionFound, "Unrecognized capture file");
-	}
-
-	wxZipInputStream zip(input);
-	enforce(zip.IsOk(), "ZIP error opening profile data.");
-
-	while (wxZipEntry *entry = zip.GetNextEntry())
-	{
-		wxString name = entry->GetInternalName();
-
-			 if (name == "Symbols.txt")		loadSymbols(zip);
-		else if (name == "Callstacks.txt")	loadCallstacks(zip,collapseOSCalls);
-		else if (name == "IPCounts.txt")	loadIpCounts(zip);
-		else if (name == "Stats.txt")		loadStats(zip);
-		else if (name == "minidump.dmp")	{ has_minidump = true; if(loadMinidump) this->loadMinidump(zip); }
-		else if (name.Left(8) == "Version ") {}
-		else
-			wxLogWarning("Other fluff found in capture file (%s)\n", name.c_str());
-	}
-
-	setRoot(NULL);
-}
-
-// Windows progress bar is limited to 0x10000 max.
-static const __int64 kMaxProgress = 0x8000LL;
-
-// read symbol table
-void Database::loadSymbols(wxInputStream &file)
-{
-	wxTextInputStream str(file, wxT(" \t"), wxConvAuto(wxFONTENCODING_UTF8));
-
-	size_t filesize = file.GetSize();
-	wxProgressDialog progressdlg(APPNAME, "Loading symbols...",
-		kMaxProgress+1, theMainWin,
-		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
-
-	std::unordered_map<std::wstring, const Symbol*> locsymbols;
-
-	bool warnedDupAddress = false;
-	while (!file.Eof())
-	{
-		wxString line = str.ReadLine();
-		if (line.IsEmpty())
-			break;
-
-		std::wistringstream stream(line.c_str().AsWChar());
-
-		std::wstring addrstr;
-		stream >> addrstr;
-		Address addr = hexStringTo64UInt(addrstr);
-
-		std::wstring sourcefilename, modulename, procname;
-
-		bool inserted;
-		AddrInfo &info = map_emplace(addrinfo, addr, &inserted);
-		::readQuote(stream, modulename);
-		::readQuote(stream, procname);
-		::readQuote(stream, sourcefilename);
-		stream >> info.sourceline;
-		if (!inserted)
-		{
-			if (!warnedDupAddress)
-				wxLogWarning("Duplicate address in symbol list:\nAddress: " + addrstr + "\nSymbol: " + procname);
-			warnedDupAddress = true;
-			continue;
-		}
-		enforce(stream.eof(), "Trailing data in line: " + line);
-
-		// Late symbol lookup
-		late_sym_info->filterSymbol(addr, modulename, procname, sourcefilename, info.sourceline);
-
-		// Convert filename and module strings to a numeric IDs
-		FileID   fileid   = map_string(files  , filemap  , sourcefilename);
-		ModuleID moduleid = map_string(modules, modulemap, modulename    );
-
-		// Build a key string for grouping addresses belonging to the same symbol
-		std::wostringstream locstream;
-		locstream << modulename << '/' << sourcefilename << '/' << procname;
-		std::wstring loc = locstream.str();
-
-		// Create a new symbol entry, or lookup the existing one, based on the key
-		const Symbol *&sym = map_emplace(locsymbols, loc, &inserted);
-		if (inserted) // new symbol, judging by its location?
-		{
-			Symbol *newsym = new Symbol;
-			newsym->id                 = symbols.size();
-			newsym->address            = addr;
-			newsym->procname           = procname;
-			newsym->sourcefile         = fileid;
-			newsym->module             = moduleid;
-			newsym->isCollapseFunction = osFunctions.Contains(procname  .c_str());
-			newsym->isCollapseModule   = osModules  .Contains(modulename.c_str());
-			symbols.push_back(newsym);
-			sym = newsym;
-		}
-
-		info.symbol = sym;
-
-		wxFileOffset offset = file.TellI();
-		if (offset != wxInvalidOffset && offset != (wxFileOffset)filesize)
-			progressdlg.Update(kMaxProgress * offset / filesize);
-	}
-
-	// The unordered_map destructor takes a very long time to run.
-	progressdlg.Update(kMaxProgress, "Tidying things up...");
-}
-
-// read callstacks
-void Database::loadCallstacks(wxInputStream &file,bool collapseKernelCalls)
-{
-	wxTextInputStream str(file);
-
-	size_t filesize = file.GetSize();
-	wxProgressDialog progressdlg(APPNAME, "Loading callstacks...",
-		kMaxProgress, theMainWin,
-		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
-
-	while (!file.Eof())
-	{
-		wxString line = str.ReadLine();
-		if (line.IsEmpty())
-			break;
-
-		std::wistringstream stream(line.c_str().AsWChar());
-
-		CallStack callstack;
-		stream >> callstack.samplecount;
-
-		while (true)
-		{
-			std::wstring addrstr;
-			stream >> addrstr;
-			if (addrstr.empty())
-				break;
-			Address addr = hexStringTo64UInt(addrstr);
-
-			if (collapseKernelCalls && addrinfo.at(addr).symbol->isCollapseFunction)
-				callstack.addresses.clear();
-
-			callstack.addresses.push_back(addr);
-		}
-
-		if (collapseKernelCalls)
-		{
-			if (callstack.addresses.size() >= 2 && addrinfo.at(callstack.addresses[0]).symbol->isCollapseModule)
-			{
-				do
-				{
-					if (!addrinfo.at(callstack.addresses[1]).symbol->isCollapseModule)
-						break;
-					callstack.addresses.erase(callstack.addresses.begin());
-				}
-				while (callstack.addresses.size() >= 2);
-			}
-		}
-
-		callstack.symbols.resize(callstack.addresses.size());
-		for (size_t i=0; i<callstack.addresses.size(); i++)
-			callstack.symbols[i] = addrinfo.at(callstack.addresses[i]).symbol;
-
-		callstacks.emplace_back(std::move(callstack));
-
-		wxFileOffset offset = file.TellI();
-		if (offset != wxInvalidOffset && offset != (wxFileOffset)filesize)
-			progressdlg.Update(kMaxProgress * offset / filesize);
-	}
-
-	struct Pred
-	{
-		bool operator () (const CallStack &a, const CallStack &b)
-		{
-			long l = a.addresses.size() - b.addresses.size();
-			return l ? l<0 : a.addresses < b.addresses;
-		}
-	};
-
-	// Sort and filter repeating callstacks
-	{
-		progressdlg.Update(0, "Sorting...");
-		progressdlg.Pulse();
-
-		std::stable_sort(callstacks.begin(), callstacks.end(), Pred());
-
-		progressdlg.Update(0, "Filtering...");
-
-		std::vector<CallStack> filtered;
-		const auto total = callstacks.size();
-		for (size_t i = 0; i < total; ++i)
-		{
-			if (i % 256 == 0)
-				progressdlg.Update(kMaxProgress * i / total);
-
-			auto& item = callstacks[i];
-			if (!filtered.empty() && filtered.back().addresses == item.addresses)
-				filtered.back().samplecount += item.samplecount;
-			else
-				filtered.emplace_back(std::move(item));
-		}
-
-		std::swap(filtered, callstacks);
-	}
-}
-
-void Database::loadIpCounts(wxInputStream &file)
-{
-	double totalcount = 0;
-	wxTextInputStream str(file);
-
-	str >> totalcount;
-
-	while(!file.Eof())
-	{
-		wxString line = str.ReadLine();
-		if (line.IsEmpty())
-			break;
-
-		std::wistringstream stream(line.c_str().AsWChar());
-
-		std::wstring addrstr;
-		double count;
-
-		stream >> addrstr;
-		stream >> count;
-
-		Address addr = hexStringTo64UInt(addrstr);
-		AddrInfo *info = &addrinfo.at(addr);
-		info->count += count;
-		info->percentage += 100.0f * ((float)count / (float)totalcount);
-	}
-}
-
-void Database::loadStats(wxInputStream &file)
-{
-	wxTextInputStream str(file);
-
-	stats.clear();
-
-	while(!file.Eof())
-	{
-		wxString line = str.ReadLine();
-		if (line.IsEmpty())
-			break;
-
-		stats.push_back(line.c_str().AsWChar());
-	}
-}
-
-void Database::setRoot(const Database::Symbol *root)
-{
-	currentRoot = root;
-	scanMainList();
-}
-
-bool Database::includeCallstack(const CallStack &callstack) const
-{
-	if (currentRoot)
-		return std::find(callstack.symbols.begin(), callstack.symbols.end(), currentRoot) != callstack.symbols.end();
-	return true;
-}
-
-void Database::scanMainList()
-{
-	std::vector<double> exclusive(symbols.size()), inclusive(symbols.size());
-
-	wxProgressDialog progressdlg(APPNAME, "Scanning profile database...",
-		(int)callstacks.size(), theMainWin,
-		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
-
-	mainList.items.clear();
-	mainList.items.reserve(symbols.size());
-	mainList.totalcount = 0;
-
-	Symbol::ID currentRootID = currentRoot ? currentRoot->id : -1;
-
-	int progress = 0;
-	for (auto it = callstacks.begin(); it != callstacks.end(); ++it)
-	{
-		const auto& i = *it;
-		// Only use call stacks that include the current root
-		if (!includeCallstack(i))
-			continue;
-
-		exclusive[i.symbols[0]->id] += i.samplecount;
-		std::vector<bool> seen(symbols.size());
-		for (size_t n = 0; n < i.symbols.size(); ++n)
-		{
-			Symbol::ID id = i.symbols[n]->id;
-
-			// we filter out duplicates, to avoid getting funny numbers when
-			// using recursive functions.
-			if (!seen[id])
-			{
-				inclusive[id] += i.samplecount;
-				seen[id] = true;
-			}
-			if (id == currentRootID) break;       // Stop handling the call stack if we encounter the root
-		}
-		mainList.totalcount += i.samplecount;
-
-		progressdlg.Update(progress++);
-	}
-
-	for (Symbol::ID id = 0; id < symbols.size(); ++id)
-	{
-		Item item;
-		item.symbol = symbols[id];
-		item.address = item.symbol->address;
-		item.exclusive = exclusive[id];
-		item.inclusive = inclusive[id];
-		mainList.items.push_back(item);
-	}
-}
-
-std::vector<const Database::CallStack*> Database::getCallstacksContaining(const Database::Symbol *symbol) const
-{
-	std::vector<const CallStack *> ret;
-	for (auto it = callstacks.begin(); it != callstacks.end(); ++it)
-	{
-		const auto& i = *it;
-		// Only use call stacks that include the current root
-		if (!includeCallstack(i)) continue;
-
-		// Only include callstacks that have our symbol in.
-		for (size_t n=0;n<i.symbols.size();n++)
-		{
-			if (i.symbols[n] == symbol)
-			{
-				ret.push_back(&i);
-				break;
-			}
-		}
-	}
-	return ret;
-}
-
-Database::List Database::getCallers(const Database::Symbol *symbol) const
-{
-	List list;
-	std::map<Address, double> counts;
-	for (auto it = callstacks.begin(); it != callstacks.end(); ++it)
-	{
-		const auto& i = *it;
-		// Only use call stacks that include the current root
-		if (!includeCallstack(i)) continue;
-
-		// Only include callstacks that have our symbol in.
-		for (size_t n=0;n<i.symbols.size()-1;n++)
-		{
-			const Symbol *s = i.symbols[n];
-			if (s == currentRoot) break;       // Stop handling the call stack if we encounter the root
-			if (s == symbol)
-			{
-				Address caller = i.addresses[n+1];
-
-				counts[caller] += i.samplecount;
-				list.totalcount += i.samplecount;
-			}
-		}
-	}
-
-	for (auto i = counts.begin(); i != counts.end(); ++i)
-	{
-		Item item;
-		item.address = i->first;
-		item.symbol = addrinfo.at(item.address).symbol;
-		item.inclusive = i->second;
-		item.exclusive = i->second;
-		list.items.push_back(item);
-	}
-
-	return std::move(list);
-}
-
-Database::List Database::getCallees(const Database::Symbol *symbol) const
-{
-	List list;
-	std::map<const Symbol *, double> counts;
-	for (auto i = callstacks.begin(); i != callstacks.end(); ++i)
-	{
-		// Only use call stacks that include the current root
-		if (!includeCallstack(*i)) continue;
-
-		double callstackCost = i->samplecount;
-
-		// Only include callstacks that have our symbol in.
-		for (size_t n=1;n<i->symbols.size();n++)
-		{
-			if (i->symbols[n] == symbol)
-			{
-				const Symbol *callee = i->symbols[n-1];
-				counts[callee] += callstackCost;
-				list.totalcount += callstackCost;
-			}
-			if (i->symbols[n] == currentRoot) break;       // Stop handling the call stack if we encounter the root
-		}
-	}
-
-	for (auto i = counts.begin(); i != counts.end(); ++i)
-	{
-		Item item;
-		item.symbol = i->first;
-		item.address = item.symbol->address;
-		item.inclusive = i->second;
-		item.exclusive = i->second;
-		list.items.push_back(item);
-	}
-
-	return list;
-}
-
-void Database::loadMinidump(wxInputStream &file)
-{
-	wxFFile minidump_file;
-	std::wstring dumppath = wxFileName::CreateTempFileName(wxEmptyString, &minidump_file);
-	wxFFileOutputStream minidump_stream(minidump_file);
-	minidump_stream.Write(file);
-	minidump_stream.Close();
-	minidump_file.Close();
-
-	try
-	{
-		late_sym_info->loadMinidump(dumppath, true);
-	}
-	catch (SleepyException &e)
-	{
-		wxLogError("%ls\n", e.wwhat());
-		// Continue loading database
-	}
-}
-
-std::vector<double> Database::getLineCounts(FileID sourcefile)
-{
-	std::vector<double> linecounts;
-
-	for each (auto &pair in addrinfo)
-		if (pair.second.symbol->sourcefile == sourcefile)
-		{
-			unsigned sourceline = pair.second.sourceline;
-			if (linecounts.size() <= size_t(sourceline))
-				linecounts.resize(sourceline+1);
-			linecounts[sourceline] += pair.second.count;
-		}
-
-	return linecounts;
-}
+/*=====================================================================
+Database.cpp
+------------
+
+Copyright (C) Nicholas Chapman
+Copyright (C) Richard Mitton
+Copyright (C) 2015 Ashod Nakashian
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+#include "database.h"
+
+#include "../utils/stringutils.h"
+#include "sourceview.h"
+#include <wx/mstream.h>
+#include <fstream>
+#include <set>
+#include "mainwin.h"
+#include "../profiler/symbolinfo.h"
+#include <algorithm>
+#include <memory>
+#include "../appinfo.h"
+#include "../utils/except.h"
+#include "latesymbolinfo.h"
+#include "captureindex.h"
+#include "../utils/varint.h"
+#include "../utils/mythread.h"
+#include "../utils/textscanner.h"
+
+Database *theDatabase;
+
+StringSet osModules(L"osmodules.txt",false);
+StringSet osFunctions(L"osfunctions.txt",true);
+
+bool IsOsFunction(wxString proc)
+{
+	return osFunctions.Contains(proc);
+}
+
+void AddOsFunction(wxString proc)
+{
+	osFunctions.Add(proc);
+	theMainWin->reload();
+}
+
+void RemoveOsFunction(wxString proc)
+{
+	osFunctions.Remove(proc);
+	theMainWin->reload();
+}
+
+bool IsOsModule(wxString mod)
+{
+	return osModules.Contains(mod);
+}
+
+void AddOsModule(wxString mod)
+{
+	osModules.Add(mod);
+	theMainWin->reload();
+}
+
+void RemoveOsModule(wxString mod)
+{
+	osModules.Remove(mod);
+	theMainWin->reload();
+}
+
+Database::Database()
+{
+	assert(!theDatabase);
+	theDatabase = this;
+	currentRoot = NULL;
+	groupTemplates = false;
+	late_sym_info = new LateSymbolInfo();
+}
+
+Database::~Database()
+{
+	clear();
+	delete late_sym_info;
+}
+
+void Database::clear()
+{
+	for (auto i = symbols.begin(); i != symbols.end(); ++i)
+		if (*i)
+			delete *i;
+
+	symbols.clear();
+	files.clear();
+	filemap.clear();
+	modules.clear();
+	modulemap.clear();
+	addrinfo.clear();
+	inlines.clear();
+	addrTable.clear();
+	moduleRecords.clear();
+	modules64Bit = false;
+	symbolsDeferred = false;
+	callstacks.clear();
+	stackmap.clear();
+	rawStacks.clear();
+	rawFrames.clear();
+	samples.clear();
+	sampleThreads.clear();
+	mainList.items.clear();
+	mainList.totalcount = 0;
+	latency.clear();
+	has_minidump = false;
+}
+
+void Database::reload(bool collapseOSCalls, bool _groupTemplates, bool loadMinidump)
+{
+	loadFromPath(profilepath, collapseOSCalls, _groupTemplates, loadMinidump);
+}
+
+// Write the symbols looked up for a capture with deferred symbols back
+// into it, so that it's quick to open from then on, and readable by
+// versions that can't look them up.
+static void rewriteSymbols(const std::wstring &path, const std::vector<unsigned char> &symbols)
+{
+	wxString tmppath = path + L".tmp";
+	bool ok;
+	{
+		wxFFileInputStream in(path);
+		wxZipInputStream zin(in);
+		wxFFileOutputStream out(tmppath);
+		wxZipOutputStream zout(out);
+
+		ok = in.IsOk() && zin.IsOk() && out.IsOk() && zout.IsOk();
+		while (wxZipEntry *entry = ok ? zin.GetNextEntry() : NULL)
+		{
+			wxString name = entry->GetInternalName();
+			if (name == "Symbols.bin")
+			{
+				delete entry;
+				zout.PutNextEntry("Symbols.bin");
+				zout.Write(&symbols[0], symbols.size());
+			}
+			else if (name == "Modules.txt")
+			{
+				delete entry;
+				zout.PutNextEntry("Modules.txt");
+
+				wxTextInputStream lines(zin, wxT(" \t"), wxConvAuto(wxFONTENCODING_UTF8));
+				wxTextOutputStream txt(zout, wxEOL_NATIVE, wxConvAuto(wxFONTENCODING_UTF8));
+				wxString header = lines.ReadLine();
+				header.Replace(" deferred", " resolved");
+				txt << header << "\n";
+				while (!zin.Eof())
+				{
+					wxString line = lines.ReadLine();
+					if (line.IsEmpty())
+						break;
+					txt << line << "\n";
+				}
+			}
+			else
+				ok = zout.CopyEntry(entry, zin);
+		}
+		ok = ok && zin.Eof() && zout.Close() && out.Close();
+	}
+
+	if (!ok || !wxRenameFile(tmppath, path, true))
+	{
+		wxRemoveFile(tmppath);
+		wxLogWarning("Could not save the symbols looked up into %ls; they will be looked up again next time.", path.c_str());
+	}
+}
+
+// Every entry loadFromPath reads into memory, in the order it loads them.
+static const char *const knownEntries[] = {
+	"Modules.txt",
+	"Symbols.bin", "Symbols.txt",
+	"Callstacks.bin", "Callstacks.txt",
+	"IPCounts.bin", "IPCounts.txt",
+	"Samples.bin", "Stats.txt", "Latency.txt",
+};
+
+static bool isKnownEntry(const wxString &name)
+{
+	for (size_t i = 0; i < sizeof(knownEntries) / sizeof(knownEntries[0]); i++)
+		if (name == knownEntries[i])
+			return true;
+	return false;
+}
+
+// The entries whose contents the capture index holds.
+static bool isIndexedEntry(const wxString &name)
+{
+	return name == "Symbols.bin" || name == "Callstacks.bin" || name == "IPCounts.bin" ||
+		name == "Symbols.txt" || name == "Callstacks.txt" || name == "IPCounts.txt" ||
+		name == "Samples.bin";
+}
+
+// Inflates one entry of a capture into memory, through a stream of its
+// own, so that entries can be inflated side by side.
+class EntryInflater : public MyThread
+{
+public:
+	EntryInflater(const std::wstring &path_, const wxZipEntry &entry_)
+	:	path(path_), entry(entry_), ok(false) {}
+
+	virtual void run()
+	{
+		wxFFileInputStream input(path);
+		wxZipInputStream zip(input);
+		if (input.IsOk() && zip.IsOk() && zip.OpenEntry(entry))
+		{
+			wxFileOffset size = entry.GetSize();
+			if (size != wxInvalidOffset)
+			{
+				data.resize((size_t)size);
+				ok = data.empty() || (zip.Read(&data[0], data.size()).LastRead() == data.size());
+			}
+			else
+			{
+				wxMemoryOutputStream mem;
+				mem.Write(zip);
+				data.resize(mem.GetSize());
+				if (!data.empty())
+					mem.CopyTo(&data[0], data.size());
+				ok = zip.Eof();
+			}
+		}
+	}
+
+	std::wstring path;
+	wxZipEntry entry;
+	std::vector<unsigned char> data;
+	bool ok;
+};
+
+void Database::loadFromPath(const std::wstring& _profilepath, bool collapseOSCalls, bool _groupTemplates, bool loadMinidump)
+{
+	if(_profilepath != profilepath)
+		profilepath = _profilepath;
+	clear();
+	groupTemplates = _groupTemplates;
+
+	// Deferred symbols, once looked up, replace the placeholders.
+	std::vector<unsigned char> resolvedSymbols;
+	bool resolved = false;
+
+	// What was made of the capture last time, if it's still good. Asking
+	// for the minidump's symbols always looks them up afresh, as symbols
+	// missing last time (a PDB since added, say) may be found now.
+	bool minidumpSymbols = loadMinidump || late_sym_info->isFiltering();
+	unsigned indexOptions = (groupTemplates ? CaptureIndex::GROUP_TEMPLATES : 0) |
+		(minidumpSymbols ? CaptureIndex::MINIDUMP_SYMBOLS : 0);
+	CaptureIndex index;
+	bool indexed = !loadMinidump && index.map(profilepath, indexOptions);
+
+	{
+		wxFFileInputStream input(profilepath);
+		enforce(input.IsOk(), "Input stream error opening profile data.");
+
+		// The input is seekable, so the entries come from the zip's
+		// central directory: listing them reads nothing else.
+		wxZipInputStream zip(input);
+		enforce(zip.IsOk(), "ZIP error opening profile data.");
+
+		std::vector<std::unique_ptr<wxZipEntry> > entries;
+		bool versionFound = false;
+		while (wxZipEntry *entry = zip.GetNextEntry())
+		{
+			entries.emplace_back(entry);
+			wxString name = entry->GetInternalName();
+
+			if (name.Left(8) == "Version " && name.Right(9) == " required")
+			{
+				versionFound = true;
+				wxString ver = name.Mid(8, name.Length()-(8+9));
+				enforce(ver == FORMAT_VERSION || ver == FORMAT_VERSION_TEXT,
+					wxString::Format("Cannot load capture file: %s", name.c_str()).c_str());
+			}
+		}
+		enforce(versionFound, "Unrecognized capture file");
+
+		// Every entry we read is inflated once, into memory, side by side
+		// with the others; the minidump goes straight to a file instead.
+		std::vector<std::unique_ptr<EntryInflater> > inflaters;
+		wxZipEntry *minidump = NULL;
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			wxString name = entries[i]->GetInternalName();
+
+				 if (name == "minidump.dmp")		{ has_minidump = true; minidump = entries[i].get(); }
+			else if (name.Left(8) == "Version ")	{}
+			else if (indexed && isIndexedEntry(name)) {}
+			else if (isKnownEntry(name))
+				inflaters.emplace_back(new EntryInflater(profilepath, *entries[i]));
+			else
+				wxLogWarning("Other fluff found in capture file (%s)\n", name.c_str());
+		}
+
+		for (size_t i = 0; i < inflaters.size(); i++)
+			inflaters[i]->launch(false, THREAD_PRIORITY_NORMAL);
+
+		if (minidump && loadMinidump && !indexed && zip.OpenEntry(*minidump))
+			this->loadMinidump(zip);
+
+		for (size_t i = 0; i < inflaters.size(); i++)
+			inflaters[i]->waitFor();
+
+		std::map<wxString, const std::vector<unsigned char> *> contents;
+		for (size_t i = 0; i < inflaters.size(); i++)
+		{
+			wxString name = inflaters[i]->entry.GetInternalName();
+			enforce(inflaters[i]->ok, wxString::Format("Could not read %s from the capture file.", name.c_str()).c_str());
+			contents[name] = &inflaters[i]->data;
+		}
+
+		// In the order they depend on each other, whatever order the zip has
+		// them in: the symbols first, as everything else refers to them.
+		for (size_t i = 0; i < sizeof(knownEntries) / sizeof(knownEntries[0]); i++)
+		{
+			auto it = contents.find(knownEntries[i]);
+			if (it == contents.end())
+				continue;
+
+			const std::vector<unsigned char> &data = *it->second;
+			wxString name = it->first;
+			if (name == "Symbols.bin" && symbolsDeferred)
+			{
+				resolveSymbols(data, resolvedSymbols);
+				resolved = true;
+				loadSymbolsBin(resolvedSymbols);
+				continue;
+			}
+
+				 if (name == "Symbols.bin")		loadSymbolsBin(data);
+			else if (name == "Callstacks.bin")	loadCallstacksBin(data,collapseOSCalls);
+			else if (name == "IPCounts.bin")	loadIpCountsBin(data);
+			else if (name == "Samples.bin")		loadSampleLog(data);
+			else if (name == "Symbols.txt")		loadSymbols(data);
+			else if (name == "Callstacks.txt")	loadCallstacks(data,collapseOSCalls);
+			else if (name == "IPCounts.txt")	loadIpCounts(data);
+			else
+			{
+				static const unsigned char none = 0;
+				wxMemoryInputStream file(data.empty() ? &none : &data[0], data.size());
+
+					 if (name == "Modules.txt")		loadModules(file);
+				else if (name == "Stats.txt")		loadStats(file);
+				else if (name == "Latency.txt")		loadLatency(file);
+			}
+		}
+	}
+
+	if (resolved)
+		rewriteSymbols(profilepath, resolvedSymbols);
+
+	if (indexed)
+	{
+		loadIndex(index, collapseOSCalls);
+		index.unmap();
+	}
+	else
+		saveIndex(indexOptions);
+
+	// The sample log refers to stacks as they were saved,
+	// which have since been merged and sorted.
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < samples.size(); ++i)
+		{
+			if (samples[i].stack >= stackmap.size())
+				continue;
+			samples[kept] = samples[i];
+			samples[kept].stack = stackmap[samples[i].stack];
+			kept++;
+		}
+		samples.resize(kept);
+	}
+
+	applySampleFilter();
+	setRoot(NULL);
+}
+
+// Windows progress bar is limited to 0x10000 max.
+static const __int64 kMaxProgress = 0x8000LL;
+
+void Database::loadIndex(const CaptureIndex &index, bool collapseKernelCalls)
+{
+	wxProgressDialog progressdlg(APPNAME, "Loading index...",
+		kMaxProgress, theMainWin,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
+
+	// The index's IDs are positions in its own tables, which clear() left these empty for.
+	const unsigned *fileNames = index.getFiles();
+	files.reserve(index.getNumFiles());
+	for (size_t i = 0; i < index.getNumFiles(); i++)
+	{
+		files.push_back(index.getString(fileNames[i]));
+		filemap[files.back()] = i;
+	}
+
+	const unsigned *moduleNames = index.getModules();
+	modules.reserve(index.getNumModules());
+	for (size_t i = 0; i < index.getNumModules(); i++)
+	{
+		modules.push_back(index.getString(moduleNames[i]));
+		modulemap[modules.back()] = i;
+	}
+
+	// Already demangled and grouped, as they were left last time.
+	const CaptureIndex::SymbolRecord *symbolRecords = index.getSymbols();
+	symbols.reserve(index.getNumSymbols());
+	for (size_t i = 0; i < index.getNumSymbols(); i++)
+	{
+		const CaptureIndex::SymbolRecord &record = symbolRecords[i];
+		Symbol *sym = new Symbol;
+		sym->id                 = symbols.size();
+		sym->address            = record.address;
+		sym->procname           = index.getString(record.proc);
+		sym->sourcefile         = record.file;
+		sym->module             = record.module;
+		sym->isCollapseFunction = osFunctions.Contains(sym->procname.c_str());
+		sym->isCollapseModule   = osModules  .Contains(modules[record.module].c_str());
+		symbols.push_back(sym);
+	}
+
+	const CaptureIndex::AddrRecord *addrs = index.getAddrs();
+	addrinfo.reserve(index.getNumAddrs());
+	for (size_t i = 0; i < index.getNumAddrs(); i++)
+	{
+		AddrInfo &info = addrinfo[addrs[i].addr];
+		info.symbol     = symbols[addrs[i].symbol];
+		info.sourceline = addrs[i].line;
+		info.count      = addrs[i].count;
+		info.percentage = addrs[i].percentage;
+	}
+
+	// The stacks are as saved, so that the sample log's IDs still hold;
+	// only collapsing, which depends on the OS function lists, is redone.
+	const CaptureIndex::StackRecord *stacks = index.getStacks();
+	const unsigned *frames = index.getFrames();
+	callstacks.reserve(index.getNumStacks());
+	for (size_t i = 0; i < index.getNumStacks(); i++)
+	{
+		CallStack callstack;
+		callstack.samplecount = stacks[i].samplecount;
+		callstack.addresses.resize(stacks[i].num_frames);
+		for (unsigned n = 0; n < stacks[i].num_frames; n++)
+			callstack.addresses[n] = addrs[frames[stacks[i].first_frame + n]].addr;
+		addExpandedCallstack(callstack, collapseKernelCalls);
+
+		if (i % 4096 == 0)
+			progressdlg.Update(kMaxProgress * i / index.getNumStacks());
+	}
+	sortCallstacks(progressdlg);
+
+	sampleThreads.assign(index.getThreads(), index.getThreads() + index.getNumThreads());
+	const CaptureIndex::SampleRecord *sampleRecords = index.getSamples();
+	samples.resize(index.getNumSamples());
+	for (size_t i = 0; i < samples.size(); i++)
+	{
+		samples[i].time   = sampleRecords[i].time;
+		samples[i].thread = sampleRecords[i].thread;
+		samples[i].stack  = sampleRecords[i].stack;
+		samples[i].weight = sampleRecords[i].weight;
+	}
+}
+
+// Keep what was made of the capture beside it, for next time. Failing
+// to is no reason not to show it.
+void Database::saveIndex(unsigned options)
+{
+	CaptureIndex::Tables tables;
+
+	for (size_t i = 0; i < files.size(); i++)
+		tables.files.push_back(tables.addString(files[i]));
+	for (size_t i = 0; i < modules.size(); i++)
+		tables.modules.push_back(tables.addString(modules[i]));
+
+	tables.symbols.reserve(symbols.size());
+	for (size_t i = 0; i < symbols.size(); i++)
+	{
+		const Symbol *sym = symbols[i];
+		CaptureIndex::SymbolRecord record = { sym->address, tables.addString(sym->procname),
+											  (unsigned)sym->sourcefile, (unsigned)sym->module, 0 };
+		tables.symbols.push_back(record);
+	}
+
+	std::vector<Address> addrs;
+	addrs.reserve(addrinfo.size());
+	for (auto it = addrinfo.begin(); it != addrinfo.end(); ++it)
+		addrs.push_back(it->first);
+	std::sort(addrs.begin(), addrs.end());
+
+	tables.addrs.reserve(addrs.size());
+	for (size_t i = 0; i < addrs.size(); i++)
+	{
+		const AddrInfo &info = addrinfo.at(addrs[i]);
+		CaptureIndex::AddrRecord record = { addrs[i], (unsigned)info.symbol->id, info.sourceline,
+											info.count, info.percentage, 0 };
+		tables.addrs.push_back(record);
+	}
+
+	tables.stacks = rawStacks;
+	tables.frames.reserve(rawFrames.size());
+	for (size_t i = 0; i < rawFrames.size(); i++)
+		tables.frames.push_back((unsigned)(std::lower_bound(addrs.begin(), addrs.end(), rawFrames[i]) - addrs.begin()));
+
+	tables.threads = sampleThreads;
+	tables.samples.reserve(samples.size());
+	for (size_t i = 0; i < samples.size(); i++)
+	{
+		CaptureIndex::SampleRecord record = { samples[i].time, samples[i].weight, samples[i].thread, (unsigned)samples[i].stack };
+		tables.samples.push_back(record);
+	}
+
+	std::vector<CaptureIndex::StackRecord>().swap(rawStacks);
+	std::vector<Address>().swap(rawFrames);
+
+	CaptureIndex::save(profilepath, options, tables);
+}
+
+// Modules.txt: "<32|64> <deferred|resolved>", then a line per module.
+void Database::loadModules(wxInputStream &file)
+{
+	wxTextInputStream str(file, wxT(" \t"), wxConvAuto(wxFONTENCODING_UTF8));
+
+	wxString header = str.ReadLine();
+	modules64Bit = header.StartsWith("64");
+	symbolsDeferred = header.EndsWith(" deferred");
+
+	while (!file.Eof())
+	{
+		wxString line = str.ReadLine();
+		if (line.IsEmpty())
+			break;
+		moduleRecords.push_back(line.c_str().AsWChar());
+	}
+}
+
+// Look up the addresses of a deferred Symbols.bin, into what it would
+// have held had they been looked up at the end of the capture. They
+// keep their order, which the other entries refer to them by.
+void Database::resolveSymbols(const std::vector<unsigned char> &data, std::vector<unsigned char> &symbolsOut)
+{
+	std::vector<SymbolInfo::ModuleRecord> records;
+	for (size_t i = 0; i < moduleRecords.size(); i++)
+	{
+		SymbolInfo::ModuleRecord record;
+		if (SymbolInfo::parseModuleRecord(moduleRecords[i], record))
+			records.push_back(record);
+		else
+			wxLogWarning("Bad module record: %ls", moduleRecords[i].c_str());
+	}
+
+	CaptureDecoder decoder;
+	enforce(!data.empty() && decoder.decodeSymbols(&data[0], data.size()), "Malformed symbols in capture file.");
+
+	// SymbolInfo looks up addresses of this build's width.
+	std::vector<PROFILER_ADDR> addrs(decoder.addrs.begin(), decoder.addrs.end());
+	for (size_t i = 0; i < addrs.size(); i++)
+		enforce(addrs[i] == decoder.addrs[i], "This capture's symbols can only be looked up by the 64-bit version of " APPNAME ".");
+
+	SymbolInfo sym_info;
+	sym_info.loadModuleRecords(records, modules64Bit, true);
+
+	wxProgressDialog progressdlg(APPNAME, "Looking up symbols...",
+		kMaxProgress+1, theMainWin,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
+
+	// A batch per module, as at the end of a capture.
+	std::vector<SymbolInfo::AddrSymbol> symbols(addrs.size());
+	volatile LONG numResolved = 0;
+	bool stop = false;
+	for (size_t begin = 0, end; begin < addrs.size(); begin = end)
+	{
+		Module *mod = sym_info.getModuleForAddr(addrs[begin]);
+		for (end = begin + 1; end < addrs.size(); end++)
+			if (sym_info.getModuleForAddr(addrs[end]) != mod)
+				break;
+
+		sym_info.resolveAddrs(&addrs[begin], end - begin, &symbols[begin], &numResolved, &stop);
+		progressdlg.Update(kMaxProgress * numResolved / addrs.size());
+	}
+	sym_info.saveSymbolCache();
+
+	CaptureEncoder encoder;
+	if (!addrs.empty())
+		sym_info.encodeSymbols(encoder, &addrs[0], &symbols[0], addrs.size());
+	symbolsOut.clear();
+	encoder.encodeSymbols(symbolsOut);
+}
+
+// read symbol table
+void Database::loadSymbols(const std::vector<unsigned char> &data)
+{
+	TextScanner text(data.empty() ? NULL : &data[0], data.size());
+
+	wxProgressDialog progressdlg(APPNAME, "Loading symbols...",
+		kMaxProgress+1, theMainWin,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
+
+	LocSymbols locsymbols;
+
+	// Names are converted once each, however many addresses repeat them.
+	NameTable names;
+	std::wstring sourcefilename, modulename, procname;
+
+	bool warnedDupAddress = false;
+	for (size_t n = 0; text.nextLine(); n++)
+	{
+		Address addr;
+		const char *module, *moduleEnd, *proc, *procEnd, *file, *fileEnd;
+		unsigned sourceline;
+		enforce(text.readHex(addr) &&
+				text.readQuoted(module, moduleEnd) &&
+				text.readQuoted(proc, procEnd) &&
+				text.readQuoted(file, fileEnd) &&
+				text.readUnsigned(sourceline),
+				"Malformed line in symbol list: " + text.getLine());
+
+		modulename     = names.get(module, moduleEnd);
+		procname       = names.get(proc, procEnd);
+		sourcefilename = names.get(file, fileEnd);
+		if (!addSymbol(addr, modulename, procname, sourcefilename, sourceline, locsymbols))
+		{
+			if (!warnedDupAddress)
+				wxLogWarning("Duplicate address in symbol list:\nAddress: 0x%llX\nSymbol: %ls", addr, procname.c_str());
+			warnedDupAddress = true;
+			continue;
+		}
+		enforce(text.atLineEnd(), "Trailing data in line: " + text.getLine());
+
+		if (n % 4096 == 0 && text.getOffset() != data.size())
+			progressdlg.Update(kMaxProgress * text.getOffset() / data.size());
+	}
+
+	late_sym_info->logStats();
+
+	// The unordered_map destructor takes a very long time to run.
+	progressdlg.Update(kMaxProgress, "Tidying things up...");
+}
+
+bool Database::addSymbol(Address addr, std::wstring &modulename, std::wstring &procname, std::wstring &sourcefilename,
+						 unsigned sourceline, LocSymbols &locsymbols)
+{
+	bool inserted;
+	AddrInfo &info = map_emplace(addrinfo, addr, &inserted);
+	if (!inserted)
+		return false;
+	info.sourceline = sourceline;
+
+	// Late symbol lookup
+	late_sym_info->filterSymbol(addr, modulename, procname, sourcefilename, info.sourceline);
+
+	// Worked out once per distinct name, here and on reloads.
+	procname = groupTemplates ? demangler.groupName(procname) : demangler.demangle(procname);
+
+	// Convert filename and module strings to a numeric IDs
+	SymbolKey key;
+	key.file     = map_string(files  , filemap  , sourcefilename);
+	key.module   = map_string(modules, modulemap, modulename    );
+	key.procname = &*locsymbols.procnames.insert(procname).first;
+
+	info.symbol = getSymbol(key, addr, locsymbols);
+	return true;
+}
+
+const Database::Symbol *Database::getSymbol(const SymbolKey &key, Address addr, LocSymbols &locsymbols)
+{
+	// Create a new symbol entry, or lookup the existing one, based on the key
+	bool inserted;
+	const Symbol *&sym = map_emplace(locsymbols.symbols, key, &inserted);
+	if (inserted) // new symbol, judging by its location?
+	{
+		Symbol *newsym = new Symbol;
+		newsym->id                 = symbols.size();
+		newsym->address            = addr;
+		newsym->procname           = *key.procname;
+		newsym->sourcefile         = key.file;
+		newsym->module             = key.module;
+		newsym->isCollapseFunction = osFunctions.Contains(key.procname->c_str());
+		newsym->isCollapseModule   = osModules  .Contains(modules[key.module].c_str());
+		symbols.push_back(newsym);
+		sym = newsym;
+	}
+	return sym;
+}
+
+// read the binary symbol table, and the functions inlined at each address
+void Database::loadSymbolsBin(const std::vector<unsigned char> &data)
+{
+	CaptureDecoder decoder;
+	enforce(!data.empty() && decoder.decodeSymbols(&data[0], data.size()), "Malformed symbols in capture file.");
+
+	wxProgressDialog progressdlg(APPNAME, "Loading symbols...",
+		kMaxProgress+1, theMainWin,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
+
+	// Each string is converted once, not once per address it names.
+	std::vector<std::wstring> strings(decoder.strings.size());
+	for (size_t i = 0; i < strings.size(); i++)
+		strings[i] = fromUtf8(decoder.strings[i]);
+
+	addrTable.assign(decoder.addrs.begin(), decoder.addrs.end());
+
+	LocSymbols locsymbols;
+
+	// Unless minidump symbols can rename addresses, each string's module,
+	// file or demangled name is worked out once, and rows go straight from
+	// string indices to symbols.
+	const bool filtering = late_sym_info->isFiltering();
+	const size_t none = (size_t)-1;
+	std::vector<size_t> stringModules, stringFiles;
+	std::vector<const std::wstring *> stringProcs;
+	if (!filtering)
+	{
+		stringModules.assign(strings.size(), none);
+		stringFiles.assign(strings.size(), none);
+		stringProcs.assign(strings.size(), NULL);
+	}
+
+	std::wstring modulename, procname, sourcefilename;
+	const size_t total = decoder.symbols.size();
+	for (size_t i = 0; i < total; i++)
+	{
+		const CaptureDecoder::Symbol &row = decoder.symbols[i];
+		if (filtering)
+		{
+			modulename     = strings[row.module];
+			procname       = strings[row.proc];
+			sourcefilename = strings[row.file];
+			enforce(addSymbol(row.addr, modulename, procname, sourcefilename, row.line, locsymbols),
+				"Duplicate address in symbol list.");
+		}
+		else
+		{
+			bool inserted;
+			AddrInfo &info = map_emplace(addrinfo, row.addr, &inserted);
+			enforce(inserted, "Duplicate address in symbol list.");
+			info.sourceline = row.line;
+
+			if (stringModules[row.module] == none)
+				stringModules[row.module] = map_string(modules, modulemap, strings[row.module]);
+			if (stringFiles[row.file] == none)
+				stringFiles[row.file] = map_string(files, filemap, strings[row.file]);
+			if (!stringProcs[row.proc])
+			{
+				const std::wstring &name = groupTemplates ? demangler.groupName(strings[row.proc]) : demangler.demangle(strings[row.proc]);
+				stringProcs[row.proc] = &*locsymbols.procnames.insert(name).first;
+			}
+
+			SymbolKey key;
+			key.module   = stringModules[row.module];
+			key.file     = stringFiles[row.file];
+			key.procname = stringProcs[row.proc];
+			info.symbol = getSymbol(key, row.addr, locsymbols);
+		}
+
+		if (row.depth > 0)
+			inlines[row.addr & ~inlineFrameAddress(0, MAX_INLINE_DEPTH)].push_back(row.addr);
+
+		if (i % 4096 == 0)
+			progressdlg.Update(kMaxProgress * i / total);
+	}
+
+	late_sym_info->logStats();
+
+	// The unordered_map destructor takes a very long time to run.
+	progressdlg.Update(kMaxProgress, "Tidying things up...");
+}
+
+// read the callstack trie; each node with a count is a stack
+void Database::loadCallstacksBin(const std::vector<unsigned char> &data,bool collapseKernelCalls)
+{
+	CaptureDecoder decoder;
+	decoder.addrs.assign(addrTable.begin(), addrTable.end());
+	std::vector<CaptureDecoder::Node> nodes;
+	enforce(!data.empty() && decoder.decodeCallstacks(&data[0], data.size(), nodes), "Malformed callstacks in capture file.");
+
+	wxProgressDialog progressdlg(APPNAME, "Loading callstacks...",
+		kMaxProgress, theMainWin,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
+
+	std::vector<Address> frames;
+	for (size_t id = 1; id < nodes.size(); id++)
+	{
+		if (!nodes[id].count)
+			continue;
+
+		// Innermost frame first, as the walk from the node to the root gives us.
+		frames.clear();
+		for (size_t n = id; n != 0; n = nodes[n].parent)
+			frames.push_back(addrTable[nodes[n].addr]);
+		addCallstack(nodes[id].count / 1e6, frames, collapseKernelCalls);
+
+		if (id % 4096 == 0)
+			progressdlg.Update(kMaxProgress * id / nodes.size());
+	}
+
+	sortCallstacks(progressdlg);
+}
+
+void Database::loadIpCountsBin(const std::vector<unsigned char> &data)
+{
+	CaptureDecoder decoder;
+	decoder.addrs.assign(addrTable.begin(), addrTable.end());
+	unsigned long long total;
+	std::vector<std::pair<unsigned, unsigned long long> > counts;
+	enforce(!data.empty() && decoder.decodeIpCounts(&data[0], data.size(), total, counts), "Malformed IP counts in capture file.");
+
+	for (size_t i = 0; i < counts.size(); i++)
+		addIpCount(addrTable[counts[i].first], counts[i].second / 1e6, total / 1e6);
+}
+
+// read callstacks
+void Database::loadCallstacks(const std::vector<unsigned char> &data,bool collapseKernelCalls)
+{
+	TextScanner text(data.empty() ? NULL : &data[0], data.size());
+
+	wxProgressDialog progressdlg(APPNAME, "Loading callstacks...",
+		kMaxProgress, theMainWin,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
+
+	std::vector<Address> frames;
+	for (size_t n = 0; text.nextLine(); n++)
+	{
+		double samplecount;
+		enforce(text.readDouble(samplecount), "Malformed line in callstacks: " + text.getLine());
+
+		frames.clear();
+		Address addr;
+		while (text.readHex(addr))
+			frames.push_back(addr);
+		enforce(text.atLineEnd(), "Malformed line in callstacks: " + text.getLine());
+		addCallstack(samplecount, frames, collapseKernelCalls);
+
+		if (n % 4096 == 0 && text.getOffset() != data.size())
+			progressdlg.Update(kMaxProgress * text.getOffset() / data.size());
+	}
+
+	sortCallstacks(progressdlg);
+}
+
+void Database::addCallstack(double samplecount, const std::vector<Address> &frames, bool collapseKernelCalls)
+{
+	CallStack callstack;
+	callstack.samplecount = samplecount;
+
+	for (size_t n = 0; n < frames.size(); n++)
+	{
+		Address addr = frames[n];
+
+		// Functions inlined at addr are frames of their own, called
+		// from it; the expansion was looked up once, with the symbols.
+		auto inlined = inlines.find(addr);
+		size_t numInlined = inlined != inlines.end() ? inlined->second.size() : 0;
+		for (size_t i = 0; i < numInlined; i++)
+			callstack.addresses.push_back(inlined->second[i]);
+		callstack.addresses.push_back(addr);
+	}
+
+	// Kept as they are, for the capture index.
+	CaptureIndex::StackRecord raw = { samplecount, (unsigned)rawFrames.size(), (unsigned)callstack.addresses.size() };
+	rawStacks.push_back(raw);
+	rawFrames.insert(rawFrames.end(), callstack.addresses.begin(), callstack.addresses.end());
+
+	addExpandedCallstack(callstack, collapseKernelCalls);
+}
+
+void Database::addExpandedCallstack(CallStack &callstack, bool collapseKernelCalls)
+{
+	if (collapseKernelCalls)
+	{
+		// Whatever an OS function called is left out; the outermost one wins.
+		for (size_t i = callstack.addresses.size(); i-- > 0; )
+		{
+			if (addrinfo.at(callstack.addresses[i]).symbol->isCollapseFunction)
+			{
+				callstack.addresses.erase(callstack.addresses.begin(), callstack.addresses.begin() + i);
+				break;
+			}
+		}
+
+		if (callstack.addresses.size() >= 2 && addrinfo.at(callstack.addresses[0]).symbol->isCollapseModule)
+		{
+			do
+			{
+				if (!addrinfo.at(callstack.addresses[1]).symbol->isCollapseModule)
+					break;
+				callstack.addresses.erase(callstack.addresses.begin());
+			}
+			while (callstack.addresses.size() >= 2);
+		}
+	}
+
+	callstack.symbols.resize(callstack.addresses.size());
+	for (size_t i=0; i<callstack.addresses.size(); i++)
+		callstack.symbols[i] = addrinfo.at(callstack.addresses[i]).symbol;
+
+	callstacks.emplace_back(std::move(callstack));
+}
+
+void Database::sortCallstacks(wxProgressDialog &progressdlg)
+{
+	struct Pred
+	{
+		const std::vector<CallStack> &callstacks;
+		Pred(const std::vector<CallStack> &callstacks_) : callstacks(callstacks_) {}
+
+		bool operator () (size_t ia, size_t ib)
+		{
+			const CallStack &a = callstacks[ia], &b = callstacks[ib];
+			long l = a.addresses.size() - b.addresses.size();
+			return l ? l<0 : a.addresses < b.addresses;
+		}
+	};
+
+	// Sort and filter repeating callstacks.
+	// The sort goes through indices, so that we know where each line ended up.
+	{
+		progressdlg.Update(0, "Sorting...");
+		progressdlg.Pulse();
+
+		const auto total = callstacks.size();
+		std::vector<size_t> order(total);
+		for (size_t i = 0; i < total; ++i)
+			order[i] = i;
+		std::stable_sort(order.begin(), order.end(), Pred(callstacks));
+
+		progressdlg.Update(0, "Filtering...");
+
+		std::vector<CallStack> filtered;
+		stackmap.assign(total, 0);
+		for (size_t i = 0; i < total; ++i)
+		{
+			if (i % 256 == 0)
+				progressdlg.Update(kMaxProgress * i / total);
+
+			auto& item = callstacks[order[i]];
+			if (!filtered.empty() && filtered.back().addresses == item.addresses)
+				filtered.back().samplecount += item.samplecount;
+			else
+				filtered.emplace_back(std::move(item));
+			stackmap[order[i]] = filtered.size() - 1;
+		}
+
+		for (auto it = filtered.begin(); it != filtered.end(); ++it)
+			it->unfilteredcount = it->samplecount;
+
+		std::swap(filtered, callstacks);
+	}
+}
+
+void Database::loadIpCounts(const std::vector<unsigned char> &data)
+{
+	TextScanner text(data.empty() ? NULL : &data[0], data.size());
+
+	double totalcount = 0;
+	if (text.nextLine())
+		enforce(text.readDouble(totalcount), "Malformed total in IP counts: " + text.getLine());
+
+	while (text.nextLine())
+	{
+		Address addr;
+		double count;
+		enforce(text.readHex(addr) && text.readDouble(count) && text.atLineEnd(),
+			"Malformed line in IP counts: " + text.getLine());
+
+		addIpCount(addr, count, totalcount);
+	}
+}
+
+void Database::addIpCount(Address addr, double count, double totalcount)
+{
+	// Samples were in the innermost of any functions inlined there.
+	auto inlined = inlines.find(addr);
+	if (inlined != inlines.end() && !inlined->second.empty())
+		addr = inlined->second[0];
+
+	AddrInfo *info = &addrinfo.at(addr);
+	info->count += count;
+	info->percentage += 100.0f * ((float)count / (float)totalcount);
+}
+
+void Database::loadStats(wxInputStream &file)
+{
+	wxTextInputStream str(file);
+
+	stats.clear();
+
+	while(!file.Eof())
+	{
+		wxString line = str.ReadLine();
+		if (line.IsEmpty())
+			break;
+
+		stats.push_back(line.c_str().AsWChar());
+	}
+}
+
+void Database::loadLatency(wxInputStream &file)
+{
+	wxTextInputStream str(file);
+
+	latency.clear();
+
+	while(!file.Eof())
+	{
+		wxString line = str.ReadLine();
+		if (line.IsEmpty())
+			break;
+
+		Latency entry;
+		entry.name = line.BeforeFirst(' ').c_str().AsWChar();
+		if (entry.histogram.fromString(line.AfterFirst(' ').c_str().AsWChar()))
+			latency.push_back(entry);
+		else
+			wxLogWarning("Malformed latency histogram: %s\n", entry.name.c_str());
+	}
+}
+
+// read the sample log; see SampleLog (profiler/samplelog.h) for the format
+void Database::loadSampleLog(const std::vector<unsigned char> &data)
+{
+	if (data.empty())
+		return;
+
+	const unsigned char *pos = &data[0], *end = pos + data.size();
+
+	samples.clear();
+	sampleThreads.clear();
+
+	unsigned long long numThreads, numRecords, value;
+	bool ok = readVarint(pos, end, numThreads) && numThreads <= data.size();
+	for (unsigned long long n = 0; ok && n < numThreads; ++n)
+	{
+		ok = readVarint(pos, end, value);
+		sampleThreads.push_back((unsigned)value);
+	}
+	ok = ok && readVarint(pos, end, numRecords) && numRecords <= data.size();
+
+	if (ok)
+		samples.reserve((size_t)numRecords);
+
+	std::vector<long long> prevStack(sampleThreads.size());
+	unsigned long long time = 0;
+	for (unsigned long long n = 0; ok && n < numRecords; ++n)
+	{
+		unsigned long long dt, index, dstack, weight;
+		ok = readVarint(pos, end, dt)
+			&& readVarint(pos, end, index) && index < sampleThreads.size()
+			&& readVarint(pos, end, dstack)
+			&& readVarint(pos, end, weight);
+		if (!ok)
+			break;
+
+		time += dt;
+		prevStack[(size_t)index] += zigzagDecode(dstack);
+
+		Sample sample;
+		sample.time   = time / 1e6;
+		sample.thread = sampleThreads[(size_t)index];
+		sample.stack  = (size_t)prevStack[(size_t)index];
+		sample.weight = weight / 1e6;
+		samples.push_back(sample);
+	}
+
+	if (!ok)
+	{
+		wxLogWarning("Malformed sample log in capture file; ignoring it.\n");
+		samples.clear();
+		sampleThreads.clear();
+	}
+}
+
+void Database::applySampleFilter()
+{
+	bool filtering = sampleFilter.isActive() && !samples.empty();
+
+	for (auto it = callstacks.begin(); it != callstacks.end(); ++it)
+		it->samplecount = filtering ? 0 : it->unfilteredcount;
+
+	if (!filtering)
+		return;
+
+	for (auto it = samples.begin(); it != samples.end(); ++it)
+		if (sampleFilter.includes(*it))
+			callstacks[it->stack].samplecount += it->weight;
+}
+
+void Database::setSampleFilter(const SampleFilter &filter)
+{
+	if (filter == sampleFilter)
+		return;
+
+	sampleFilter = filter;
+	applySampleFilter();
+	setRoot(currentRoot);
+}
+
+void Database::setRoot(const Database::Symbol *root)
+{
+	currentRoot = root;
+	scanMainList();
+}
+
+bool Database::includeCallstack(const CallStack &callstack) const
+{
+	// Skip callstacks the sample filter has removed entirely.
+	if (callstack.samplecount <= 0 && callstack.unfilteredcount > 0)
+		return false;
+	if (currentRoot)
+		return std::find(callstack.symbols.begin(), callstack.symbols.end(), currentRoot) != callstack.symbols.end();
+	return true;
+}
+
+void Database::scanMainList()
+{
+	std::vector<double> exclusive(symbols.size()), inclusive(symbols.size());
+
+	wxProgressDialog progressdlg(APPNAME, "Scanning profile database...",
+		(int)callstacks.size(), theMainWin,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE);
+
+	mainList.items.clear();
+	mainList.items.reserve(symbols.size());
+	mainList.totalcount = 0;
+
+	Symbol::ID currentRootID = currentRoot ? currentRoot->id : -1;
+
+	int progress = 0;
+	for (auto it = callstacks.begin(); it != callstacks.end(); ++it)
+	{
+		const auto& i = *it;
+		// Only use call stacks that include the current root
+		if (!includeCallstack(i))
+			continue;
+
+		exclusive[i.symbols[0]->id] += i.samplecount;
+		std::vector<bool> seen(symbols.size());
+		for (size_t n = 0; n < i.symbols.size(); ++n)
+		{
+			Symbol::ID id = i.symbols[n]->id;
+
+			// we filter out duplicates, to avoid getting funny numbers when
+			// using recursive functions.
+			if (!seen[id])
+			{
+				inclusive[id] += i.samplecount;
+				seen[id] = true;
+			}
+			if (id == currentRootID) break;       // Stop handling the call stack if we encounter the root
+		}
+		mainList.totalcount += i.samplecount;
+
+		progressdlg.Update(progress++);
+	}
+
+	for (Symbol::ID id = 0; id < symbols.size(); ++id)
+	{
+		Item item;
+		item.symbol = symbols[id];
+		item.address = item.symbol->address;
+		item.exclusive = exclusive[id];
+		item.inclusive = inclusive[id];
+		mainList.items.push_back(item);
+	}
+}
+
+std::vector<const Database::CallStack*> Database::getCallstacksContaining(const Database::Symbol *symbol) const
+{
+	std::vector<const CallStack *> ret;
+	for (auto it = callstacks.begin(); it != callstacks.end(); ++it)
+	{
+		const auto& i = *it;
+		// Only use call stacks that include the current root
+		if (!includeCallstack(i)) continue;
+
+		// Only include callstacks that have our symbol in.
+		for (size_t n=0;n<i.symbols.size();n++)
+		{
+			if (i.symbols[n] == symbol)
+			{
+				ret.push_back(&i);
+				break;
+			}
+		}
+	}
+	return ret;
+}
+
+Database::List Database::getCallers(const Database::Symbol *symbol) const
+{
+	List list;
+	std::map<Address, double> counts;
+	for (auto it = callstacks.begin(); it != callstacks.end(); ++it)
+	{
+		const auto& i = *it;
+		// Only use call stacks that include the current root
+		if (!includeCallstack(i)) continue;
+
+		// Only include callstacks that have our symbol in.
+		for (size_t n=0;n<i.symbols.size()-1;n++)
+		{
+			const Symbol *s = i.symbols[n];
+			if (s == currentRoot) break;       // Stop handling the call stack if we encounter the root
+			if (s == symbol)
+			{
+				Address caller = i.addresses[n+1];
+
+				counts[caller] += i.samplecount;
+				list.totalcount += i.samplecount;
+			}
+		}
+	}
+
+	for (auto i = counts.begin(); i != counts.end(); ++i)
+	{
+		Item item;
+		item.address = i->first;
+		item.symbol = addrinfo.at(item.address).symbol;
+		item.inclusive = i->second;
+		item.exclusive = i->second;
+		list.items.push_back(item);
+	}
+
+	return std::move(list);
+}
+
+Database::List Database::getCallees(const Database::Symbol *symbol) const
+{
+	List list;
+	std::map<const Symbol *, double> counts;
+	for (auto i = callstacks.begin(); i != callstacks.end(); ++i)
+	{
+		// Only use call stacks that include the current root
+		if (!includeCallstack(*i)) continue;
+
+		double callstackCost = i->samplecount;
+
+		// Only include callstacks that have our symbol in.
+		for (size_t n=1;n<i->symbols.size();n++)
+		{
+			if (i->symbols[n] == symbol)
+			{
+				const Symbol *callee = i->symbols[n-1];
+				counts[callee] += callstackCost;
+				list.totalcount += callstackCost;
+			}
+			if (i->symbols[n] == currentRoot) break;       // Stop handling the call stack if we encounter the root
+		}
+	}
+
+	for (auto i = counts.begin(); i != counts.end(); ++i)
+	{
+		Item item;
+		item.symbol = i->first;
+		item.address = item.symbol->address;
+		item.inclusive = i->second;
+		item.exclusive = i->second;
+		list.items.push_back(item);
+	}
+
+	return list;
+}
+
+void Database::loadMinidump(wxInputStream &file)
+{
+	wxFFile minidump_file;
+	std::wstring dumppath = wxFileName::CreateTempFileName(wxEmptyString, &minidump_file);
+	wxFFileOutputStream minidump_stream(minidump_file);
+	minidump_stream.Write(file);
+	minidump_stream.Close();
+	minidump_file.Close();
+
+	try
+	{
+		late_sym_info->loadMinidump(dumppath, true);
+	}
+	catch (SleepyException &e)
+	{
+		wxLogError("%ls\n", e.wwhat());
+		// Continue loading database
+	}
+}
+
+std::vector<double> Database::getLineCounts(FileID sourcefile)
+{
+	std::vector<double> linecounts;
+
+	for each (auto &pair in addrinfo)
+		if (pair.second.symbol->sourcefile == sourcefile)
+		{
+			unsigned sourceline = pair.second.sourceline;
+			if (linecounts.size() <= size_t(sourceline))
+				linecounts.resize(sourceline+1);
+			linecounts[sourceline] += pair.second.count;
+		}
+
+	return linecounts;
+}
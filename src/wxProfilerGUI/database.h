@@ -1,179 +1,313 @@
-/*=====================================================================
-database.h
-----------
-
-Copyright (C) Nicholas Chapman
-Copyright (C) Richard Mitton
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html.
-=====================================================================*/
-#ifndef __DATABASE_H_666_
-#define __DATABASE_H_666_
-
-#include "profilergui.h"
-#include "../utils/container.h"
-
-bool IsOsFunction(wxString proc);
-void AddOsFunction(wxString proc);
-void RemoveOsFunction(wxString proc);
-
-bool IsOsModule(wxString mod);
-void AddOsModule(wxString mod);
-void RemoveOsModule(wxString mod);
-
-/*=====================================================================
-Database
---------
-
-=====================================================================*/
-class Database
-{
-public:
-	typedef unsigned long long Address;
-	typedef size_t FileID;
-	typedef size_t ModuleID;
-
-	/// Represents one function (as it appears in function lists).
-	struct Symbol
-	{
-		/// Note: IDs may not persist across DB reloads
-		/// (e.g. due to changes in symbol load settings).
-		/// Use addresses to persistently refer to symbols in the GUI.
-		typedef size_t ID;
-		ID id;
-
-		/// Points to the address of the start of the symbol
-		/// (or the closest thing we have to that).
-		/// Multiple addresses may belong to the same symbol.
-		Address  address;
-
-		std::wstring procname;
-		FileID       sourcefile;
-		ModuleID     module;
-
-		bool isCollapseFunction;
-		bool isCollapseModule;
-	};
-
-	/// Represents one address we encountered during profiling
-	struct AddrInfo
-	{
-		AddrInfo() : symbol(NULL), sourceline(0), count(0), percentage(0) {}
-
-		// Symbol info
-		const Symbol *symbol;
-		unsigned      sourceline;
-
-		// IP counts
-		double count;
-		float  percentage;
-	};
-
-	struct Item
-	{
-		const Symbol *symbol;
-
-		/// Might be different from symbol->address
-		/// (e.g. it's the call site for callstacks).
-		Address address;
-
-		double inclusive, exclusive;
-	};
-
-	struct List
-	{
-		List() { totalcount = 0; }
-
-		std::vector<Item> items;
-		double totalcount;
-	};
-
-	struct CallStack
-	{
-		std::vector<Address> addresses;
-
-		// symbols[i] == addrsymbols[addresses[i]]. For convenience/performance.
-		std::vector<const Symbol *> symbols;
-
-		double samplecount;
-	};
-
-	Database();
-	virtual ~Database();
-	void clear();
-
-	void loadFromPath(const std::wstring& profilepath,bool collapseOSCalls,bool loadMinidump);
-	void reload(bool collapseOSCalls, bool loadMinidump);
-
-	const Symbol *getSymbol(Symbol::ID id) const { return symbols[id]; }
-	Symbol::ID getSymbolCount() const { return symbols.size(); }
-	const std::wstring &getFileName(FileID id) const { return files[id]; }
-	FileID getFileCount() const { return files.size(); }
-	const std::wstring &getModuleName(ModuleID id) const { return modules[id]; }
-	ModuleID getModuleCount() const { return modules.size(); }
-
-	const AddrInfo *getAddrInfo(Address addr) { return &addrinfo.at(addr); }
-
-	void setRoot(const Symbol *root);
-	const Symbol *getRoot() const { return currentRoot; }
-
-	const List &getMainList() const { return mainList; }
-	List getCallers(const Symbol *symbol) const;
-	List getCallees(const Symbol *symbol) const;
-	std::vector<const CallStack*> getCallstacksContaining(const Symbol *symbol) const;
-	std::vector<double> getLineCounts(FileID sourcefile);
-
-	std::vector<std::wstring> stats;
-
-	std::wstring getProfilePath() const { return profilepath; }
-
-	bool has_minidump;
-
-private:
-	/// Symbol::ID -> Symbol*
-	std::vector<Symbol *> symbols;
-
-	/// filename <-> FileID
-	std::vector<std::wstring> files;
-	std::unordered_map<std::wstring, FileID> filemap;
-
-	/// module name <-> ModuleID
-	std::vector<std::wstring> modules;
-	std::unordered_map<std::wstring, ModuleID> modulemap;
-
-	/// Address -> module/procname/sourcefile/sourceline
-	std::unordered_map<Address, AddrInfo> addrinfo;
-
-	std::vector<CallStack> callstacks;
-	List mainList;
-	std::wstring profilepath;
-	const Symbol *currentRoot;
-
-	void loadSymbols(wxInputStream &file);
-	void loadCallstacks(wxInputStream &file,bool collapseKernelCalls);
-	void loadIpCounts(wxInputStream &file);
-	void loadStats(wxInputStream &file);
-	void loadMinidump(wxInputStream &file);
-	void scanMainList();
-
-	bool includeCallstack(const CallStack &callstack) const;
-
-	// Any additional symbols we can load after opening a capture
-	class LateSymbolInfo *late_sym_info;
-};
-
-#endif //__DATABASE_H_666_
+/*=====================================================================
+database.h
+----------
+
+Copyright (C) Nicholas Chapman
+Copyright (C) Richard Mitton
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+#ifndef __DATABASE_H_666_
+#define __DATABASE_H_666_
+
+#include "profilergui.h"
+#include "../utils/container.h"
+#include "../utils/histogram.h"
+#include "../utils/demangler.h"
+#include "../profiler/captureformat.h"
+#include "captureindex.h"
+#include <set>
+
+bool IsOsFunction(wxString proc);
+void AddOsFunction(wxString proc);
+void RemoveOsFunction(wxString proc);
+
+bool IsOsModule(wxString mod);
+void AddOsModule(wxString mod);
+void RemoveOsModule(wxString mod);
+
+/*=====================================================================
+Database
+--------
+
+=====================================================================*/
+class Database
+{
+public:
+	typedef unsigned long long Address;
+	typedef size_t FileID;
+	typedef size_t ModuleID;
+
+	/// Represents one function (as it appears in function lists).
+	struct Symbol
+	{
+		/// Note: IDs may not persist across DB reloads
+		/// (e.g. due to changes in symbol load settings).
+		/// Use addresses to persistently refer to symbols in the GUI.
+		typedef size_t ID;
+		ID id;
+
+		/// Points to the address of the start of the symbol
+		/// (or the closest thing we have to that).
+		/// Multiple addresses may belong to the same symbol.
+		Address  address;
+
+		std::wstring procname;
+		FileID       sourcefile;
+		ModuleID     module;
+
+		bool isCollapseFunction;
+		bool isCollapseModule;
+	};
+
+	/// Represents one address we encountered during profiling
+	struct AddrInfo
+	{
+		AddrInfo() : symbol(NULL), sourceline(0), count(0), percentage(0) {}
+
+		// Symbol info
+		const Symbol *symbol;
+		unsigned      sourceline;
+
+		// IP counts
+		double count;
+		float  percentage;
+	};
+
+	struct Item
+	{
+		const Symbol *symbol;
+
+		/// Might be different from symbol->address
+		/// (e.g. it's the call site for callstacks).
+		Address address;
+
+		double inclusive, exclusive;
+	};
+
+	struct List
+	{
+		List() { totalcount = 0; }
+
+		std::vector<Item> items;
+		double totalcount;
+	};
+
+	struct CallStack
+	{
+		std::vector<Address> addresses;
+
+		// symbols[i] == addrsymbols[addresses[i]]. For convenience/performance.
+		std::vector<const Symbol *> symbols;
+
+		/// Restricted to the samples let through by the sample filter, if any.
+		double samplecount;
+		/// Every sample, regardless of the sample filter.
+		double unfilteredcount;
+	};
+
+	/// One entry of the capture's sample log.
+	struct Sample
+	{
+		double   time;   ///< Seconds since the capture started
+		unsigned thread; ///< Thread ID
+		size_t   stack;  ///< Index into callstacks
+		double   weight;
+	};
+
+	/// Restricts every view to the samples taken within a time window
+	/// and/or on some threads. Needs a capture with a sample log.
+	struct SampleFilter
+	{
+		SampleFilter() : start(0), end(-1) {}
+
+		/// Seconds since the capture started. end < 0 means until the end.
+		double start, end;
+		/// Thread IDs. Empty means every thread.
+		std::set<unsigned> threads;
+
+		bool isActive() const { return start > 0 || end >= 0 || !threads.empty(); }
+		bool includes(const Sample &sample) const
+		{
+			return sample.time >= start
+				&& (end < 0 || sample.time <= end)
+				&& (threads.empty() || threads.count(sample.thread));
+		}
+		bool operator==(const SampleFilter &other) const
+		{
+			return start == other.start && end == other.end && threads == other.threads;
+		}
+	};
+
+	Database();
+	virtual ~Database();
+	void clear();
+
+	void loadFromPath(const std::wstring& profilepath,bool collapseOSCalls,bool groupTemplates,bool loadMinidump);
+	void reload(bool collapseOSCalls, bool groupTemplates, bool loadMinidump);
+
+	const Symbol *getSymbol(Symbol::ID id) const { return symbols[id]; }
+	Symbol::ID getSymbolCount() const { return symbols.size(); }
+	const std::wstring &getFileName(FileID id) const { return files[id]; }
+	FileID getFileCount() const { return files.size(); }
+	const std::wstring &getModuleName(ModuleID id) const { return modules[id]; }
+	ModuleID getModuleCount() const { return modules.size(); }
+
+	const AddrInfo *getAddrInfo(Address addr) { return &addrinfo.at(addr); }
+
+	void setRoot(const Symbol *root);
+	const Symbol *getRoot() const { return currentRoot; }
+
+	const List &getMainList() const { return mainList; }
+	List getCallers(const Symbol *symbol) const;
+	List getCallees(const Symbol *symbol) const;
+	std::vector<const CallStack*> getCallstacksContaining(const Symbol *symbol) const;
+	std::vector<double> getLineCounts(FileID sourcefile);
+
+	bool hasSampleLog() const { return !samples.empty(); }
+	/// IDs of the threads in the sample log, in order of their first sample.
+	const std::vector<unsigned> &getSampleThreads() const { return sampleThreads; }
+	double getSampleLogDuration() const { return samples.empty() ? 0 : samples.back().time; }
+
+	/// Kept across reloads. Source line counts are not affected.
+	const SampleFilter &getSampleFilter() const { return sampleFilter; }
+	void setSampleFilter(const SampleFilter &filter);
+
+	std::vector<std::wstring> stats;
+
+	/// Per-sample profiler overhead recorded during the capture (in nanoseconds).
+	struct Latency
+	{
+		std::wstring name;
+		LogHistogram histogram;
+	};
+	std::vector<Latency> latency;
+
+	std::wstring getProfilePath() const { return profilepath; }
+
+	bool has_minidump;
+
+private:
+	/// Symbol::ID -> Symbol*
+	std::vector<Symbol *> symbols;
+
+	/// filename <-> FileID
+	std::vector<std::wstring> files;
+	std::unordered_map<std::wstring, FileID> filemap;
+
+	/// module name <-> ModuleID
+	std::vector<std::wstring> modules;
+	std::unordered_map<std::wstring, ModuleID> modulemap;
+
+	/// Address -> module/procname/sourcefile/sourceline
+	std::unordered_map<Address, AddrInfo> addrinfo;
+
+	/// Address -> the addresses standing for functions inlined there,
+	/// innermost first; each stack frame at the address expands into them.
+	std::unordered_map<Address, std::vector<Address> > inlines;
+
+	/// Modules.txt: where the target's modules were, and which builds.
+	/// When deferred, Symbols.bin holds only addresses, and they are
+	/// looked up from these (once; the capture is then rewritten).
+	std::vector<std::wstring> moduleRecords;
+	bool modules64Bit;
+	bool symbolsDeferred;
+
+	/// Symbols.bin's address table, which IPCounts.bin and Callstacks.bin index.
+	std::vector<Address> addrTable;
+
+	std::vector<CallStack> callstacks;
+	/// Stack ID (or line of Callstacks.txt) -> index into callstacks, which are merged and sorted
+	std::vector<size_t> stackmap;
+	/// The stacks by ID, inlines expanded but nothing collapsed, until saved to the index.
+	std::vector<CaptureIndex::StackRecord> rawStacks;
+	std::vector<Address> rawFrames;
+
+	/// Sorted by time
+	std::vector<Sample> samples;
+	std::vector<unsigned> sampleThreads;
+	SampleFilter sampleFilter;
+
+	/// Names as symbolizers gave them -> as displayed. Kept across reloads.
+	Demangler demangler;
+	/// Whether template instantiations are shown as one symbol.
+	bool groupTemplates;
+
+	List mainList;
+	std::wstring profilepath;
+	const Symbol *currentRoot;
+
+	void loadModules(wxInputStream &file);
+	void resolveSymbols(const std::vector<unsigned char> &data, std::vector<unsigned char> &symbolsOut);
+
+	// Format 0.90's text entries.
+	void loadSymbols(const std::vector<unsigned char> &data);
+	void loadCallstacks(const std::vector<unsigned char> &data,bool collapseKernelCalls);
+	void loadIpCounts(const std::vector<unsigned char> &data);
+
+	// Their binary replacements; see CaptureEncoder.
+	void loadSymbolsBin(const std::vector<unsigned char> &data);
+	void loadCallstacksBin(const std::vector<unsigned char> &data,bool collapseKernelCalls);
+	void loadIpCountsBin(const std::vector<unsigned char> &data);
+
+	/// Addresses with the same module, source file and (displayed) name
+	/// belong to one symbol. Names are interned, so the key is just IDs.
+	struct SymbolKey
+	{
+		ModuleID module;
+		FileID file;
+		const std::wstring *procname; ///< into LocSymbols::procnames
+		bool operator==(const SymbolKey &other) const { return module == other.module && file == other.file && procname == other.procname; }
+	};
+	struct SymbolKeyHash
+	{
+		size_t operator()(const SymbolKey &key) const { return (key.module * 31 + key.file) * 1000003 ^ (size_t)key.procname; }
+	};
+	struct LocSymbols
+	{
+		std::unordered_set<std::wstring> procnames;
+		std::unordered_map<SymbolKey, const Symbol*, SymbolKeyHash> symbols;
+	};
+	/// Returns false if addr already has a symbol.
+	bool addSymbol(Address addr, std::wstring &modulename, std::wstring &procname, std::wstring &sourcefilename,
+				   unsigned sourceline, LocSymbols &locsymbols);
+	/// The symbol for key, created with addr as its start if it's the first.
+	const Symbol *getSymbol(const SymbolKey &key, Address addr, LocSymbols &locsymbols);
+	/// frames is innermost first.
+	void addCallstack(double samplecount, const std::vector<Address> &frames, bool collapseKernelCalls);
+	/// Moves from callstack.
+	void addExpandedCallstack(CallStack &callstack, bool collapseKernelCalls);
+	void sortCallstacks(class wxProgressDialog &progressdlg);
+	void addIpCount(Address addr, double count, double totalcount);
+
+	void loadIndex(const CaptureIndex &index, bool collapseKernelCalls);
+	void saveIndex(unsigned options);
+
+	void loadStats(wxInputStream &file);
+	void loadLatency(wxInputStream &file);
+	void loadSampleLog(const std::vector<unsigned char> &data);
+	void applySampleFilter();
+	void loadMinidump(wxInputStream &file);
+	void scanMainList();
+
+	bool includeCallstack(const CallStack &callstack) const;
+
+	// Any additional symbols we can load after opening a capture
+	class LateSymbolInfo *late_sym_info;
+};
+
+#endif //__DATABASE_H_666_
@@ -1,174 +1,316 @@
-/*=====================================================================
-latesymbolinfo.cpp
---------------
-Copyright (C) Vladimir Panteleev
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html..
-=====================================================================*/
-
-#include "latesymbolinfo.h"
-#include <Dbgeng.h>
-#include "../utils/dbginterface.h"
-#include <comdef.h>
-#include <sstream>
-#include "../utils/except.h"
-
-#include "profilergui.h"
-
-void comenforce(HRESULT result, const char* where = NULL)
-{
-	if (result == S_OK)
-		return;
-
-	std::wostringstream message;
-	if (where)
-		message << where;
-
-	_com_error error(result);
-	message << ": " << error.ErrorMessage();
-	message << " (error " << result << ")";
-
-	throw SleepyException(message.str());
-}
-
-
-LateSymbolInfo::LateSymbolInfo()
-	:	debugClient5(NULL), debugControl4(NULL), debugSymbols3(NULL)
-{
-}
-
-LateSymbolInfo::~LateSymbolInfo()
-{
-	unloadMinidump();
-}
-
-// Send debugger output to the wxWidgets current logging facility.
-// The UI implements a logging facility in the form of a log panel.
-struct DebugOutputCallbacksWide : public IDebugOutputCallbacksWide
-{
-	HRESULT	STDMETHODCALLTYPE QueryInterface(__in REFIID WXUNUSED(InterfaceId), __out PVOID* WXUNUSED(Interface)) { return E_NOINTERFACE; }
-	ULONG	STDMETHODCALLTYPE AddRef() { return 1; }
-	ULONG	STDMETHODCALLTYPE Release() { return 0; }
-
-	HRESULT	STDMETHODCALLTYPE Output(__in ULONG WXUNUSED(Mask), __in PCWSTR Text)
-	{
-		//OutputDebugStringW(Text);
-		wxLogMessage(L"%s", Text);
-		return S_OK;
-	}
-};
-
-static DebugOutputCallbacksWide *debugOutputCallbacks = new DebugOutputCallbacksWide();
-
-void LateSymbolInfo::loadMinidump(std::wstring& dumppath, bool delete_when_done)
-{
-	// Method credit to http://stackoverflow.com/a/8119364/21501
-
-	if (debugClient5 || debugControl4 || debugSymbols3)
-	{
-		//throw SleepyException(L"Minidump symbols already loaded.");
-
-		// maybe the user moved a .pdb to somewhere where we can now find it?
-		unloadMinidump();
-	}
-
-	IDebugClient *debugClient = NULL;
-
-	SetLastError(0);
-	comenforce(DebugCreate(__uuidof(IDebugClient), (void**)&debugClient), "DebugCreate");
-	comenforce(debugClient->QueryInterface(__uuidof(IDebugClient5 ), (void**)&debugClient5 ), "QueryInterface(IDebugClient5)" );
-	comenforce(debugClient->QueryInterface(__uuidof(IDebugControl4), (void**)&debugControl4), "QueryInterface(IDebugControl4)");
-	comenforce(debugClient->QueryInterface(__uuidof(IDebugSymbols3), (void**)&debugSymbols3), "QueryInterface(IDebugSymbols3)");
-	comenforce(debugClient5->SetOutputCallbacksWide(debugOutputCallbacks), "IDebugClient5::SetOutputCallbacksWide");
-	comenforce(debugSymbols3->SetSymbolOptions(SYMOPT_UNDNAME | SYMOPT_LOAD_LINES | SYMOPT_OMAP_FIND_NEAREST | SYMOPT_AUTO_PUBLICS | SYMOPT_DEBUG), "IDebugSymbols::SetSymbolOptions");
-
-	std::wstring sympath;
-	prefs.AdjustSymbolPath(sympath, true);
-
-	comenforce(debugSymbols3->SetSymbolPathWide(sympath.c_str()), "IDebugSymbols::SetSymbolPath");
-	comenforce(debugClient5->OpenDumpFileWide(dumppath.c_str(), NULL), "IDebugClient4::OpenDumpFileWide");
-	comenforce(debugControl4->WaitForEvent(0, INFINITE), "IDebugControl::WaitForEvent");
-
-	// Since we can't just enumerate all symbols in all modules referenced by the minidump,
-	// we have to keep the debugger session open and query symbols as requested by the
-	// profiler GUI.
-
-	debugClient->Release(); // but keep the other ones
-
-	// If we are given a temporary file, clean it up later
-	if (delete_when_done)
-		file_to_delete = dumppath;
-}
-
-void LateSymbolInfo::unloadMinidump()
-{
-	if (debugClient5)
-	{
-		debugClient5->EndSession(DEBUG_END_ACTIVE_TERMINATE);
-		debugClient5->Release();
-		debugClient5 = NULL;
-	}
-	if (debugControl4)
-	{
-		debugControl4->Release();
-		debugControl4 = NULL;
-	}
-	if (debugSymbols3)
-	{
-		debugSymbols3->Release();
-		debugSymbols3 = NULL;
-	}
-
-	if (!file_to_delete.empty())
-	{
-		wxRemoveFile(file_to_delete);
-		file_to_delete.clear();
-	}
-}
-
-wchar_t LateSymbolInfo::buffer[4096];
-
-void LateSymbolInfo::filterSymbol(Database::Address address, std::wstring &module, std::wstring &procname, std::wstring &sourcefile, unsigned &sourceline)
-{
-	if (debugSymbols3)
-	{
-		ULONG moduleindex;
-		if (debugSymbols3->GetModuleByOffset(address, 0, &moduleindex, NULL) == S_OK)
-			if (debugSymbols3->GetModuleNameStringWide(DEBUG_MODNAME_MODULE, moduleindex, 0, buffer, _countof(buffer), NULL) == S_OK)
-				module = buffer;
-
-		if (debugSymbols3->GetNameByOffsetWide(address, buffer, _countof(buffer), NULL, NULL) == S_OK)
-		{
-			if (module.compare(buffer) != 0)
-			{
-				procname = buffer;
-
-				// Remove redundant "Module!" prefix
-				size_t modlength = module.length();
-				if (procname.length() > modlength+1 && module.compare(0, modlength, procname, 0, modlength)==0 && procname[modlength] == '!')
-					procname.erase(0, modlength+1);
-			}
-		}
-
-		ULONG line;
-		if (debugSymbols3->GetLineByOffsetWide(address, &line, buffer, _countof(buffer), NULL, NULL) == S_OK)
-		{
-			sourcefile = buffer;
-			sourceline = line;
-		}
-	}
-}
+/*=====================================================================
+latesymbolinfo.cpp
+--------------
+Copyright (C) Vladimir Panteleev
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#include "latesymbolinfo.h"
+#include <Dbgeng.h>
+#include "../utils/dbginterface.h"
+#include <comdef.h>
+#include <sstream>
+#include "../utils/except.h"
+#include "../utils/stringutils.h"
+
+#include "profilergui.h"
+
+void comenforce(HRESULT result, const char* where = NULL)
+{
+	if (result == S_OK)
+		return;
+
+	std::wostringstream message;
+	if (where)
+		message << where;
+
+	_com_error error(result);
+	message << ": " << error.ErrorMessage();
+	message << " (error " << result << ")";
+
+	throw SleepyException(message.str());
+}
+
+
+LateSymbolInfo::LateSymbolInfo()
+	:	last_module(NULL),
+		num_lookups(0), num_cache_hits(0), num_function_hits(0), num_engine_names(0),
+		debugClient5(NULL), debugControl4(NULL), debugSymbols3(NULL)
+{
+}
+
+LateSymbolInfo::~LateSymbolInfo()
+{
+	unloadMinidump();
+}
+
+// Send debugger output to the wxWidgets current logging facility.
+// The UI implements a logging facility in the form of a log panel.
+struct DebugOutputCallbacksWide : public IDebugOutputCallbacksWide
+{
+	HRESULT	STDMETHODCALLTYPE QueryInterface(__in REFIID WXUNUSED(InterfaceId), __out PVOID* WXUNUSED(Interface)) { return E_NOINTERFACE; }
+	ULONG	STDMETHODCALLTYPE AddRef() { return 1; }
+	ULONG	STDMETHODCALLTYPE Release() { return 0; }
+
+	HRESULT	STDMETHODCALLTYPE Output(__in ULONG WXUNUSED(Mask), __in PCWSTR Text)
+	{
+		//OutputDebugStringW(Text);
+		wxLogMessage(L"%s", Text);
+		return S_OK;
+	}
+};
+
+static DebugOutputCallbacksWide *debugOutputCallbacks = new DebugOutputCallbacksWide();
+
+void LateSymbolInfo::loadMinidump(std::wstring& dumppath, bool delete_when_done)
+{
+	// Method credit to http://stackoverflow.com/a/8119364/21501
+
+	if (debugClient5 || debugControl4 || debugSymbols3)
+	{
+		//throw SleepyException(L"Minidump symbols already loaded.");
+
+		// maybe the user moved a .pdb to somewhere where we can now find it?
+		unloadMinidump();
+	}
+
+	IDebugClient *debugClient = NULL;
+
+	SetLastError(0);
+	comenforce(DebugCreate(__uuidof(IDebugClient), (void**)&debugClient), "DebugCreate");
+	comenforce(debugClient->QueryInterface(__uuidof(IDebugClient5 ), (void**)&debugClient5 ), "QueryInterface(IDebugClient5)" );
+	comenforce(debugClient->QueryInterface(__uuidof(IDebugControl4), (void**)&debugControl4), "QueryInterface(IDebugControl4)");
+	comenforce(debugClient->QueryInterface(__uuidof(IDebugSymbols3), (void**)&debugSymbols3), "QueryInterface(IDebugSymbols3)");
+	comenforce(debugClient5->SetOutputCallbacksWide(debugOutputCallbacks), "IDebugClient5::SetOutputCallbacksWide");
+	comenforce(debugSymbols3->SetSymbolOptions(SYMOPT_UNDNAME | SYMOPT_LOAD_LINES | SYMOPT_OMAP_FIND_NEAREST | SYMOPT_AUTO_PUBLICS | SYMOPT_DEBUG), "IDebugSymbols::SetSymbolOptions");
+
+	std::wstring sympath;
+	prefs.AdjustSymbolPath(sympath, true);
+
+	comenforce(debugSymbols3->SetSymbolPathWide(sympath.c_str()), "IDebugSymbols::SetSymbolPath");
+	comenforce(debugClient5->OpenDumpFileWide(dumppath.c_str(), NULL), "IDebugClient4::OpenDumpFileWide");
+	comenforce(debugControl4->WaitForEvent(0, INFINITE), "IDebugControl::WaitForEvent");
+
+	// Since we can't just enumerate all symbols in all modules referenced by the minidump,
+	// we have to keep the debugger session open and query symbols as requested by the
+	// profiler GUI.
+
+	debugClient->Release(); // but keep the other ones
+
+	// If we are given a temporary file, clean it up later
+	if (delete_when_done)
+		file_to_delete = dumppath;
+
+	if (!prefs.symCacheDir.empty())
+	{
+		std::wstring dir = prefs.symCacheDir.wc_str();
+		symbol_cache.setDirectory(toUtf8(dir + L"\\SleepySymbols"));
+	}
+}
+
+void LateSymbolInfo::unloadMinidump()
+{
+	symbol_cache.save();
+	loaded_modules.clear();
+	last_module = NULL;
+
+	if (debugClient5)
+	{
+		debugClient5->EndSession(DEBUG_END_ACTIVE_TERMINATE);
+		debugClient5->Release();
+		debugClient5 = NULL;
+	}
+	if (debugControl4)
+	{
+		debugControl4->Release();
+		debugControl4 = NULL;
+	}
+	if (debugSymbols3)
+	{
+		debugSymbols3->Release();
+		debugSymbols3 = NULL;
+	}
+
+	if (!file_to_delete.empty())
+	{
+		wxRemoveFile(file_to_delete);
+		file_to_delete.clear();
+	}
+}
+
+wchar_t LateSymbolInfo::buffer[4096];
+
+CachedSymbols *LateSymbolInfo::getCachedSymbols(ULONG64 module_base, const std::wstring &module, ULONG64 *size)
+{
+	CachedSymbols *cached = NULL;
+	DEBUG_MODULE_PARAMETERS params;
+	*size = 0;
+	if (debugSymbols3->GetModuleParameters(1, &module_base, 0, &params) == S_OK)
+	{
+		*size = params.Size;
+		if (params.TimeDateStamp)
+		{
+			wchar_t key[64];
+			swprintf(key, 64, L"-%08X%X-dbgeng%u", params.TimeDateStamp, params.Size, params.SymbolType);
+			cached = symbol_cache.getModule(toUtf8(module + key));
+		}
+	}
+	return cached;
+}
+
+LateSymbolInfo::LoadedModule *LateSymbolInfo::getModule(Database::Address address)
+{
+	if (last_module && address >= last_module->base && address < last_module->end)
+		return last_module;
+
+	std::map<ULONG64, LoadedModule>::iterator it = loaded_modules.upper_bound(address);
+	if (it != loaded_modules.begin() && address < (--it)->second.end)
+		return last_module = &it->second;
+
+	ULONG moduleindex;
+	ULONG64 modulebase = 0;
+	if (debugSymbols3->GetModuleByOffset(address, 0, &moduleindex, &modulebase) != S_OK ||
+		debugSymbols3->GetModuleNameStringWide(DEBUG_MODNAME_MODULE, moduleindex, 0, buffer, _countof(buffer), NULL) != S_OK)
+		return NULL;
+
+	bool inserted;
+	LoadedModule &module = map_emplace(loaded_modules, modulebase, &inserted);
+	if (inserted)
+	{
+		ULONG64 size;
+		module.base = modulebase;
+		module.name = buffer;
+		module.cached = getCachedSymbols(modulebase, module.name, &size);
+		module.end = modulebase + size;
+	}
+
+	// Without a size, only the addresses asked about are known to be in it.
+	if (module.end <= address)
+		module.end = address + 1;
+	return last_module = &module;
+}
+
+const LateSymbolInfo::Function *LateSymbolInfo::getFunction(LoadedModule &module, Database::Address address)
+{
+	std::map<ULONG64, Function>::iterator it = module.functions.upper_bound(address);
+	if (it != module.functions.begin() && address < (--it)->second.end)
+	{
+		num_function_hits++;
+		return &it->second;
+	}
+
+	num_engine_names++;
+	std::wstring name;
+	if (debugSymbols3->GetNameByOffsetWide(address, buffer, _countof(buffer), NULL, NULL) == S_OK &&
+		module.name.compare(buffer) != 0)
+	{
+		name = buffer;
+
+		// Remove redundant "Module!" prefix
+		size_t modlength = module.name.length();
+		if (name.length() > modlength+1 && module.name.compare(0, modlength, name, 0, modlength)==0 && name[modlength] == '!')
+			name.erase(0, modlength+1);
+	}
+
+	// Only the symbol's extent lets later addresses skip the engine;
+	// without it, just this address is known.
+	ULONG64 start = address, end = address + 1;
+	DEBUG_MODULE_AND_ID id;
+	ULONG64 displacement;
+	ULONG found = 0;
+	DEBUG_SYMBOL_ENTRY entry;
+	if (debugSymbols3->GetSymbolEntriesByOffset(address, 0, &id, &displacement, 1, &found) == S_OK && found &&
+		debugSymbols3->GetSymbolEntryInformation(&id, &entry) == S_OK &&
+		entry.Size && address >= entry.Offset && address < entry.Offset + entry.Size)
+	{
+		start = entry.Offset;
+		end = entry.Offset + entry.Size;
+	}
+
+	Function &function = module.functions[start];
+	function.end = end;
+	function.name = name;
+	return &function;
+}
+
+void LateSymbolInfo::filterSymbol(Database::Address address, std::wstring &module, std::wstring &procname, std::wstring &sourcefile, unsigned &sourceline)
+{
+	if (debugSymbols3)
+	{
+		num_lookups++;
+
+		LoadedModule *loaded = getModule(address);
+		CachedSymbols *cached = NULL;
+		ULONG64 modulebase = 0;
+		if (loaded)
+		{
+			module = loaded->name;
+			cached = loaded->cached;
+			modulebase = loaded->base;
+		}
+
+		// Empty strings in the cache stand for what dbgeng couldn't find.
+		unsigned rva = (unsigned)(address - modulebase);
+		std::string cached_proc, cached_file;
+		unsigned cached_line;
+		if (cached && cached->findAddr(rva, cached_proc, cached_file, cached_line))
+		{
+			num_cache_hits++;
+			if (!cached_proc.empty())
+				procname = fromUtf8(cached_proc);
+			if (!cached_file.empty())
+			{
+				sourcefile = fromUtf8(cached_file);
+				sourceline = cached_line;
+			}
+			return;
+		}
+
+		std::wstring found_proc, found_file;
+		ULONG found_line = 0;
+
+		// Lines differ within a function, so they're still asked for.
+		if (loaded)
+		{
+			found_proc = getFunction(*loaded, address)->name;
+			if (!found_proc.empty())
+				procname = found_proc;
+		}
+
+		if (debugSymbols3->GetLineByOffsetWide(address, &found_line, buffer, _countof(buffer), NULL, NULL) == S_OK)
+		{
+			found_file = buffer;
+			sourcefile = found_file;
+			sourceline = found_line;
+		}
+
+		if (cached)
+			cached->addAddr(rva, toUtf8(found_proc), toUtf8(found_file), found_line);
+	}
+}
+
+void LateSymbolInfo::logStats()
+{
+	if (!num_lookups)
+		return;
+
+	wxLogMessage(L"Minidump symbols: %llu addresses, %llu from the symbol cache, "
+				 L"%llu named from functions already looked up, %llu by the debugger engine\n",
+				 num_lookups, num_cache_hits, num_function_hits, num_engine_names);
+	num_lookups = num_cache_hits = num_function_hits = num_engine_names = 0;
+}
@@ -1,56 +1,93 @@
-/*=====================================================================
-latesymbolinfo.h
---------------
-Copyright (C) Vladimir Panteleev
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html..
-=====================================================================*/
-
-#pragma once
-
-#include <string>
-#include <windows.h>
-#include "database.h"
-
-/*=====================================================================
-LateSymbolInfo
-----------
-Handles symbols we load after loading a profile capture,
-e.g. symbols loaded from included minidumps.
-=====================================================================*/
-class LateSymbolInfo
-{
-public:
-	LateSymbolInfo();
-	~LateSymbolInfo();
-
-	void loadMinidump(std::wstring &dumppath, bool delete_when_done);
-	void unloadMinidump();
-
-	void filterSymbol(Database::Address address, std::wstring &module, std::wstring &procname, std::wstring &sourcefile, unsigned &sourceline);
-
-private:
-	static wchar_t buffer[4096];
-	std::wstring file_to_delete;
-
-	// Dbgeng COM objects for minidump symbols
-	struct IDebugClient5  *debugClient5;
-	struct IDebugControl4 *debugControl4;
-	struct IDebugSymbols3 *debugSymbols3;
-
-
-};
+/*=====================================================================
+latesymbolinfo.h
+--------------
+Copyright (C) Vladimir Panteleev
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html..
+=====================================================================*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <windows.h>
+#include "database.h"
+#include "../profiler/symbolcache.h"
+
+/*=====================================================================
+LateSymbolInfo
+----------
+Handles symbols we load after loading a profile capture,
+e.g. symbols loaded from included minidumps.
+=====================================================================*/
+class LateSymbolInfo
+{
+public:
+	LateSymbolInfo();
+	~LateSymbolInfo();
+
+	void loadMinidump(std::wstring &dumppath, bool delete_when_done);
+	void unloadMinidump();
+
+	void filterSymbol(Database::Address address, std::wstring &module, std::wstring &procname, std::wstring &sourcefile, unsigned &sourceline);
+	/// Whether filterSymbol might change anything; it can't without a minidump.
+	bool isFiltering() const { return debugSymbols3 != NULL; }
+
+	/// Log how many lookups since the last call went to the debugger
+	/// engine, and how many were answered from what it said before.
+	void logStats();
+
+private:
+	static wchar_t buffer[4096];
+	std::wstring file_to_delete;
+
+	// What the minidump's symbols said about addresses in earlier sessions.
+	SymbolCache symbol_cache;
+
+	// Functions already looked up in a module, by start address. An
+	// address inside one of them needs no trip to the engine for its name.
+	struct Function
+	{
+		ULONG64 end;
+		std::wstring name; // empty if the engine only knew the module
+	};
+
+	struct LoadedModule
+	{
+		ULONG64 base, end;
+		std::wstring name;
+		CachedSymbols *cached; // NULL if unknown build
+		std::map<ULONG64, Function> functions;
+	};
+
+	// By base. Symbols are in address order, so lookups come a module
+	// at a time; the last module used is tried first.
+	std::map<ULONG64, LoadedModule> loaded_modules;
+	LoadedModule *last_module;
+	LoadedModule *getModule(Database::Address address);
+	CachedSymbols *getCachedSymbols(ULONG64 module_base, const std::wstring &module, ULONG64 *size);
+	const Function *getFunction(LoadedModule &module, Database::Address address);
+
+	unsigned long long num_lookups, num_cache_hits, num_function_hits, num_engine_names;
+
+	// Dbgeng COM objects for minidump symbols
+	struct IDebugClient5  *debugClient5;
+	struct IDebugControl4 *debugControl4;
+	struct IDebugSymbols3 *debugSymbols3;
+
+
+};
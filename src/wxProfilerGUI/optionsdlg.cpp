@@ -1,290 +1,351 @@
-/*=====================================================================
-optionsdlg.cpp
-----------------
-
-Copyright (C) Richard Mitton
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html.
-=====================================================================*/
-#include "optionsdlg.h"
-#include <wx/filepicker.h>
-#include <wx/msw/wrapcctl.h> // include <commctrl.h> "properly"
-#include <wx/valnum.h>
-#include <wx/slider.h>
-#include <wx/stattext.h>
-
-class wxPercentSlider : public wxSlider
-{
-public:
-	wxPercentSlider(wxWindow *parent,
-			wxWindowID id,
-			int value,
-			int minValue,
-			int maxValue,
-			const wxPoint& pos = wxDefaultPosition,
-			const wxSize& size = wxDefaultSize,
-			long style = wxSL_HORIZONTAL,
-			const wxValidator& validator = wxDefaultValidator,
-			const wxString& name = wxSliderNameStr)
-	{
-		Init();
-
-		Create(parent, id, value, minValue, maxValue, pos, size, style, validator, name);
-	}
-
-protected:
-
-	// RJM- had to modify the wxWidgets source slightly to get this to work :-/
-	// Just go into include/wx/msw/slider.h, and change the definition of this
-	// from 'static' to 'virtual', and add a const modifier. Then you have to do
-	// a full 'make clean' and rebuild for it to take.
-	virtual wxString Format(int n) const { return wxString::Format(wxT("%d%%"), n); }
-};
-
-enum OptionsId
-{
-	Options_UseSymServer = 1,
-	Options_Throttle,
-	Options_SymPath,
-	Options_SymPath_Add,
-	Options_SymPath_Remove,
-	Options_SymPath_MoveUp,
-	Options_SymPath_MoveDown,
-	Options_SaveMinidump,
-};
-
-BEGIN_EVENT_TABLE(OptionsDlg, wxDialog)
-EVT_BUTTON(wxID_OK, OptionsDlg::OnOk)
-EVT_CHECKBOX(Options_UseSymServer, OptionsDlg::OnUseSymServer)
-EVT_LISTBOX(Options_SymPath, OptionsDlg::OnSymPath)
-EVT_BUTTON(Options_SymPath_Add, OptionsDlg::OnSymPathAdd)
-EVT_BUTTON(Options_SymPath_Remove, OptionsDlg::OnSymPathRemove)
-EVT_BUTTON(Options_SymPath_MoveUp, OptionsDlg::OnSymPathMoveUp)
-EVT_BUTTON(Options_SymPath_MoveDown, OptionsDlg::OnSymPathMoveDown)
-EVT_CHECKBOX(Options_SaveMinidump, OptionsDlg::OnSaveMinidump)
-END_EVENT_TABLE()
-
-OptionsDlg::OptionsDlg()
-:	wxDialog(NULL, -1, wxString(_T("Options")),
-			 wxDefaultPosition, wxDefaultSize,
-			 wxDEFAULT_DIALOG_STYLE)
-{
-	wxBoxSizer *rootsizer = new wxBoxSizer(wxVERTICAL);
-	wxBoxSizer *topsizer = new wxBoxSizer(wxVERTICAL);
-
-	wxStaticBoxSizer *symsizer = new wxStaticBoxSizer(wxVERTICAL, this, "Symbols");
-	wxStaticBoxSizer *symdirsizer = new wxStaticBoxSizer(wxVERTICAL, this, "Symbol search path");
-	wxStaticBoxSizer *symsrvsizer = new wxStaticBoxSizer(wxVERTICAL, this, "Symbol server");
-
-	symPaths = new wxListBox(this, Options_SymPath, wxDefaultPosition, wxSize(-1, 75), 0, NULL, wxLB_SINGLE | wxLB_NEEDED_SB);
-
-	wxBoxSizer *symPathSizer = new wxBoxSizer(wxHORIZONTAL);
-	wxBoxSizer *symPathButtonSizer = new wxBoxSizer(wxVERTICAL);
-
-	static const struct { wxButton * OptionsDlg::* button; OptionsId id; const wchar_t *icon; const char *tip; } symPathButtons[] = {
-		{ &OptionsDlg::symPathAdd     , Options_SymPath_Add     , L"button_add"   , "Browse for a directory to add" },
-		{ &OptionsDlg::symPathRemove  , Options_SymPath_Remove  , L"button_remove", "Remove selected directory"     },
-		{ &OptionsDlg::symPathMoveUp  , Options_SymPath_MoveUp  , L"button_up"    , "Move selected directory up"    },
-		{ &OptionsDlg::symPathMoveDown, Options_SymPath_MoveDown, L"button_down"  , "Move selected directory down"  },
-	};
-	for (size_t n=0; n<_countof(symPathButtons); n++)
-	{
-		wxButton *b = this->*symPathButtons[n].button = new wxButton(
-			this,
-			symPathButtons[n].id,
-			wxEmptyString,
-			wxDefaultPosition,
-			wxSize(20, 20),
-			wxBU_EXACTFIT);
-		b->SetBitmap(LoadPngResource(symPathButtons[n].icon));
-		b->SetToolTip(symPathButtons[n].tip);
-		symPathButtonSizer->Add(b, 1);
-	}
-	UpdateSymPathButtons();
-
-	symPathSizer->Add(symPaths, 100, wxEXPAND);
-	symPathSizer->Add(symPathButtonSizer, 1, wxSHRINK);
-
-	useSymServer = new wxCheckBox(this, Options_UseSymServer, "Use symbol server");
-	symCacheDir = new wxDirPickerCtrl(this, -1, prefs.symCacheDir, "Select a directory to store local symbols in:",
-		wxDefaultPosition, wxDefaultSize, wxDIRP_USE_TEXTCTRL);
-	symServer = new wxTextCtrl(this, -1, prefs.symServer);
-
-	wxBoxSizer *minGwDbgHelpSizer = new wxBoxSizer(wxHORIZONTAL);
-	minGwDbgHelpSizer->Add(new wxStaticText(this, -1, "MinGW DbgHelp engine:   "));
-
-	mingwWine = new wxRadioButton(this, -1, "Wine  ");
-	mingwWine->SetToolTip("Use Wine's DbgHelp implementation for MinGW symbols (dbghelpw.dll).");
-	minGwDbgHelpSizer->Add(mingwWine);
-
-	mingwDrMingw = new wxRadioButton(this, -1, "Dr. MinGW");
-	mingwDrMingw->SetToolTip("Use Dr. MinGW's DbgHelp implementation for MinGW symbols (dbghelpdr.dll).");
-	minGwDbgHelpSizer->Add(mingwDrMingw);
-
-	(prefs.useWinePref ? mingwWine : mingwDrMingw)->SetValue(true);
-
-	wxBoxSizer *saveMinidumpSizer = new wxBoxSizer(wxHORIZONTAL);
-
-	saveMinidump = new wxCheckBox(this, Options_SaveMinidump, "Save minidump after ");
-	saveMinidump->SetToolTip(
-		"Include a minidump in saved profiling results.\n"
-		"This enables the \"Load symbols from minidump\" option,\n"
-		"which allows profiling an application on a user machine without symbols,\n"
-		"then examining the profile results on a developer machine with symbols.");
-	saveMinidumpSizer->Add(saveMinidump);
-
-	saveMinidumpTimeValue = prefs.saveMinidump < 0 ? 0 : prefs.saveMinidump;
-	saveMinidumpTime = new wxTextCtrl(
-		this, -1,
-		wxEmptyString, wxDefaultPosition,
-		wxSize(40, -1),
-		0,
-		wxIntegerValidator<int>(&saveMinidumpTimeValue));
-	saveMinidumpTime->SetToolTip(
-		"Saving a minidump at the very start of a profiling session\n"
-		"may not work as expected, as not all DLLs may be loaded yet.\n"
-		"You can set a delay after which a minidump will be saved.");
-	saveMinidumpTime->Enable(prefs.saveMinidump >= 0);
-	saveMinidumpSizer->Add(saveMinidumpTime, 0, wxTOP, -3);
-	saveMinidumpSizer->Add(new wxStaticText(this, -1, " seconds"));
-
-	symPaths->Append(wxSplit(prefs.symSearchPath, ';', 0));
-	useSymServer->SetValue(prefs.useSymServer);
-	symCacheDir->Enable(prefs.useSymServer);
-	symServer->Enable(prefs.useSymServer);
-	saveMinidump->SetValue(prefs.saveMinidump >= 0);
-
-	symdirsizer->Add(symPathSizer, 0, wxALL|wxEXPAND, 5);
-
-	symsrvsizer->Add(useSymServer, 0, wxALL, 5);
-	symsrvsizer->Add(new wxStaticText(this, -1, "Local cache directory:"), 0, wxLEFT|wxTOP, 5);
-	symsrvsizer->Add(symCacheDir, 0, wxALL|wxEXPAND, 5);
-	symsrvsizer->Add(new wxStaticText(this, -1, "Symbol server location:"), 0, wxLEFT|wxTOP, 5);
-	symsrvsizer->Add(symServer, 0, wxALL|wxEXPAND, 5);
-
-	symsizer->Add(symdirsizer, 0, wxALL|wxEXPAND, 5);
-	symsizer->Add(symsrvsizer, 0, wxALL|wxEXPAND, 5);
-	symsizer->Add(minGwDbgHelpSizer, 0, wxALL, 5);
-	symsizer->Add(saveMinidumpSizer, 0, wxALL, 5);
-
-	wxStaticBoxSizer *throttlesizer = new wxStaticBoxSizer(wxVERTICAL, this, "Sample rate control");
-	throttle = new wxPercentSlider(this, Options_Throttle, prefs.throttle, 1, 100, wxDefaultPosition, wxDefaultSize,
-		wxSL_HORIZONTAL|wxSL_TICKS|wxSL_TOP|wxSL_LABELS);
-	throttle->SetTickFreq(10);
-	throttlesizer->Add(new wxStaticText(this, -1,
-		"Adjusts the sample rate speed. Useful for doing longer captures\n"
-		"where you wish to reduce the profiler overhead.\n"
-		"Higher values increase accuracy; lower values result in better\n"
-		"performance."), 0, wxALL, 5);
-	throttlesizer->Add(throttle, 0, wxEXPAND|wxLEFT|wxTOP, 5);
-
-	topsizer->Add(symsizer, 0, wxEXPAND|wxALL, 0);
-	topsizer->AddSpacer(5);
-	topsizer->Add(throttlesizer, 0, wxEXPAND|wxALL, 0);
-	rootsizer->Add(topsizer, 1, wxEXPAND|wxLEFT|wxTOP|wxRIGHT, 10);
-	rootsizer->Add(CreateButtonSizer(wxOK|wxCANCEL), 0, wxEXPAND|wxALL, 10);
-	SetSizer(rootsizer);
-	rootsizer->SetSizeHints(this);
-	SetAutoLayout(TRUE);
-
-	SetSize(wxSize(400, -1));
-	Centre();
-}
-
-OptionsDlg::~OptionsDlg()
-{
-}
-
-void OptionsDlg::OnOk(wxCommandEvent& WXUNUSED(event))
-{
-	if ( Validate() && TransferDataFromWindow() )
-	{
-		prefs.symSearchPath = wxJoin(symPaths->GetStrings(), ';', 0);
-		prefs.useSymServer = useSymServer->GetValue();
-		prefs.symCacheDir = symCacheDir->GetPath();
-		prefs.symServer = symServer->GetValue();
-		prefs.useWinePref = mingwWine->GetValue();
-		prefs.saveMinidump = saveMinidump->GetValue() ? saveMinidumpTimeValue : -1;
-		prefs.throttle = throttle->GetValue();
-		EndModal(wxID_OK);
-	}
-}
-
-void OptionsDlg::OnUseSymServer(wxCommandEvent& WXUNUSED(event))
-{
-	bool enabled = useSymServer->GetValue();
-	symCacheDir->Enable(enabled);
-	symServer->Enable(enabled);
-}
-
-void OptionsDlg::UpdateSymPathButtons()
-{
-	int sel = symPaths->GetSelection();
-	symPathRemove  ->Enable(sel >= 0);
-	symPathMoveUp  ->Enable(sel > 0);
-	symPathMoveDown->Enable(sel >= 0 && sel < (int)symPaths->GetCount()-1);
-}
-
-void OptionsDlg::OnSymPath(wxCommandEvent& WXUNUSED(event))
-{
-	UpdateSymPathButtons();
-}
-
-void OptionsDlg::OnSymPathAdd(wxCommandEvent& WXUNUSED(event))
-{
-	wxDirDialog dlg(this, "Select a symbol search path to add");
-	if (dlg.ShowModal()==wxID_OK)
-	{
-		int sel = symPaths->Append(dlg.GetPath());
-		symPaths->Select(sel);
-		UpdateSymPathButtons();
-	}
-}
-
-void OptionsDlg::OnSymPathRemove(wxCommandEvent& WXUNUSED(event))
-{
-	int sel = symPaths->GetSelection();
-	symPaths->Delete(sel);
-	if (sel < (int)symPaths->GetCount())
-		symPaths->Select(sel);
-	UpdateSymPathButtons();
-}
-
-void OptionsDlg::OnSymPathMoveUp(wxCommandEvent& WXUNUSED(event))
-{
-	int sel = symPaths->GetSelection();
-	wxString s = symPaths->GetString(sel);
-	symPaths->Delete(sel);
-	symPaths->Insert(s, sel-1);
-	symPaths->Select(sel-1);
-	UpdateSymPathButtons();
-}
-
-void OptionsDlg::OnSymPathMoveDown(wxCommandEvent& WXUNUSED(event))
-{
-	int sel = symPaths->GetSelection();
-	wxString s = symPaths->GetString(sel);
-	symPaths->Delete(sel);
-	symPaths->Insert(s, sel+1);
-	symPaths->Select(sel+1);
-	UpdateSymPathButtons();
-}
-
-void OptionsDlg::OnSaveMinidump(wxCommandEvent& WXUNUSED(event))
-{
-	saveMinidumpTime->Enable(saveMinidump->IsChecked());
-}
+/*=====================================================================
+optionsdlg.cpp
+----------------
+
+Copyright (C) Richard Mitton
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+#include "optionsdlg.h"
+#include <wx/filepicker.h>
+#include <wx/msw/wrapcctl.h> // include <commctrl.h> "properly"
+#include <wx/valnum.h>
+#include <wx/stattext.h>
+
+enum OptionsId
+{
+	Options_UseSymServer = 1,
+	Options_SymPath,
+	Options_SymPath_Add,
+	Options_SymPath_Remove,
+	Options_SymPath_MoveUp,
+	Options_SymPath_MoveDown,
+	Options_SaveMinidump,
+};
+
+BEGIN_EVENT_TABLE(OptionsDlg, wxDialog)
+EVT_BUTTON(wxID_OK, OptionsDlg::OnOk)
+EVT_CHECKBOX(Options_UseSymServer, OptionsDlg::OnUseSymServer)
+EVT_LISTBOX(Options_SymPath, OptionsDlg::OnSymPath)
+EVT_BUTTON(Options_SymPath_Add, OptionsDlg::OnSymPathAdd)
+EVT_BUTTON(Options_SymPath_Remove, OptionsDlg::OnSymPathRemove)
+EVT_BUTTON(Options_SymPath_MoveUp, OptionsDlg::OnSymPathMoveUp)
+EVT_BUTTON(Options_SymPath_MoveDown, OptionsDlg::OnSymPathMoveDown)
+EVT_CHECKBOX(Options_SaveMinidump, OptionsDlg::OnSaveMinidump)
+END_EVENT_TABLE()
+
+OptionsDlg::OptionsDlg()
+:	wxDialog(NULL, -1, wxString(_T("Options")),
+			 wxDefaultPosition, wxDefaultSize,
+			 wxDEFAULT_DIALOG_STYLE)
+{
+	wxBoxSizer *rootsizer = new wxBoxSizer(wxVERTICAL);
+	wxBoxSizer *topsizer = new wxBoxSizer(wxVERTICAL);
+
+	wxStaticBoxSizer *symsizer = new wxStaticBoxSizer(wxVERTICAL, this, "Symbols");
+	wxStaticBoxSizer *symdirsizer = new wxStaticBoxSizer(wxVERTICAL, this, "Symbol search path");
+	wxStaticBoxSizer *symsrvsizer = new wxStaticBoxSizer(wxVERTICAL, this, "Symbol server");
+
+	symPaths = new wxListBox(this, Options_SymPath, wxDefaultPosition, wxSize(-1, 75), 0, NULL, wxLB_SINGLE | wxLB_NEEDED_SB);
+
+	wxBoxSizer *symPathSizer = new wxBoxSizer(wxHORIZONTAL);
+	wxBoxSizer *symPathButtonSizer = new wxBoxSizer(wxVERTICAL);
+
+	static const struct { wxButton * OptionsDlg::* button; OptionsId id; const wchar_t *icon; const char *tip; } symPathButtons[] = {
+		{ &OptionsDlg::symPathAdd     , Options_SymPath_Add     , L"button_add"   , "Browse for a directory to add" },
+		{ &OptionsDlg::symPathRemove  , Options_SymPath_Remove  , L"button_remove", "Remove selected directory"     },
+		{ &OptionsDlg::symPathMoveUp  , Options_SymPath_MoveUp  , L"button_up"    , "Move selected directory up"    },
+		{ &OptionsDlg::symPathMoveDown, Options_SymPath_MoveDown, L"button_down"  , "Move selected directory down"  },
+	};
+	for (size_t n=0; n<_countof(symPathButtons); n++)
+	{
+		wxButton *b = this->*symPathButtons[n].button = new wxButton(
+			this,
+			symPathButtons[n].id,
+			wxEmptyString,
+			wxDefaultPosition,
+			wxSize(20, 20),
+			wxBU_EXACTFIT);
+		b->SetBitmap(LoadPngResource(symPathButtons[n].icon));
+		b->SetToolTip(symPathButtons[n].tip);
+		symPathButtonSizer->Add(b, 1);
+	}
+	UpdateSymPathButtons();
+
+	symPathSizer->Add(symPaths, 100, wxEXPAND);
+	symPathSizer->Add(symPathButtonSizer, 1, wxSHRINK);
+
+	useSymServer = new wxCheckBox(this, Options_UseSymServer, "Use symbol server");
+	symCacheDir = new wxDirPickerCtrl(this, -1, prefs.symCacheDir, "Select a directory to store local symbols in:",
+		wxDefaultPosition, wxDefaultSize, wxDIRP_USE_TEXTCTRL);
+	symServer = new wxTextCtrl(this, -1, prefs.symServer);
+
+	wxBoxSizer *minGwDbgHelpSizer = new wxBoxSizer(wxHORIZONTAL);
+	minGwDbgHelpSizer->Add(new wxStaticText(this, -1, "MinGW DbgHelp engine:   "));
+
+	mingwWine = new wxRadioButton(this, -1, "Wine  ");
+	mingwWine->SetToolTip("Use Wine's DbgHelp implementation for MinGW symbols (dbghelpw.dll).");
+	minGwDbgHelpSizer->Add(mingwWine);
+
+	mingwDrMingw = new wxRadioButton(this, -1, "Dr. MinGW");
+	mingwDrMingw->SetToolTip("Use Dr. MinGW's DbgHelp implementation for MinGW symbols (dbghelpdr.dll).");
+	minGwDbgHelpSizer->Add(mingwDrMingw);
+
+	(prefs.useWinePref ? mingwWine : mingwDrMingw)->SetValue(true);
+
+	wxBoxSizer *saveMinidumpSizer = new wxBoxSizer(wxHORIZONTAL);
+
+	saveMinidump = new wxCheckBox(this, Options_SaveMinidump, "Save minidump after ");
+	saveMinidump->SetToolTip(
+		"Include a minidump in saved profiling results.\n"
+		"This enables the \"Load symbols from minidump\" option,\n"
+		"which allows profiling an application on a user machine without symbols,\n"
+		"then examining the profile results on a developer machine with symbols.");
+	saveMinidumpSizer->Add(saveMinidump);
+
+	saveMinidumpTimeValue = prefs.saveMinidump < 0 ? 0 : prefs.saveMinidump;
+	saveMinidumpTime = new wxTextCtrl(
+		this, -1,
+		wxEmptyString, wxDefaultPosition,
+		wxSize(40, -1),
+		0,
+		wxIntegerValidator<int>(&saveMinidumpTimeValue));
+	saveMinidumpTime->SetToolTip(
+		"Saving a minidump at the very start of a profiling session\n"
+		"may not work as expected, as not all DLLs may be loaded yet.\n"
+		"You can set a delay after which a minidump will be saved.");
+	saveMinidumpTime->Enable(prefs.saveMinidump >= 0);
+	saveMinidumpSizer->Add(saveMinidumpTime, 0, wxTOP, -3);
+	saveMinidumpSizer->Add(new wxStaticText(this, -1, " seconds"));
+
+	deferSymbols = new wxCheckBox(this, -1, "Look up symbols when the capture is opened");
+	deferSymbols->SetToolTip(
+		"Save where each module was loaded and which build it was,\n"
+		"instead of looking up symbols at the end of the capture.\n"
+		"Captures finish sooner, and can be resolved on a machine\n"
+		"that has the symbols; this is done once, when first opened.");
+	deferSymbols->SetValue(prefs.deferSymbols);
+
+	symPaths->Append(wxSplit(prefs.symSearchPath, ';', 0));
+	useSymServer->SetValue(prefs.useSymServer);
+	symCacheDir->Enable(prefs.useSymServer);
+	symServer->Enable(prefs.useSymServer);
+	saveMinidump->SetValue(prefs.saveMinidump >= 0);
+
+	symdirsizer->Add(symPathSizer, 0, wxALL|wxEXPAND, 5);
+
+	symsrvsizer->Add(useSymServer, 0, wxALL, 5);
+	symsrvsizer->Add(new wxStaticText(this, -1, "Local cache directory:"), 0, wxLEFT|wxTOP, 5);
+	symsrvsizer->Add(symCacheDir, 0, wxALL|wxEXPAND, 5);
+	symsrvsizer->Add(new wxStaticText(this, -1, "Symbol server location:"), 0, wxLEFT|wxTOP, 5);
+	symsrvsizer->Add(symServer, 0, wxALL|wxEXPAND, 5);
+
+	symsizer->Add(symdirsizer, 0, wxALL|wxEXPAND, 5);
+	symsizer->Add(symsrvsizer, 0, wxALL|wxEXPAND, 5);
+	symsizer->Add(minGwDbgHelpSizer, 0, wxALL, 5);
+	symsizer->Add(saveMinidumpSizer, 0, wxALL, 5);
+	symsizer->Add(deferSymbols, 0, wxALL, 5);
+
+	wxStaticBoxSizer *throttlesizer = new wxStaticBoxSizer(wxVERTICAL, this, "Sample rate control");
+	throttlesizer->Add(new wxStaticText(this, -1,
+		"How often each thread is sampled. Lower rates are useful for doing\n"
+		"longer captures where you wish to reduce the profiler overhead.\n"
+		"Higher values increase accuracy; lower values result in better\n"
+		"performance."), 0, wxALL, 5);
+
+	wxBoxSizer *sampleRateSizer = new wxBoxSizer(wxHORIZONTAL);
+
+	sampleRateValue = prefs.sampleRate;
+	wxIntegerValidator<int> sampleRateValidator(&sampleRateValue);
+	sampleRateValidator.SetRange(1, MAX_SAMPLE_RATE);
+	sampleRate = new wxTextCtrl(this, -1, wxEmptyString, wxDefaultPosition, wxSize(50, -1), 0, sampleRateValidator);
+	sampleRate->SetToolTip(
+		"Samples are taken on a fixed schedule, so the rate does not depend\n"
+		"on how many threads there are. If sampling a round of threads takes\n"
+		"longer than the interval, the achieved rate will be lower;\n"
+		"it is reported in the capture's statistics.");
+	sampleRateSizer->Add(new wxStaticText(this, -1, "Sample rate: "));
+	sampleRateSizer->Add(sampleRate, 0, wxTOP, -3);
+	sampleRateSizer->Add(new wxStaticText(this, -1, " Hz     Jitter: "));
+
+	sampleJitterValue = prefs.sampleJitter;
+	wxIntegerValidator<int> sampleJitterValidator(&sampleJitterValue);
+	sampleJitterValidator.SetRange(0, MAX_SAMPLE_JITTER);
+	sampleJitter = new wxTextCtrl(this, -1, wxEmptyString, wxDefaultPosition, wxSize(40, -1), 0, sampleJitterValidator);
+	sampleJitter->SetToolTip(
+		"Move each sample by a random amount, up to this percentage of the interval.\n"
+		"This avoids sampling in step with code that runs periodically,\n"
+		"which would otherwise be over- or under-represented.");
+	sampleRateSizer->Add(sampleJitter, 0, wxTOP, -3);
+	sampleRateSizer->Add(new wxStaticText(this, -1, " %"));
+
+	throttlesizer->Add(sampleRateSizer, 0, wxALL, 5);
+
+	wxBoxSizer *samplerThreadsSizer = new wxBoxSizer(wxHORIZONTAL);
+
+	samplerThreadsValue = prefs.samplerThreads;
+	wxIntegerValidator<int> samplerThreadsValidator(&samplerThreadsValue);
+	samplerThreadsValidator.SetRange(0, MAX_SAMPLER_THREADS);
+	samplerThreads = new wxTextCtrl(this, -1, wxEmptyString, wxDefaultPosition, wxSize(40, -1), 0, samplerThreadsValidator);
+	samplerThreads->SetToolTip(
+		"The target's threads are split between this many sampler threads,\n"
+		"so that targets with many threads can still be sampled at the full rate.\n"
+		"0 uses one sampler thread per 64 target threads, up to one less than\n"
+		"the number of CPU cores.");
+	samplerThreadsSizer->Add(new wxStaticText(this, -1, "Sampler threads: "));
+	samplerThreadsSizer->Add(samplerThreads, 0, wxTOP, -3);
+	samplerThreadsSizer->Add(new wxStaticText(this, -1, " (0 = automatic)"));
+
+	throttlesizer->Add(samplerThreadsSizer, 0, wxALL, 5);
+
+	wxBoxSizer *rescanSizer = new wxBoxSizer(wxHORIZONTAL);
+
+	threadRescanBudgetValue = prefs.threadRescanBudget;
+	wxIntegerValidator<int> threadRescanBudgetValidator(&threadRescanBudgetValue);
+	threadRescanBudgetValidator.SetRange(0, MAX_THREAD_RESCAN_BUDGET);
+	threadRescanBudget = new wxTextCtrl(this, -1, wxEmptyString, wxDefaultPosition, wxSize(40, -1), 0, threadRescanBudgetValidator);
+	threadRescanBudget->SetToolTip(
+		"Periodically look for threads the target has started since profiling began,\n"
+		"and sample them too. Threads that exit are dropped from the capture.\n"
+		"Scans happen as often as possible without taking more than this\n"
+		"percentage of a core, and at most ten times a second. 0 disables this.");
+	rescanSizer->Add(new wxStaticText(this, -1, "Look for new threads using up to "));
+	rescanSizer->Add(threadRescanBudget, 0, wxTOP, -3);
+	rescanSizer->Add(new wxStaticText(this, -1, " % CPU"));
+
+	throttlesizer->Add(rescanSizer, 0, wxALL, 5);
+
+	deferredUnwind = new wxCheckBox(this, -1, "Resume threads before walking their stacks");
+	deferredUnwind->SetToolTip(
+		"Only copy the registers and the top of the stack while a thread is suspended,\n"
+		"and walk the stack afterwards on a separate thread.\n"
+		"This greatly reduces how long each thread is stopped for,\n"
+		"at the cost of some memory and an extra CPU core.");
+	deferredUnwind->SetValue(prefs.deferredUnwind);
+	throttlesizer->Add(deferredUnwind, 0, wxALL, 5);
+
+	sampleLog = new wxCheckBox(this, -1, "Record when and where each sample was taken");
+	sampleLog->SetToolTip(
+		"Save the time and thread of every sample along with its callstack.\n"
+		"This lets the results be narrowed down to part of the capture\n"
+		"or to some of its threads, using the Samples filters.\n"
+		"Takes a few bytes per sample, in memory and in the saved file.");
+	sampleLog->SetValue(prefs.sampleLog);
+	throttlesizer->Add(sampleLog, 0, wxALL, 5);
+
+	topsizer->Add(symsizer, 0, wxEXPAND|wxALL, 0);
+	topsizer->AddSpacer(5);
+	topsizer->Add(throttlesizer, 0, wxEXPAND|wxALL, 0);
+	rootsizer->Add(topsizer, 1, wxEXPAND|wxLEFT|wxTOP|wxRIGHT, 10);
+	rootsizer->Add(CreateButtonSizer(wxOK|wxCANCEL), 0, wxEXPAND|wxALL, 10);
+	SetSizer(rootsizer);
+	rootsizer->SetSizeHints(this);
+	SetAutoLayout(TRUE);
+
+	SetSize(wxSize(400, -1));
+	Centre();
+}
+
+OptionsDlg::~OptionsDlg()
+{
+}
+
+void OptionsDlg::OnOk(wxCommandEvent& WXUNUSED(event))
+{
+	if ( Validate() && TransferDataFromWindow() )
+	{
+		prefs.symSearchPath = wxJoin(symPaths->GetStrings(), ';', 0);
+		prefs.useSymServer = useSymServer->GetValue();
+		prefs.symCacheDir = symCacheDir->GetPath();
+		prefs.symServer = symServer->GetValue();
+		prefs.useWinePref = mingwWine->GetValue();
+		prefs.saveMinidump = saveMinidump->GetValue() ? saveMinidumpTimeValue : -1;
+		prefs.deferSymbols = deferSymbols->GetValue();
+		prefs.sampleRate = sampleRateValue;
+		prefs.sampleJitter = sampleJitterValue;
+		prefs.samplerThreads = samplerThreadsValue;
+		prefs.threadRescanBudget = threadRescanBudgetValue;
+		prefs.deferredUnwind = deferredUnwind->GetValue();
+		prefs.sampleLog = sampleLog->GetValue();
+		EndModal(wxID_OK);
+	}
+}
+
+void OptionsDlg::OnUseSymServer(wxCommandEvent& WXUNUSED(event))
+{
+	bool enabled = useSymServer->GetValue();
+	symCacheDir->Enable(enabled);
+	symServer->Enable(enabled);
+}
+
+void OptionsDlg::UpdateSymPathButtons()
+{
+	int sel = symPaths->GetSelection();
+	symPathRemove  ->Enable(sel >= 0);
+	symPathMoveUp  ->Enable(sel > 0);
+	symPathMoveDown->Enable(sel >= 0 && sel < (int)symPaths->GetCount()-1);
+}
+
+void OptionsDlg::OnSymPath(wxCommandEvent& WXUNUSED(event))
+{
+	UpdateSymPathButtons();
+}
+
+void OptionsDlg::OnSymPathAdd(wxCommandEvent& WXUNUSED(event))
+{
+	wxDirDialog dlg(this, "Select a symbol search path to add");
+	if (dlg.ShowModal()==wxID_OK)
+	{
+		int sel = symPaths->Append(dlg.GetPath());
+		symPaths->Select(sel);
+		UpdateSymPathButtons();
+	}
+}
+
+void OptionsDlg::OnSymPathRemove(wxCommandEvent& WXUNUSED(event))
+{
+	int sel = symPaths->GetSelection();
+	symPaths->Delete(sel);
+	if (sel < (int)symPaths->GetCount())
+		symPaths->Select(sel);
+	UpdateSymPathButtons();
+}
+
+void OptionsDlg::OnSymPathMoveUp(wxCommandEvent& WXUNUSED(event))
+{
+	int sel = symPaths->GetSelection();
+	wxString s = symPaths->GetString(sel);
+	symPaths->Delete(sel);
+	symPaths->Insert(s, sel-1);
+	symPaths->Select(sel-1);
+	UpdateSymPathButtons();
+}
+
+void OptionsDlg::OnSymPathMoveDown(wxCommandEvent& WXUNUSED(event))
+{
+	int sel = symPaths->GetSelection();
+	wxString s = symPaths->GetString(sel);
+	symPaths->Delete(sel);
+	symPaths->Insert(s, sel+1);
+	symPaths->Select(sel+1);
+	UpdateSymPathButtons();
+}
+
+void OptionsDlg::OnSaveMinidump(wxCommandEvent& WXUNUSED(event))
+{
+	saveMinidumpTime->Enable(saveMinidump->IsChecked());
+}
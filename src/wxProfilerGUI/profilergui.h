@@ -1,166 +1,184 @@
-﻿/*=====================================================================
-profilergui.h
--------------
-File created by ClassTemplate on Sun Mar 13 18:16:34 2005
-
-Copyright (C) Nicholas Chapman
-
-This program is free software; you can redistribute it and/or
-modify it under the terms of the GNU General Public License
-as published by the Free Software Foundation; either version 2
-of the License, or (at your option) any later version.
-
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with this program; if not, write to the Free Software
-Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
-
-http://www.gnu.org/copyleft/gpl.html.
-=====================================================================*/
-#ifndef __PROFILERGUI_H_666_
-#define __PROFILERGUI_H_666_
-
-#include <wx/config.h>
-#include <wx/app.h>
-#include <wx/listctrl.h>
-#include <wx/splitter.h>
-#include <wx/notebook.h>
-#include <wx/aui/aui.h>
-#include <wx/progdlg.h>
-#include <wx/wfstream.h>
-#include <wx/zipstrm.h>
-#include <wx/txtstrm.h>
-#include <wx/cmdline.h>
-#include <wx/evtloop.h>
-#include <wx/tipwin.h>
-#include <string>
-#include <vector>
-#include <map>
-
-extern wxIcon sleepy_icon;
-
-class SymbolInfo;
-
-enum AttachMode
-{
-	ATTACH_ALL_THREAD,	// default
-	ATTACH_MAIN_THREAD,
-	ATTACH_MOST_BUSY_THREAD,
-};
-
-struct AttachInfo
-{
-	AttachInfo();
-	~AttachInfo();
-
-	HANDLE process_handle;
-	std::vector<HANDLE> thread_handles;
-	SymbolInfo *sym_info;
-	int limit_profile_time;
-};
-
-wxBitmap LoadPngResource(const wchar_t *szName);
-
-class Prefs
-{
-public:
-	Prefs()
-	{
-		useSymServer = false;
-		saveMinidump = -1;
-		throttle = 100;
-		useWinePref = useWineSwitch = useMingwSwitch = false;
-		attachMode = ATTACH_ALL_THREAD;
-	}
-
-	wxString symSearchPath;
-	bool useSymServer;
-	wxString symCacheDir;
-	wxString symServer;
-	int saveMinidump; // Save minidump after X seconds. -1 = disabled
-	int throttle;
-
-	bool useWinePref, useWineSwitch, useMingwSwitch;
-	AttachMode attachMode;
-
-	bool UseWine()
-	{
-		return
-			useMingwSwitch ? false :
-			useWineSwitch ? true :
-			useWinePref;
-	}
-
-	// Add any configured search paths, and the symbol server if enabled.
-	void AdjustSymbolPath(std::wstring &sympath, bool download)
-	{
-		if (!symSearchPath.empty())
-		{
-			if (!sympath.empty())
-				sympath += L";";
-			sympath += symSearchPath;
-		}
-
-		if (useSymServer)
-		{
-			if (!sympath.empty())
-				sympath += L";";
-			sympath += L"SRV*";
-			sympath += symCacheDir;
-			if ( download )
-				sympath += std::wstring(L"*") + symServer;
-		}
-	}
-};
-
-/*=====================================================================
-ProfilerGUI
------------
-the main app
-=====================================================================*/
-class ProfilerGUI : public wxApp
-{
-public:
-	ProfilerGUI();
-	virtual ~ProfilerGUI();
-	virtual bool OnInit();
-	virtual bool ProcessIdle();
-	virtual int OnExit();
-
-	static void ShowAboutBox();
-	static wxString PromptOpen(wxWindow *parent);
-
-	virtual wxAppTraits *CreateTraits();
-
-protected:
-	virtual void OnInitCmdLine(wxCmdLineParser& parser);
-	virtual bool OnCmdLineParsed(wxCmdLineParser& parser);
-
-private:
-	void HandleInit();
-	bool Run();
-
-	void CreateProgressWindow();
-	void DestroyProgressWindow();
-
-	std::wstring LaunchProfiler(const AttachInfo *info);
-	AttachInfo *RunProcess(const std::wstring &run_cmd, const std::wstring &run_cwd);
-	AttachInfo *AttachToProcess(const std::wstring& processId);
-	static void TryLoadSymbols(AttachInfo* output);
-	void LoadProfileData(const std::wstring &filename);
-	std::wstring ObtainProfileData();
-
-	class CaptureWin *captureWin;
-	bool initialized;
-};
-
-DECLARE_APP(ProfilerGUI)
-
-extern Prefs prefs;
-extern wxConfig config;
-
-#endif //__PROFILERGUI_H_666_
+﻿/*=====================================================================
+profilergui.h
+-------------
+File created by ClassTemplate on Sun Mar 13 18:16:34 2005
+
+Copyright (C) Nicholas Chapman
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+http://www.gnu.org/copyleft/gpl.html.
+=====================================================================*/
+#ifndef __PROFILERGUI_H_666_
+#define __PROFILERGUI_H_666_
+
+#include <wx/config.h>
+#include <wx/app.h>
+#include <wx/listctrl.h>
+#include <wx/splitter.h>
+#include <wx/notebook.h>
+#include <wx/aui/aui.h>
+#include <wx/progdlg.h>
+#include <wx/wfstream.h>
+#include <wx/zipstrm.h>
+#include <wx/txtstrm.h>
+#include <wx/cmdline.h>
+#include <wx/evtloop.h>
+#include <wx/tipwin.h>
+#include <string>
+#include <vector>
+#include <map>
+
+extern wxIcon sleepy_icon;
+
+class SymbolInfo;
+
+enum AttachMode
+{
+	ATTACH_ALL_THREAD,	// default
+	ATTACH_MAIN_THREAD,
+	ATTACH_MOST_BUSY_THREAD,
+};
+
+// Limits for Prefs::sampleRate (Hz) and Prefs::sampleJitter (percent).
+#define MAX_SAMPLE_RATE 10000
+#define MAX_SAMPLE_JITTER 90
+#define MAX_SAMPLER_THREADS 64
+#define MAX_THREAD_RESCAN_BUDGET 100
+
+struct AttachInfo
+{
+	AttachInfo();
+	~AttachInfo();
+
+	HANDLE process_handle;
+	std::vector<HANDLE> thread_handles;
+	SymbolInfo *sym_info;
+	int limit_profile_time;
+};
+
+wxBitmap LoadPngResource(const wchar_t *szName);
+
+class Prefs
+{
+public:
+	Prefs()
+	{
+		useSymServer = false;
+		saveMinidump = -1;
+		deferSymbols = false;
+		sampleRate = 1000;
+		sampleJitter = 0;
+		samplerThreads = 0;
+		threadRescanBudget = 1;
+		deferredUnwind = false;
+		sampleLog = false;
+		useWinePref = useWineSwitch = useMingwSwitch = false;
+		attachMode = ATTACH_ALL_THREAD;
+	}
+
+	wxString symSearchPath;
+	bool useSymServer;
+	wxString symCacheDir;
+	wxString symServer;
+	int saveMinidump; // Save minidump after X seconds. -1 = disabled
+	bool deferSymbols; // Save module records, and look symbols up when the capture is opened
+	int sampleRate; // Target samples per second, per thread
+	int sampleJitter; // Randomize sample times by up to this percentage of the interval
+	int samplerThreads; // Number of threads sampling the target. 0 = automatic
+	int threadRescanBudget; // Percentage of a core to spend looking for new threads. 0 = disabled
+	bool deferredUnwind; // Copy the stack and resume the thread before walking it
+	bool sampleLog; // Save the time, thread and callstack of every sample
+
+	bool useWinePref, useWineSwitch, useMingwSwitch;
+	AttachMode attachMode;
+
+	bool UseWine()
+	{
+		return
+			useMingwSwitch ? false :
+			useWineSwitch ? true :
+			useWinePref;
+	}
+
+	// Add any configured search paths, and the symbol server if enabled.
+	void AdjustSymbolPath(std::wstring &sympath, bool download)
+	{
+		if (!symSearchPath.empty())
+		{
+			if (!sympath.empty())
+				sympath += L";";
+			sympath += symSearchPath;
+		}
+
+		if (useSymServer)
+		{
+			if (!sympath.empty())
+				sympath += L";";
+			sympath += L"SRV*";
+			sympath += symCacheDir;
+			if ( download )
+				sympath += std::wstring(L"*") + symServer;
+		}
+	}
+};
+
+/*=====================================================================
+ProfilerGUI
+-----------
+the main app
+=====================================================================*/
+class ProfilerGUI : public wxApp
+{
+public:
+	ProfilerGUI();
+	virtual ~ProfilerGUI();
+	virtual bool OnInit();
+	virtual bool ProcessIdle();
+	virtual int OnExit();
+
+	static void ShowAboutBox();
+	static wxString PromptOpen(wxWindow *parent);
+
+	virtual wxAppTraits *CreateTraits();
+
+protected:
+	virtual void OnInitCmdLine(wxCmdLineParser& parser);
+	virtual bool OnCmdLineParsed(wxCmdLineParser& parser);
+
+private:
+	void HandleInit();
+	bool Run();
+
+	void CreateProgressWindow();
+	void DestroyProgressWindow();
+
+	std::wstring LaunchProfiler(const AttachInfo *info);
+	AttachInfo *RunProcess(const std::wstring &run_cmd, const std::wstring &run_cwd);
+	AttachInfo *AttachToProcess(const std::wstring& processId);
+	static void TryLoadSymbols(AttachInfo* output);
+	void LoadProfileData(const std::wstring &filename);
+	std::wstring ObtainProfileData();
+
+	class CaptureWin *captureWin;
+	bool initialized;
+};
+
+DECLARE_APP(ProfilerGUI)
+
+extern Prefs prefs;
+extern wxConfig config;
+
+#endif //__PROFILERGUI_H_666_